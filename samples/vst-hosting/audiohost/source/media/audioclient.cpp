@@ -52,46 +52,6 @@
 namespace Steinberg {
 namespace Vst {
 
-//------------------------------------------------------------------------
-// From Vst2Wrapper
-static MidiCCMapping initMidiCtrlerAssignment (IComponent* component, IMidiMapping* midiMapping)
-{
-	MidiCCMapping midiCCMapping {};
-
-	if (!midiMapping || !component)
-		return midiCCMapping;
-
-	int32 busses = std::min<int32> (component->getBusCount (kEvent, kInput), kMaxMidiMappingBusses);
-
-	if (midiCCMapping[0][0].empty ())
-	{
-		for (int32 b = 0; b < busses; b++)
-			for (int32 i = 0; i < kMaxMidiChannels; i++)
-				midiCCMapping[b][i].resize (Vst::kCountCtrlNumber);
-	}
-
-	ParamID paramID;
-	for (int32 b = 0; b < busses; b++)
-	{
-		for (int16 ch = 0; ch < kMaxMidiChannels; ch++)
-		{
-			for (int32 i = 0; i < Vst::kCountCtrlNumber; i++)
-			{
-				paramID = kNoParamId;
-				if (midiMapping->getMidiControllerAssignment (b, ch, (CtrlNumber)i, paramID) ==
-				    kResultTrue)
-				{
-					// TODO check if tag is associated to a parameter
-					midiCCMapping[b][ch][i] = paramID;
-				}
-				else
-					midiCCMapping[b][ch][i] = kNoParamId;
-			}
-		}
-	}
-	return midiCCMapping;
-}
-
 //------------------------------------------------------------------------
 static void assignBusBuffers (const IAudioClient::Buffers& buffers, HostProcessData& processData,
                               bool unassign = false)
@@ -186,7 +146,7 @@ bool AudioClient::initialize (const Name& name, IComponent* _component, IMidiMap
 	paramTransferrer.setMaxParameters (1000);
 
 	if (midiMapping)
-		midiCCMapping = initMidiCtrlerAssignment (component, midiMapping);
+		midiConverter.updateMapping (midiMapping, component->getBusCount (kEvent, kInput));
 
 	createLocalMediaServer (name);
 	return true;
@@ -313,6 +273,7 @@ void AudioClient::postprocess (Buffers& buffers)
 {
 	eventList.clear ();
 	inputParameterChanges.clearQueue ();
+	midiConverter.endBlock ();
 	unassignBusBuffers (buffers, processData);
 }
 
@@ -378,74 +339,16 @@ return false;*/
 }
 
 //------------------------------------------------------------------------
-bool AudioClient::isPortInRange (int32 port, int32 channel) const
-{
-	return port < kMaxMidiMappingBusses && !midiCCMapping[port][channel].empty ();
-}
-
-//------------------------------------------------------------------------
-bool AudioClient::processVstEvent (const IMidiClient::Event& event, int32 port)
-{
-	auto vstEvent = midiToEvent (event.type, event.channel, event.data0, event.data1);
-	if (vstEvent)
-	{
-		vstEvent->busIndex = port;
-		if (eventList.addEvent (*vstEvent) != kResultOk)
-		{
-			assert (false && "Event was not added to EventList!");
-		}
-
-		return true;
-	}
-
-	return false;
-}
-
-//------------------------------------------------------------------------
-bool AudioClient::processParamChange (const IMidiClient::Event& event, int32 port)
+bool AudioClient::onEvent (const IMidiClient::Event& event, int32_t port)
 {
-	auto paramMapping = [port, this] (int32 channel, MidiData data1) -> ParamID {
-		if (!isPortInRange (port, channel))
-			return kNoParamId;
-
-		return midiCCMapping[port][channel][data1];
-	};
-
-	auto paramChange =
-	    midiToParameter (event.type, event.channel, event.data0, event.data1, paramMapping);
-	if (paramChange)
-	{
-		int32 index = 0;
-		IParamValueQueue* queue =
-		    inputParameterChanges.addParameterData ((*paramChange).first, index);
-		if (queue)
-		{
-			if (queue->addPoint (static_cast<int32> (event.timestamp), (*paramChange).second,
-			                     index) != kResultOk)
-			{
-				assert (false && "Parameter point was not added to ParamValueQueue!");
-			}
-		}
-
-		return true;
-	}
-
-	return false;
+	midiConverter.convert (&event, 1, port, eventList, inputParameterChanges);
+	return true;
 }
 
 //------------------------------------------------------------------------
-bool AudioClient::onEvent (const IMidiClient::Event& event, int32_t port)
+bool AudioClient::onEvents (const IMidiClient::Event* events, size_t numEvents, int32_t port)
 {
-	// Try to create Event first.
-	if (processVstEvent (event, port))
-		return true;
-
-	// In case this is no event it must be a parameter.
-	if (processParamChange (event, port))
-		return true;
-
-	// TODO: Something else???
-
+	midiConverter.convert (events, numEvents, port, eventList, inputParameterChanges);
 	return true;
 }
 
@@ -39,6 +39,7 @@
 
 #include "public.sdk/samples/vst-hosting/audiohost/source/media/imediaserver.h"
 #include "public.sdk/samples/vst-hosting/audiohost/source/media/iparameterclient.h"
+#include "public.sdk/samples/vst-hosting/audiohost/source/media/miditovst.h"
 #include "public.sdk/source/vst/hosting/eventlist.h"
 #include "public.sdk/source/vst/hosting/parameterchanges.h"
 #include "public.sdk/source/vst/hosting/processdata.h"
@@ -55,13 +56,9 @@ class IComponent;
 
 enum
 {
-	kMaxMidiMappingBusses = 4,
-	kMaxMidiChannels = 16
+	kMaxMidiMappingBusses = MidiToVstConverter::kMaxBusses,
+	kMaxMidiChannels = MidiToVstConverter::kMaxChannels
 };
-using Controllers = std::vector<int32>;
-using Channels = std::array<Controllers, kMaxMidiChannels>;
-using Busses = std::array<Channels, kMaxMidiMappingBusses>;
-using MidiCCMapping = Busses;
 
 //------------------------------------------------------------------------
 using AudioClientPtr = std::shared_ptr<class AudioClient>;
@@ -86,6 +83,7 @@ public:
 
 	// IMidiClient
 	bool onEvent (const Event& event, int32_t port) override;
+	bool onEvents (const Event* events, size_t numEvents, int32_t port) override;
 	IMidiClient::IOSetup getMidiIOSetup () const override;
 
 	// IParameterClient
@@ -103,9 +101,6 @@ private:
 	bool updateProcessSetup ();
 	void preprocess (Buffers& buffers, int64_t continousFrames);
 	void postprocess (Buffers& buffers);
-	bool isPortInRange (int32 port, int32 channel) const;
-	bool processVstEvent (const IMidiClient::Event& event, int32 port);
-	bool processParamChange (const IMidiClient::Event& event, int32 port);
 
 	SampleRate sampleRate = 0;
 	int32 blockSize = 0;
@@ -116,7 +111,7 @@ private:
 	IComponent* component = nullptr;
 	ParameterChangeTransfer paramTransferrer;
 
-	MidiCCMapping midiCCMapping;
+	MidiToVstConverter midiConverter;
 	IMediaServerPtr mediaServer;
 	bool isProcessing = false;
 
@@ -95,6 +95,13 @@ struct IMidiClient
 	};
 
 	virtual bool onEvent (const Event& event, int32_t port) = 0;
+	/** all events of a port in one block */
+	virtual bool onEvents (const Event* events, size_t numEvents, int32_t port)
+	{
+		for (size_t i = 0; i < numEvents; ++i)
+			onEvent (events[i], port);
+		return true;
+	}
 	virtual IOSetup getMidiIOSetup () const = 0;
 
 	virtual ~IMidiClient () {}
@@ -37,6 +37,7 @@
 
 #include "public.sdk/samples/vst-hosting/audiohost/source/media/imediaserver.h"
 
+#include <array>
 #include <cassert>
 
 //! Workaround for Jack on Windows
@@ -100,6 +101,7 @@ private:
 	BufferPointers audioOutputPointers;
 	BufferPointers audioInputPointers;
 	IAudioClient::Buffers buffers {nullptr};
+	std::array<IMidiClient::Event, 512> midiEvents;
 };
 
 //------------------------------------------------------------------------
@@ -321,6 +323,8 @@ int JackClient::processMidi (jack_nframes_t nframes)
 		if (!portBuffer)
 			continue;
 
+		// hand the events of the port over in chunks instead of one call per event
+		size_t numEvents = 0;
 		jack_midi_event_t in_event;
 		auto event_count = jack_midi_get_event_count (portBuffer);
 		for (uint32_t i = 0; i < event_count; i++)
@@ -330,12 +334,20 @@ int JackClient::processMidi (jack_nframes_t nframes)
 				continue;
 
 			auto midiData = in_event.buffer;
-			Steinberg::Vst::IMidiClient::MidiData channel = midiData[0] & kChannelMask;
-			Steinberg::Vst::IMidiClient::MidiData status = midiData[0] & kStatusMask;
-			Steinberg::Vst::IMidiClient::MidiData data0 = midiData[1];
-			Steinberg::Vst::IMidiClient::MidiData data1 = midiData[2];
-			midiClient->onEvent ({status, channel, data0, data1, in_event.time}, portIndex);
+			auto& event = midiEvents[numEvents++];
+			event.channel = midiData[0] & kChannelMask;
+			event.type = midiData[0] & kStatusMask;
+			event.data0 = in_event.size > 1 ? midiData[1] : 0;
+			event.data1 = in_event.size > 2 ? midiData[2] : 0;
+			event.timestamp = in_event.time;
+			if (numEvents == midiEvents.size ())
+			{
+				midiClient->onEvents (midiEvents.data (), numEvents, portIndex);
+				numEvents = 0;
+			}
 		}
+		if (numEvents > 0)
+			midiClient->onEvents (midiEvents.data (), numEvents, portIndex);
 	}
 
 	return kJackSuccess;
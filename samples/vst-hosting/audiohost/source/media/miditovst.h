@@ -38,10 +38,15 @@
 #pragma once
 
 #include "public.sdk/source/vst/utility/optional.h"
+#include "pluginterfaces/vst/ivsteditcontroller.h"
 #include "pluginterfaces/vst/ivstevents.h"
 #include "pluginterfaces/vst/ivstmidicontrollers.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <limits>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -60,7 +65,7 @@ const float kMidiScaler = 1.f / 127.f;
 
 using MidiData = uint8_t;
 
-float toNormalized (const MidiData& data)
+inline float toNormalized (const MidiData& data)
 {
 	return (float)data * kMidiScaler;
 }
@@ -70,8 +75,8 @@ using OptionalEvent = VST3::Optional<Event>;
 using ParameterChange = std::pair<ParamID, ParamValue>;
 using OptionParamChange = VST3::Optional<ParameterChange>;
 
-OptionalEvent midiToEvent (MidiData status, MidiData channel, MidiData midiData0,
-                           MidiData midiData1)
+inline OptionalEvent midiToEvent (MidiData status, MidiData channel, MidiData midiData0,
+                                  MidiData midiData1)
 {
 	Event new_event = {};
 	if (status == kNoteOn || status == kNoteOff)
@@ -110,8 +115,9 @@ OptionalEvent midiToEvent (MidiData status, MidiData channel, MidiData midiData0
 
 //------------------------------------------------------------------------
 using ToParameterIdFunc = std::function<ParamID (int32, MidiData)>;
-OptionParamChange midiToParameter (MidiData status, MidiData channel, MidiData midiData1,
-                                   MidiData midiData2, const ToParameterIdFunc& toParamID)
+inline OptionParamChange midiToParameter (MidiData status, MidiData channel, MidiData midiData1,
+                                          MidiData midiData2,
+                                          const ToParameterIdFunc& toParamID)
 {
 	if (!toParamID)
 		return {};
@@ -154,6 +160,177 @@ OptionParamChange midiToParameter (MidiData status, MidiData channel, MidiData m
 
 	return {};
 }
+
+//------------------------------------------------------------------------
+/** Converts MIDI messages to events and parameter changes in one pass.
+ *
+ *	The controller assignments of the plug-in are read once into a flat table indexed by
+ *	[bus][channel][controller]. Converting does not allocate, the parameter queues used in the
+ *	current block are cached so that dense controller input does not search the parameter changes
+ *	for every message.
+ */
+class MidiToVstConverter
+{
+public:
+	static constexpr int32 kMaxBusses = 4;
+	static constexpr int32 kMaxChannels = 16;
+	static constexpr int32 kNumControllers = kCountCtrlNumber;
+
+	MidiToVstConverter () { paramIDs.fill (kNoParamId); }
+
+	/** reads the MIDI controller assignments (not realtime safe) */
+	void updateMapping (IMidiMapping* midiMapping, int32 numBusses)
+	{
+		paramIDs.fill (kNoParamId);
+		if (!midiMapping)
+			return;
+		numBusses = std::min (numBusses, kMaxBusses);
+		for (int32 bus = 0; bus < numBusses; ++bus)
+		{
+			for (int16 channel = 0; channel < kMaxChannels; ++channel)
+			{
+				for (int32 ctrl = 0; ctrl < kNumControllers; ++ctrl)
+				{
+					ParamID id = kNoParamId;
+					if (midiMapping->getMidiControllerAssignment (
+					        bus, channel, static_cast<CtrlNumber> (ctrl), id) == kResultTrue)
+						paramIDs[slot (bus, channel, ctrl)] = id;
+				}
+			}
+		}
+	}
+
+	/** the assigned parameter or kNoParamId */
+	ParamID getParamID (int32 bus, int32 channel, int32 ctrl) const
+	{
+		if (bus < 0 || bus >= kMaxBusses || channel < 0 || channel >= kMaxChannels || ctrl < 0 ||
+		    ctrl >= kNumControllers)
+			return kNoParamId;
+		return paramIDs[slot (bus, channel, ctrl)];
+	}
+
+	/** must be called when the parameter changes were cleared */
+	void endBlock ()
+	{
+		for (uint32 i = 0; i < numUsedQueues; ++i)
+			queues[usedQueues[i]] = nullptr;
+		numUsedQueues = 0;
+	}
+
+	/** converts the MIDI messages of one bus
+	 *
+	 *	MidiEvent needs the members type (status without channel), channel, data0, data1 and
+	 *	timestamp (sample offset).
+	 */
+	template <typename MidiEvent>
+	void convert (const MidiEvent* midiEvents, size_t numEvents, int32 busIndex,
+	              IEventList& eventList, IParameterChanges& changes)
+	{
+		for (size_t i = 0; i < numEvents; ++i)
+		{
+			const auto& midi = midiEvents[i];
+			auto sampleOffset = static_cast<int32> (midi.timestamp);
+			switch (midi.type)
+			{
+				case kNoteOn:
+				{
+					auto e = makeEvent (Event::kNoteOnEvent, busIndex, sampleOffset);
+					e.noteOn.noteId = -1;
+					e.noteOn.channel = midi.channel;
+					e.noteOn.pitch = midi.data0;
+					e.noteOn.velocity = toNormalized (midi.data1);
+					eventList.addEvent (e);
+					break;
+				}
+				case kNoteOff:
+				{
+					auto e = makeEvent (Event::kNoteOffEvent, busIndex, sampleOffset);
+					e.noteOff.noteId = -1;
+					e.noteOff.channel = midi.channel;
+					e.noteOff.pitch = midi.data0;
+					e.noteOff.velocity = toNormalized (midi.data1);
+					eventList.addEvent (e);
+					break;
+				}
+				case kPolyPressure:
+				{
+					auto e = makeEvent (Event::kPolyPressureEvent, busIndex, sampleOffset);
+					e.polyPressure.channel = midi.channel;
+					e.polyPressure.pitch = midi.data0;
+					e.polyPressure.pressure = toNormalized (midi.data1);
+					eventList.addEvent (e);
+					break;
+				}
+				case kController:
+				{
+					addChange (changes, busIndex, midi.channel, midi.data0 & kDataMask,
+					           sampleOffset, (midi.data1 & kDataMask) * kMidiScaler);
+					break;
+				}
+				case kAfterTouchStatus:
+				{
+					addChange (changes, busIndex, midi.channel, Vst::kAfterTouch, sampleOffset,
+					           (midi.data0 & kDataMask) * kMidiScaler);
+					break;
+				}
+				case kPitchBendStatus:
+				{
+					const int32 value = (midi.data0 & kDataMask) | (midi.data1 & kDataMask) << 7;
+					addChange (changes, busIndex, midi.channel, Vst::kPitchBend, sampleOffset,
+					           value / static_cast<double> (0x3FFF));
+					break;
+				}
+			}
+		}
+	}
+
+//------------------------------------------------------------------------
+private:
+	static constexpr size_t kNumSlots = kMaxBusses * kMaxChannels * kNumControllers;
+
+	static constexpr int32 slot (int32 bus, int32 channel, int32 ctrl)
+	{
+		return (bus * kMaxChannels + channel) * kNumControllers + ctrl;
+	}
+
+	static Event makeEvent (uint16 type, int32 busIndex, int32 sampleOffset)
+	{
+		Event e = {};
+		e.type = type;
+		e.busIndex = busIndex;
+		e.sampleOffset = sampleOffset;
+		return e;
+	}
+
+	void addChange (IParameterChanges& changes, int32 bus, int32 channel, int32 ctrl,
+	                int32 sampleOffset, ParamValue value)
+	{
+		if (bus < 0 || bus >= kMaxBusses || channel >= kMaxChannels)
+			return;
+		auto index = slot (bus, channel, ctrl);
+		auto id = paramIDs[index];
+		if (id == kNoParamId)
+			return;
+		auto queue = queues[index];
+		if (!queue)
+		{
+			int32 queueIndex = 0;
+			queue = changes.addParameterData (id, queueIndex);
+			if (!queue)
+				return;
+			queues[index] = queue;
+			usedQueues[numUsedQueues++] = static_cast<uint16> (index);
+		}
+		int32 pointIndex = 0;
+		queue->addPoint (sampleOffset, value, pointIndex);
+	}
+
+	std::array<ParamID, kNumSlots> paramIDs;
+	std::array<IParamValueQueue*, kNumSlots> queues {};
+	std::array<uint16, kNumSlots> usedQueues {};
+	uint32 numUsedQueues {0};
+};
+
 //------------------------------------------------------------------------
 } // Vst
 } // Steinberg
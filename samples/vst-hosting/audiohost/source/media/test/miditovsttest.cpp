@@ -0,0 +1,179 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : AudioHost
+// Filename    : public.sdk/samples/vst-hosting/audiohost/source/media/test/miditovsttest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test MIDI to VST 3 conversion of the Audio Host Example
+// Flags       : clang-format SMTGSequencer
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/samples/vst-hosting/audiohost/source/media/miditovst.h"
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/eventlist.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include "public.sdk/source/vst/testsuite/testbase.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/funknownimpl.h"
+
+#include <chrono>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+struct MidiEvent
+{
+	MidiData type;
+	MidiData channel;
+	MidiData data0;
+	MidiData data1;
+	int64_t timestamp;
+};
+
+//------------------------------------------------------------------------
+struct MidiMapping : U::ImplementsNonDestroyable<U::Directly<IMidiMapping>>
+{
+	tresult PLUGIN_API getMidiControllerAssignment (int32 busIndex, int16 channel,
+	                                                CtrlNumber midiControllerNumber,
+	                                                ParamID& id) override
+	{
+		if (midiControllerNumber >= 32 && midiControllerNumber < kAfterTouch)
+			return kResultFalse;
+		// a parameter per bus, channel and controller
+		id = static_cast<ParamID> ((busIndex * 16 + channel) * 1000 + midiControllerNumber);
+		return kResultTrue;
+	}
+};
+
+//------------------------------------------------------------------------
+ModuleInitializer MidiToVstTests ([] () {
+	constexpr auto TestSuiteName = "MidiToVst";
+	registerTest (TestSuiteName, STR ("Convert events and controllers"),
+	              [] (ITestResult* testResult) {
+		              MidiMapping mapping;
+		              MidiToVstConverter converter;
+		              converter.updateMapping (&mapping, 1);
+		              EXPECT_EQ (converter.getParamID (0, 2, kCtrlModWheel), 2001u);
+		              EXPECT_EQ (converter.getParamID (0, 2, 64), kNoParamId);
+		              EXPECT_EQ (converter.getParamID (1, 0, kCtrlModWheel), kNoParamId);
+
+		              const MidiEvent midi[] = {
+		                  {kNoteOn, 2, 60, 127, 3},         {kController, 2, kCtrlModWheel, 0, 4},
+		                  {kController, 2, 64, 127, 5},     {kController, 2, kCtrlModWheel, 127, 6},
+		                  {kPitchBendStatus, 0, 0, 0x40, 7}, {kNoteOff, 2, 60, 0, 8},
+		                  {kAfterTouchStatus, 1, 127, 0, 9}};
+		              EventList events;
+		              ParameterChanges changes (8);
+		              converter.convert (midi, 7, 0, events, changes);
+
+		              EXPECT_EQ (events.getEventCount (), 2);
+		              Event e;
+		              EXPECT_EQ (events.getEvent (0, e), kResultTrue);
+		              EXPECT_EQ (e.type, Event::kNoteOnEvent);
+		              EXPECT_EQ (e.sampleOffset, 3);
+		              EXPECT_EQ (e.noteOn.pitch, 60);
+		              EXPECT_EQ (e.noteOn.velocity, 1.f);
+		              EXPECT_EQ (events.getEvent (1, e), kResultTrue);
+		              EXPECT_EQ (e.type, Event::kNoteOffEvent);
+
+		              EXPECT_EQ (changes.getParameterCount (), 3);
+		              auto queue = changes.getParameterData (0);
+		              EXPECT_EQ (queue->getParameterId (), 2001u);
+		              EXPECT_EQ (queue->getPointCount (), 2);
+		              int32 offset;
+		              ParamValue value;
+		              EXPECT_EQ (queue->getPoint (1, offset, value), kResultTrue);
+		              EXPECT_EQ (offset, 6);
+		              EXPECT_EQ (value, 1.);
+		              queue = changes.getParameterData (1);
+		              EXPECT_EQ (queue->getParameterId (), static_cast<ParamID> (kPitchBend));
+		              EXPECT_EQ (queue->getPoint (0, offset, value), kResultTrue);
+		              EXPECT (Test::maxDiff (value, 0.5, 0.001));
+		              queue = changes.getParameterData (2);
+		              EXPECT_EQ (queue->getParameterId (), static_cast<ParamID> (1000 + kAfterTouch));
+
+		              // after the block the cached queues are invalid
+		              changes.clearQueue ();
+		              converter.endBlock ();
+		              converter.convert (midi + 1, 1, 0, events, changes);
+		              EXPECT_EQ (changes.getParameterCount (), 1);
+		              return true;
+	              });
+});
+
+//------------------------------------------------------------------------
+// only run by the validator selftest with extensive tests
+ModuleInitializer MidiToVstBenchmarks ([] () {
+	constexpr auto TestSuiteName = "MidiToVstBenchmark";
+	registerTest (TestSuiteName, STR ("Throughput"), [] (ITestResult* testResult) {
+		constexpr auto numEvents = 10000u;
+		constexpr auto numBlocks = 100u;
+		std::vector<MidiEvent> midi;
+		midi.reserve (numEvents);
+		for (auto i = 0u; i < numEvents; ++i)
+		{
+			auto channel = static_cast<MidiData> (i % 16);
+			auto offset = static_cast<int64_t> (i / 20);
+			if (i % 4 == 0)
+				midi.push_back ({kNoteOn, channel, static_cast<MidiData> (i % 128), 100, offset});
+			else
+				midi.push_back ({kController, channel, static_cast<MidiData> (i % 32),
+				                 static_cast<MidiData> (i % 128), offset});
+		}
+		MidiMapping mapping;
+		MidiToVstConverter converter;
+		converter.updateMapping (&mapping, 1);
+		EventList events (numEvents);
+		ParameterChanges changes (512);
+
+		auto start = std::chrono::steady_clock::now ();
+		for (auto block = 0u; block < numBlocks; ++block)
+		{
+			converter.convert (midi.data (), midi.size (), 0, events, changes);
+			EXPECT_EQ (events.getEventCount (), static_cast<int32> (numEvents / 4));
+			events.clear ();
+			changes.clearQueue ();
+			converter.endBlock ();
+		}
+		auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () - start);
+		addMessage (testResult, printf ("   %.1f us per block of %u events",
+		                                duration.count () * 1000000. / numBlocks, numEvents));
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -249,6 +249,16 @@ constexpr auto optListPlugInSnapshots = "snapshots";
 constexpr auto optCID = "cid";
 constexpr auto optSelftest = "selftest";
 
+//------------------------------------------------------------------------
+/** the selftest only runs the tests of suites ending in "Benchmark" with extensive tests */
+bool isBenchmark (const std::string& testSuiteName)
+{
+	static const std::string suffix = "Benchmark";
+	return testSuiteName.size () >= suffix.size () &&
+	       testSuiteName.compare (testSuiteName.size () - suffix.size (), suffix.size (),
+	                              suffix) == 0;
+}
+
 //------------------------------------------------------------------------
 } // anonymous
 
@@ -390,6 +400,7 @@ int Validator::run ()
 	else if (valueMap.count (optSelftest))
 	{
 		addErrorWarningTextToOutput = false;
+		runBenchmarks = valueMap.count (optExtensiveTests) != 0;
 		auto testFactoryInstance = owned (createTestFactoryInstance (nullptr));
 		if (auto testFactory = U::cast<ITestFactory> (testFactoryInstance))
 		{
@@ -773,6 +784,8 @@ void Validator::runTestSuite (TestSuite* suite, FIDString nameFilter)
 		{
 			if (suite->getTest (i, testItem, name) == kResultTrue)
 			{
+				if (!runBenchmarks && isBenchmark (name))
+					continue;
 				if (infoStream)
 				{
 					*infoStream << "[" << name;
@@ -121,6 +121,7 @@ protected:
 	int32 numTestsFailed {0};
 	int32 numTestsPassed {0};
 	bool addErrorWarningTextToOutput {true};
+	bool runBenchmarks {false};
 
 	std::ostream* infoStream {nullptr};
 	std::ostream* errorStream {nullptr};
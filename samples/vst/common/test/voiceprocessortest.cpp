@@ -0,0 +1,432 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Examples
+// Filename    : public.sdk/samples/vst/common/test/voiceprocessortest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Tests and benchmark of the voice processor
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this
+//     software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/samples/vst/common/voiceprocessor.h"
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/eventlist.h"
+#include "public.sdk/source/vst/testsuite/testbase.h"
+#include "public.sdk/source/vst/utility/testing.h"
+
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+/** Adds its level to the left and subtracts it from the right channel, ends releaseSamples after
+ * the note off. */
+class TestVoice
+{
+public:
+	static constexpr int32 releaseSamples = 64;
+
+	int32 getNoteId () const { return noteId; }
+	int32 getPitch () const { return pitch; }
+	ParamValue getLevel () const { return level; }
+	void setGlobalParameterStorage (void*) {}
+	void setSampleRate (ParamValue) {}
+	void setNoteExpressionValue (int32, ParamValue value) { level = value; }
+	void noteOn (int32 p, ParamValue velocity, float, int32, int32 id)
+	{
+		pitch = p;
+		level = velocity;
+		noteId = id;
+		remaining = -1;
+	}
+	void noteOff (ParamValue, int32) { remaining = releaseSamples; }
+	bool process (float* outputs[2], int32 numSamples)
+	{
+		auto value = static_cast<float> (level);
+		for (int32 i = 0; i < numSamples; i++)
+		{
+			phase += 1.f / 128.f;
+			if (phase >= 1.f)
+				phase -= 1.f;
+			outputs[0][i] += value * phase;
+			outputs[1][i] -= value * phase;
+		}
+		if (remaining < 0)
+			return true;
+		remaining -= numSamples;
+		return remaining > 0;
+	}
+	void reset ()
+	{
+		noteId = -1;
+		pitch = -1;
+		level = 0.;
+		remaining = -1;
+		phase = 0.f;
+	}
+
+private:
+	int32 noteId {-1};
+	int32 pitch {-1};
+	int32 remaining {-1};
+	ParamValue level {0.};
+	float phase {0.f};
+};
+
+//------------------------------------------------------------------------
+template <int32 maxVoices>
+struct TestVoiceProcessor : VoiceProcessorImplementation<float, TestVoice, 2, maxVoices, void>
+{
+	using Base = VoiceProcessorImplementation<float, TestVoice, 2, maxVoices, void>;
+	TestVoiceProcessor () : Base (44100.f) {}
+	TestVoice* find (int32 noteId) { return Base::findVoice (noteId); }
+	int32 getNumParkedWorkers () const
+	{
+		return this->workerPool ? this->workerPool->getNumParkedWorkers () : 0;
+	}
+};
+
+//------------------------------------------------------------------------
+Event noteOn (int32 noteId, int32 pitch, float velocity = 1.f, int32 sampleOffset = 0)
+{
+	Event e {};
+	e.type = Event::kNoteOnEvent;
+	e.sampleOffset = sampleOffset;
+	e.noteOn.pitch = static_cast<int16> (pitch);
+	e.noteOn.velocity = velocity;
+	e.noteOn.noteId = noteId;
+	return e;
+}
+
+//------------------------------------------------------------------------
+Event noteOff (int32 noteId, int32 pitch, int32 sampleOffset = 0)
+{
+	Event e {};
+	e.type = Event::kNoteOffEvent;
+	e.sampleOffset = sampleOffset;
+	e.noteOff.pitch = static_cast<int16> (pitch);
+	e.noteOff.noteId = noteId;
+	return e;
+}
+
+//------------------------------------------------------------------------
+struct TestBlock
+{
+	TestBlock (int32 numSamples) : left (numSamples), right (numSamples)
+	{
+		channels[0] = left.data ();
+		channels[1] = right.data ();
+		output.numChannels = 2;
+		output.channelBuffers32 = channels;
+		data.numSamples = numSamples;
+		data.numOutputs = 1;
+		data.outputs = &output;
+		data.inputEvents = &events;
+	}
+
+	std::vector<float> left;
+	std::vector<float> right;
+	float* channels[2];
+	AudioBusBuffers output {};
+	EventList events;
+	ProcessData data;
+};
+
+//------------------------------------------------------------------------
+/** Note on and note off for every block, each note lasts numBlocksPerNote blocks */
+void addDenseNoteTraffic (TestBlock& block, int32 blockIndex, int32 numNotesPerBlock,
+                          int32 numBlocksPerNote)
+{
+	block.events.clear ();
+	for (int32 i = 0; i < numNotesPerBlock; i++)
+	{
+		int32 offset = i * block.data.numSamples / numNotesPerBlock;
+		int32 endingId = (blockIndex - numBlocksPerNote) * numNotesPerBlock + i;
+		if (endingId >= 0)
+		{
+			Event e = noteOff (endingId, endingId % 128, offset);
+			block.events.addEvent (e);
+		}
+		int32 noteId = blockIndex * numNotesPerBlock + i;
+		Event e = noteOn (noteId, noteId % 128, 0.5f, offset);
+		block.events.addEvent (e);
+	}
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer VoiceProcessorTests ([] () {
+	constexpr auto TestSuiteName = "VoiceProcessor";
+	registerTest (TestSuiteName, STR ("Note ID lookup"), [] (ITestResult* testResult) {
+		TestVoiceProcessor<256> processor;
+		TestBlock block (TestVoice::releaseSamples);
+		std::map<int32, int32> playing;
+		uint32 random = 1;
+		for (int32 i = 0; i < 20000; i++)
+		{
+			random = random * 1664525u + 1013904223u;
+			int32 noteId = static_cast<int32> ((random >> 8) % 1024) * 4099;
+			if (playing.count (noteId))
+			{
+				// the voice ends within the block
+				processor.processEvent (noteOff (noteId, 0));
+				processor.process (block.data);
+				playing.erase (noteId);
+			}
+			else if (playing.size () < 256)
+			{
+				processor.processEvent (noteOn (noteId, i % 128));
+				playing[noteId] = i % 128;
+			}
+			EXPECT_EQ (processor.getActiveVoices (), static_cast<int32> (playing.size ()));
+		}
+		for (auto& note : playing)
+		{
+			auto* voice = processor.find (note.first);
+			EXPECT_TRUE (voice != nullptr);
+			EXPECT_EQ (voice->getNoteId (), note.first);
+			EXPECT_EQ (voice->getPitch (), note.second);
+		}
+		EXPECT_TRUE (processor.find (1) == nullptr);
+
+		processor.clearAllVoices ();
+		EXPECT_EQ (processor.getActiveVoices (), 0);
+		EXPECT_TRUE (processor.find (playing.begin ()->first) == nullptr);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Voice stealing"), [] (ITestResult* testResult) {
+		auto startVoices = [] (TestVoiceProcessor<4>& processor) {
+			processor.processEvent (noteOn (1, 60, 0.8f));
+			processor.processEvent (noteOn (2, 62, 0.2f));
+			processor.processEvent (noteOn (3, 64, 0.6f));
+			processor.processEvent (noteOn (4, 62, 0.7f));
+		};
+
+		TestVoiceProcessor<4> processor;
+		startVoices (processor);
+		processor.processEvent (noteOn (5, 62));
+		EXPECT_TRUE (processor.find (5) == nullptr);
+		EXPECT_EQ (processor.getActiveVoices (), 4);
+
+		const std::pair<VoiceProcessor::VoiceStealingMode, int32> expectedVictims[] = {
+		    {VoiceProcessor::kStealOldestVoice, 1},
+		    {VoiceProcessor::kStealQuietestVoice, 2},
+		    {VoiceProcessor::kStealSamePitchVoice, 2},
+		};
+		for (auto& expected : expectedVictims)
+		{
+			processor.clearAllVoices ();
+			processor.setVoiceStealingMode (expected.first);
+			startVoices (processor);
+			processor.processEvent (noteOn (5, 62));
+			EXPECT_TRUE (processor.find (5) != nullptr);
+			EXPECT_TRUE (processor.find (expected.second) == nullptr);
+			EXPECT_EQ (processor.getActiveVoices (), 4);
+		}
+
+		// released voices are stolen first
+		processor.clearAllVoices ();
+		processor.setVoiceStealingMode (VoiceProcessor::kStealOldestVoice);
+		startVoices (processor);
+		processor.processEvent (noteOff (3, 64));
+		processor.processEvent (noteOn (5, 70));
+		EXPECT_TRUE (processor.find (3) == nullptr);
+		EXPECT_TRUE (processor.find (1) != nullptr);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Retrigger a note"), [] (ITestResult* testResult) {
+		TestVoiceProcessor<4> processor;
+		processor.setVoiceStealingMode (VoiceProcessor::kStealOldestVoice);
+		for (int32 noteId = 1; noteId <= 4; noteId++)
+			processor.processEvent (noteOn (noteId, 60 + noteId));
+
+		// the retriggered note is neither released nor the oldest one anymore
+		processor.processEvent (noteOff (1, 61));
+		processor.processEvent (noteOn (1, 70));
+		EXPECT_EQ (processor.getActiveVoices (), 4);
+		EXPECT_EQ (processor.find (1)->getPitch (), 70);
+		processor.processEvent (noteOn (5, 72));
+		EXPECT_TRUE (processor.find (1) != nullptr);
+		EXPECT_TRUE (processor.find (2) == nullptr);
+
+		// and has the new pitch
+		processor.setVoiceStealingMode (VoiceProcessor::kStealSamePitchVoice);
+		processor.processEvent (noteOn (3, 74));
+		processor.processEvent (noteOn (6, 63));
+		EXPECT_TRUE (processor.find (3) != nullptr);
+		EXPECT_TRUE (processor.find (4) == nullptr);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Grouped rendering"), [] (ITestResult* testResult) {
+		constexpr int32 numSamples = 100;
+		TestVoiceProcessor<64> direct;
+		TestVoiceProcessor<64> grouped;
+		grouped.setGroupedRendering (true);
+		TestBlock directBlock (numSamples);
+		TestBlock groupedBlock (numSamples);
+		for (int32 blockIndex = 0; blockIndex < 20; blockIndex++)
+		{
+			addDenseNoteTraffic (directBlock, blockIndex, 8, 4);
+			addDenseNoteTraffic (groupedBlock, blockIndex, 8, 4);
+			direct.process (directBlock.data);
+			grouped.process (groupedBlock.data);
+			EXPECT_EQ (direct.getActiveVoices (), grouped.getActiveVoices ());
+			for (int32 i = 0; i < numSamples; i++)
+			{
+				EXPECT_FALSE (Test::notEqual (directBlock.left[i], groupedBlock.left[i]));
+				EXPECT_FALSE (Test::notEqual (directBlock.right[i], groupedBlock.right[i]));
+			}
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Multithreaded rendering"), [] (ITestResult* testResult) {
+		constexpr int32 numSamples = 100;
+		constexpr int32 numBlocks = 20;
+		auto render = [] (int32 numThreads) {
+			TestVoiceProcessor<64> processor;
+			processor.setRenderThreads (numThreads);
+			TestBlock block (numSamples);
+			std::vector<float> result;
+			for (int32 blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+			{
+				addDenseNoteTraffic (block, blockIndex, 8, 4);
+				processor.process (block.data);
+				result.insert (result.end (), block.left.begin (), block.left.end ());
+				result.insert (result.end (), block.right.begin (), block.right.end ());
+			}
+			return result;
+		};
+		auto reference = render (2);
+		EXPECT_EQ (reference.size (), static_cast<size_t> (numBlocks * numSamples * 2));
+		for (auto numThreads : {3, 4})
+		{
+			auto result = render (numThreads);
+			EXPECT_TRUE (result == reference);
+		}
+
+		// the voice groups are summed in a different order than single voices
+		TestVoiceProcessor<64> serial;
+		TestBlock block (numSamples);
+		for (int32 blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+		{
+			addDenseNoteTraffic (block, blockIndex, 8, 4);
+			serial.process (block.data);
+			for (int32 i = 0; i < numSamples; i++)
+			{
+				auto index = (blockIndex * 2) * numSamples + i;
+				EXPECT_FALSE (Test::notEqual (block.left[i], reference[index]));
+				EXPECT_FALSE (Test::notEqual (block.right[i], reference[index + numSamples]));
+			}
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Parking render threads"), [] (ITestResult* testResult) {
+		TestVoiceProcessor<64> processor;
+		processor.setRenderThreads (3);
+		EXPECT_EQ (processor.getRenderThreads (), 3);
+		TestBlock block (64);
+		addDenseNoteTraffic (block, 0, 4, 4);
+		processor.process (block.data);
+		EXPECT_EQ (processor.getActiveVoices (), 4);
+
+		// a single voice group is rendered on the audio thread, the workers go to sleep
+		auto waitForParkedWorkers = [&] (int32 expected) {
+			for (int32 i = 0; i < 500 && processor.getNumParkedWorkers () != expected; i++)
+				std::this_thread::sleep_for (std::chrono::milliseconds (2));
+			return processor.getNumParkedWorkers () == expected;
+		};
+		EXPECT_TRUE (waitForParkedWorkers (2));
+
+		// and are woken up by enough voices
+		for (int32 blockIndex = 1; blockIndex < 4; blockIndex++)
+		{
+			addDenseNoteTraffic (block, blockIndex, 16, 4);
+			processor.process (block.data);
+		}
+		EXPECT_EQ (processor.getActiveVoices (), 52);
+		EXPECT_TRUE (waitForParkedWorkers (2));
+
+		processor.setRenderThreads (1);
+		EXPECT_EQ (processor.getRenderThreads (), 1);
+		EXPECT_EQ (processor.getNumParkedWorkers (), 0);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+// only run by the validator selftest with extensive tests
+ModuleInitializer VoiceProcessorBenchmarks ([] () {
+	constexpr auto TestSuiteName = "VoiceProcessorBenchmark";
+	registerTest (TestSuiteName, STR ("Throughput"), [] (ITestResult* testResult) {
+		constexpr int32 numBlocks = 500;
+		constexpr int32 numSamples = 256;
+		constexpr int32 numNotesPerBlock = 64;
+		struct Variant
+		{
+			const char* name;
+			bool groupedRendering;
+			int32 numThreads;
+		};
+		const Variant variants[] = {
+		    {"direct", false, 1}, {"grouped", true, 1}, {"2 threads", false, 2}, {"4 threads", false, 4}};
+		for (auto& variant : variants)
+		{
+			TestVoiceProcessor<256> processor;
+			processor.setVoiceStealingMode (VoiceProcessor::kStealOldestVoice);
+			processor.setGroupedRendering (variant.groupedRendering);
+			processor.setRenderThreads (variant.numThreads);
+			TestBlock block (numSamples);
+			std::chrono::steady_clock::duration duration {};
+			for (int32 blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+			{
+				addDenseNoteTraffic (block, blockIndex, numNotesPerBlock, 6);
+				auto start = std::chrono::steady_clock::now ();
+				processor.process (block.data);
+				duration += std::chrono::steady_clock::now () - start;
+			}
+			EXPECT_EQ (processor.getActiveVoices (), 256);
+			auto seconds = std::chrono::duration<double> (duration).count ();
+			addMessage (testResult,
+			            printf ("   %s: %.1f us per block of %d samples with 256 voices",
+			                    variant.name,
+			                    seconds * 1000000. / numBlocks, numSamples));
+		}
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
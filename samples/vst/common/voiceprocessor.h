@@ -37,9 +37,14 @@
 #pragma once
 
 #include "base/source/fdebug.h"
+#include "public.sdk/source/vst/utility/audiobuffers.h"
 #include "pluginterfaces/vst/ivstaudioprocessor.h"
 #include "pluginterfaces/vst/ivstevents.h"
+#include "voiceworkerpool.h"
 #include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 #ifdef DEBUG_LOG
 #undef DEBUG_LOG
@@ -51,6 +56,10 @@
 #define VOICEPROCESSOR_BLOCKSIZE 32
 #endif
 
+#ifndef VOICEPROCESSOR_VOICES_PER_GROUP
+#define VOICEPROCESSOR_VOICES_PER_GROUP 8
+#endif
+
 namespace Steinberg {
 namespace Vst {
 
@@ -108,6 +117,15 @@ tresult PLUGIN_API MySynthProcessor::process (ProcessData& data)
 class VoiceProcessor
 {
 public:
+	/** What to do with a note on when all voices are playing. */
+	enum VoiceStealingMode
+	{
+		kNoVoiceStealing,		///< ignore the new note
+		kStealOldestVoice,		///< restart the voice started first
+		kStealQuietestVoice,	///< restart the voice with the lowest level
+		kStealSamePitchVoice	///< restart a voice playing the same pitch, else the oldest one
+	};
+
 	VoiceProcessor () {}
 	virtual ~VoiceProcessor () {}
 
@@ -124,11 +142,41 @@ public:
 
 	void clearOutputNeeded (bool val) { mClearOutputNeeded = val; }
 
+	/** Sets the voice stealing mode, default is kNoVoiceStealing. */
+	void setVoiceStealingMode (VoiceStealingMode mode) { voiceStealingMode = mode; }
+	VoiceStealingMode getVoiceStealingMode () const { return voiceStealingMode; }
+
+	/** When enabled all voices are rendered into an internal scratch bus which is mixed into the
+	 * output once per block, instead of every voice adding to the output buffers. Without
+	 * VOICEPROCESSOR_BLOCKSIZE the voices are then processed in chunks of 64 samples. */
+	void setGroupedRendering (bool state) { groupedRendering = state; }
+	bool isGroupedRendering () const { return groupedRendering; }
+
+	/** Renders the voices on numThreads threads, the audio thread being one of them. numThreads
+	 * <= 1 renders on the audio thread only (default). Starts or stops worker threads, so call it
+	 * only while not processing. */
+	virtual void setRenderThreads (int32 numThreads)
+	{
+		workerPool.reset (numThreads > 1 ? new VoiceWorkerPool (numThreads - 1) : nullptr);
+	}
+	/** Returns the number of threads rendering voices. */
+	int32 getRenderThreads () const { return workerPool ? workerPool->getNumThreads () : 1; }
+
 protected:
 	int32 activeVoices {0};
 	bool mClearOutputNeeded {true};
+	bool groupedRendering {false};
+	VoiceStealingMode voiceStealingMode {kNoVoiceStealing};
+	std::unique_ptr<VoiceWorkerPool> workerPool;
 };
 
+//-----------------------------------------------------------------------------
+/** Number of bits for a hash table with at least n entries. */
+constexpr int32 voiceHashBits (int32 n, int32 bits = 1)
+{
+	return (1 << bits) >= n ? bits : voiceHashBits (n, bits + 1);
+}
+
 //-----------------------------------------------------------------------------
 /** A Simple Voice Processor Implementation supporting note expression events.
 
@@ -150,10 +198,24 @@ bool process (SamplePrecision* outputBuffers[numChannels], int32 numSamples);
 void reset ()
 \endcode
 
+Optionally it can implement the following method, used by kStealQuietestVoice:
+\code{.cpp}
+ParamValue getLevel () const;
+\endcode
+
 See \ref Steinberg::Vst::VoiceBase for an example base class.
 
-This implementation does not support advanced features like voice stealing when maxVoices is
-reached, etc ...
+Voices are found by note ID via a hash table and only the active voices are visited when
+rendering. When maxVoices is reached, a voice is stolen according to the VoiceStealingMode, where
+voices which already received a note off are preferred. A stolen voice is reset without a fade
+out.
+
+With more than one render thread the active voices are split into groups of
+VOICEPROCESSOR_VOICES_PER_GROUP voices, each group is rendered into its own buffer and the groups
+are distributed over the threads. The group buffers are mixed in a fixed order, so the output
+does not depend on the number of threads or their timing. When there is only one group it is
+rendered on the audio thread and the worker threads go to sleep after a while. The process method
+of different voices is then called concurrently, so voices must not write shared data.
 */
 //-----------------------------------------------------------------------------
 template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
@@ -168,10 +230,74 @@ public:
 	void processEvent (Event evt) override;
 
 	void clearAllVoices () override;
+	void setRenderThreads (int32 numThreads) override;
 protected:
-	VoiceClass* getVoice (int32 noteId);
+	/** Returns the voice playing noteId or a free (or stolen) voice for it. To be called for note
+	 *  ons, the voice counts as started now. */
+	VoiceClass* getVoice (int32 noteId, int32 pitch = -1);
+	/** Returns the voice playing noteId or nullptr. */
 	VoiceClass* findVoice (int32 noteId);
+	/** Renders all active voices and releases the finished ones. */
+	void renderVoices (Precision* buffers[numChannels], int32 numSamples);
+	/** Renders the active voices group wise, on the worker threads if there are enough voices. */
+	void renderVoiceGroups (Precision* buffers[numChannels], int32 numSamples);
+	/** Renders the groups of one thread, called on the audio and the worker threads. */
+	void renderVoiceGroupsOfThread (int32 threadIndex);
+	static void renderVoiceGroupsJob (void* context, int32 threadIndex);
+
+	int32 findSlot (int32 noteId) const;
+	int32 startSlot (int32 noteId, int32 pitch);
+	int32 selectVoiceToSteal (int32 pitch) const;
+	void releaseSlot (int32 slot);
+	void resetSlots ();
+	void insertNoteId (int32 slot);
+	void removeNoteId (int32 slot);
+
+	static constexpr int32 kHashBits = voiceHashBits (maxVoices * 2);
+	static constexpr int32 kHashSize = 1 << kHashBits;
+	static constexpr int32 kScratchBlockSize =
+	    VOICEPROCESSOR_BLOCKSIZE > 0 ? VOICEPROCESSOR_BLOCKSIZE : 64;
+	static constexpr int32 kVoicesPerGroup = VOICEPROCESSOR_VOICES_PER_GROUP;
+	static constexpr int32 kMaxGroups = (maxVoices + kVoicesPerGroup - 1) / kVoicesPerGroup;
+
+	static uint32 hashNoteId (int32 noteId)
+	{
+		return (static_cast<uint32> (noteId) * 0x9E3779B1u) >> (32 - kHashBits);
+	}
+	template <typename V>
+	static auto getVoiceLevel (const V& voice, int) -> decltype (ParamValue (voice.getLevel ()))
+	{
+		return voice.getLevel ();
+	}
+	template <typename V>
+	static ParamValue getVoiceLevel (const V&, ...)
+	{
+		return 0.;
+	}
+
 	VoiceClass voices[maxVoices];
+
+	// voice state, indexed by voice slot
+	int32 slotNoteIds[maxVoices];
+	int32 slotPitches[maxVoices];
+	uint64 slotStartOrder[maxVoices];
+	bool slotReleased[maxVoices];
+	int32 slotActivePosition[maxVoices];
+
+	int32 activeSlots[maxVoices];
+	int32 freeSlots[maxVoices];
+	int32 numFreeSlots {0};
+	int32 noteIdHash[kHashSize];
+	uint64 startCounter {0};
+
+	alignas (16) Precision scratchBus[numChannels * kScratchBlockSize];
+
+	// multithreaded rendering, set up by the audio thread before the workers start
+	std::vector<Precision> groupBuffers;
+	bool slotFinished[maxVoices];
+	int32 groupNumSamples {0};
+	int32 numGroups {0};
+	int32 numGroupThreads {0};
 };
 
 //-----------------------------------------------------------------------------
@@ -188,6 +314,7 @@ VoiceProcessorImplementation<
 		voices[i].setSampleRate (sampleRate);
 		voices[i].reset ();
 	}
+	resetSlots ();
 }
 
 //-----------------------------------------------------------------------------
@@ -202,43 +329,363 @@ VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
 template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
           class GlobalParameterStorage>
 VoiceClass* VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
-                                         GlobalParameterStorage>::getVoice (int32 noteId)
+                                         GlobalParameterStorage>::getVoice (int32 noteId,
+                                                                            int32 pitch)
+{
+	if (noteId == -1)
+		return nullptr;
+	int32 slot = findSlot (noteId);
+	if (slot < 0)
+	{
+		slot = startSlot (noteId, pitch);
+		return slot < 0 ? nullptr : &voices[slot];
+	}
+
+	// a retriggered note is a new note for the voice stealing
+	slotPitches[slot] = pitch;
+	slotStartOrder[slot] = startCounter++;
+	slotReleased[slot] = false;
+	return &voices[slot];
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+VoiceClass* VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                         GlobalParameterStorage>::findVoice (int32 noteId)
 {
-	VoiceClass* firstFreeVoice = 0;
-	if (noteId != -1)
+	int32 slot = findSlot (noteId);
+	return slot < 0 ? nullptr : &voices[slot];
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+int32 VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                   GlobalParameterStorage>::findSlot (int32 noteId) const
+{
+	if (noteId == -1)
+		return -1;
+	for (uint32 index = hashNoteId (noteId);; index = (index + 1) & (kHashSize - 1))
 	{
-		for (int32 i = 0; i < maxVoices; i++)
+		int32 slot = noteIdHash[index];
+		if (slot < 0 || slotNoteIds[slot] == noteId)
+			return slot;
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+int32 VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                   GlobalParameterStorage>::startSlot (int32 noteId, int32 pitch)
+{
+	int32 slot = -1;
+	if (numFreeSlots > 0)
+	{
+		slot = freeSlots[--numFreeSlots];
+	}
+	else
+	{
+		slot = selectVoiceToSteal (pitch);
+		if (slot < 0)
+			return -1;
+		voices[slot].reset ();
+		removeNoteId (slot);
+#if DEBUG_LOG
+		FDebugPrint ("Voice stolen from note : %d\n", slotNoteIds[slot]);
+#endif
+	}
+	if (slotActivePosition[slot] < 0)
+	{
+		slotActivePosition[slot] = this->activeVoices;
+		activeSlots[this->activeVoices++] = slot;
+	}
+	slotNoteIds[slot] = noteId;
+	slotPitches[slot] = pitch;
+	slotStartOrder[slot] = startCounter++;
+	slotReleased[slot] = false;
+	insertNoteId (slot);
+	return slot;
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+int32 VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                   GlobalParameterStorage>::selectVoiceToSteal (int32 pitch) const
+{
+	if (voiceStealingMode == kNoVoiceStealing)
+		return -1;
+
+	// released voices are always preferred, then the mode decides, then the age
+	int32 best = -1;
+	bool bestSamePitch = false;
+	ParamValue bestLevel = 0.;
+	for (int32 i = 0; i < this->activeVoices; i++)
+	{
+		int32 slot = activeSlots[i];
+		bool samePitch = voiceStealingMode == kStealSamePitchVoice && slotPitches[slot] == pitch;
+		ParamValue level =
+		    voiceStealingMode == kStealQuietestVoice ? getVoiceLevel (voices[slot], 0) : 0.;
+		if (best >= 0)
 		{
-			if (voices[i].getNoteId () == noteId)
+			if (slotReleased[slot] != slotReleased[best])
+			{
+				if (!slotReleased[slot])
+					continue;
+			}
+			else if (samePitch != bestSamePitch)
+			{
+				if (!samePitch)
+					continue;
+			}
+			else if (level != bestLevel)
 			{
-				return &voices[i];
+				if (level > bestLevel)
+					continue;
 			}
-			else if (firstFreeVoice == 0 && voices[i].getNoteId () == -1)
+			else if (slotStartOrder[slot] > slotStartOrder[best])
 			{
-				firstFreeVoice = &voices[i];
+				continue;
 			}
 		}
+		best = slot;
+		bestSamePitch = samePitch;
+		bestLevel = level;
 	}
-	return firstFreeVoice;
+	return best;
 }
 
 //-----------------------------------------------------------------------------
 template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
           class GlobalParameterStorage>
-VoiceClass* VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
-                                         GlobalParameterStorage>::findVoice (int32 noteId)
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::releaseSlot (int32 slot)
 {
-	if (noteId != -1)
+	voices[slot].reset ();
+	removeNoteId (slot);
+	slotNoteIds[slot] = -1;
+
+	// move the last active slot into the gap
+	int32 position = slotActivePosition[slot];
+	int32 last = activeSlots[--this->activeVoices];
+	activeSlots[position] = last;
+	slotActivePosition[last] = position;
+	slotActivePosition[slot] = -1;
+
+	freeSlots[numFreeSlots++] = slot;
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::resetSlots ()
+{
+	// free slots are taken from the end, so the first voice is used first
+	for (int32 i = 0; i < maxVoices; i++)
 	{
-		for (int32 i = 0; i < maxVoices; i++)
+		slotNoteIds[i] = -1;
+		slotPitches[i] = -1;
+		slotStartOrder[i] = 0;
+		slotReleased[i] = false;
+		slotActivePosition[i] = -1;
+		slotFinished[i] = false;
+		freeSlots[i] = maxVoices - 1 - i;
+	}
+	numFreeSlots = maxVoices;
+	for (int32 i = 0; i < kHashSize; i++)
+		noteIdHash[i] = -1;
+	this->activeVoices = 0;
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::insertNoteId (int32 slot)
+{
+	uint32 index = hashNoteId (slotNoteIds[slot]);
+	while (noteIdHash[index] >= 0)
+		index = (index + 1) & (kHashSize - 1);
+	noteIdHash[index] = slot;
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::removeNoteId (int32 slot)
+{
+	uint32 index = hashNoteId (slotNoteIds[slot]);
+	while (noteIdHash[index] != slot)
+		index = (index + 1) & (kHashSize - 1);
+
+	// shift back the following entries of the probe sequence to close the gap
+	uint32 gap = index;
+	while (true)
+	{
+		index = (index + 1) & (kHashSize - 1);
+		int32 next = noteIdHash[index];
+		if (next < 0)
+			break;
+		uint32 home = hashNoteId (slotNoteIds[next]);
+		if (((index - home) & (kHashSize - 1)) >= ((index - gap) & (kHashSize - 1)))
+		{
+			noteIdHash[gap] = next;
+			gap = index;
+		}
+	}
+	noteIdHash[gap] = -1;
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::renderVoices (Precision*
+                                                                             buffers[numChannels],
+                                                                         int32 numSamples)
+{
+	// going backwards, so that releasing a voice only moves an already rendered one
+	auto renderInto = [this] (Precision** outputs, int32 count) {
+		for (int32 i = this->activeVoices - 1; i >= 0; i--)
+		{
+			int32 slot = activeSlots[i];
+			if (!voices[slot].process (outputs, count))
+				releaseSlot (slot);
+		}
+	};
+
+	if (workerPool)
+	{
+		renderVoiceGroups (buffers, numSamples);
+		return;
+	}
+	if (!groupedRendering)
+	{
+		renderInto (buffers, numSamples);
+		return;
+	}
+
+	for (int32 offset = 0; offset < numSamples; offset += kScratchBlockSize)
+	{
+		int32 count = numSamples - offset;
+		if (count > kScratchBlockSize)
+			count = kScratchBlockSize;
+		Precision* scratch[numChannels];
+		for (int32 c = 0; c < numChannels; c++)
+		{
+			scratch[c] = scratchBus + c * kScratchBlockSize;
+			memset (scratch[c], 0, count * sizeof (Precision));
+		}
+		renderInto (scratch, count);
+		for (int32 c = 0; c < numChannels; c++)
+		{
+			Precision* output = buffers[c] + offset;
+			const Precision* source = scratch[c];
+			for (int32 i = 0; i < count; i++)
+				output[i] += source[i];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::renderVoiceGroups (Precision*
+                                                                                  buffers[numChannels],
+                                                                              int32 numSamples)
+{
+	for (int32 offset = 0; offset < numSamples; offset += kScratchBlockSize)
+	{
+		groupNumSamples = numSamples - offset;
+		if (groupNumSamples > kScratchBlockSize)
+			groupNumSamples = kScratchBlockSize;
+		numGroups = (this->activeVoices + kVoicesPerGroup - 1) / kVoicesPerGroup;
+		numGroupThreads = std::min<int32> (numGroups, workerPool->getNumThreads ());
+		if (numGroupThreads > 1)
+			workerPool->run (&renderVoiceGroupsJob, this);
+		else
+			renderVoiceGroupsOfThread (0);
+
+		// mix in group order
+		for (int32 c = 0; c < numChannels; c++)
+		{
+			Precision* output = buffers[c] + offset;
+			for (int32 group = 0; group < numGroups; group++)
+			{
+				const Precision* source =
+				    groupBuffers.data () + (group * numChannels + c) * kScratchBlockSize;
+				for (int32 i = 0; i < groupNumSamples; i++)
+					output[i] += source[i];
+			}
+		}
+
+		// going backwards, so that releasing a voice only moves an already checked one
+		for (int32 i = this->activeVoices - 1; i >= 0; i--)
 		{
-			if (voices[i].getNoteId () == noteId)
+			int32 slot = activeSlots[i];
+			if (slotFinished[slot])
 			{
-				return &voices[i];
+				slotFinished[slot] = false;
+				releaseSlot (slot);
 			}
 		}
 	}
-	return 0;
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::renderVoiceGroupsOfThread (int32
+                                                                                          threadIndex)
+{
+	if (threadIndex >= numGroupThreads)
+		return;
+	int32 firstGroup = threadIndex * numGroups / numGroupThreads;
+	int32 endGroup = (threadIndex + 1) * numGroups / numGroupThreads;
+	for (int32 group = firstGroup; group < endGroup; group++)
+	{
+		Precision* outputs[numChannels];
+		for (int32 c = 0; c < numChannels; c++)
+		{
+			outputs[c] = groupBuffers.data () + (group * numChannels + c) * kScratchBlockSize;
+			memset (outputs[c], 0, groupNumSamples * sizeof (Precision));
+		}
+		int32 endVoice = std::min<int32> ((group + 1) * kVoicesPerGroup, this->activeVoices);
+		for (int32 i = group * kVoicesPerGroup; i < endVoice; i++)
+		{
+			int32 slot = activeSlots[i];
+			slotFinished[slot] = !voices[slot].process (outputs, groupNumSamples);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::renderVoiceGroupsJob (void* context,
+                                                                                 int32 threadIndex)
+{
+	static_cast<VoiceProcessorImplementation*> (context)->renderVoiceGroupsOfThread (threadIndex);
+}
+
+//-----------------------------------------------------------------------------
+template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
+          class GlobalParameterStorage>
+void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
+                                  GlobalParameterStorage>::setRenderThreads (int32 numThreads)
+{
+	VoiceProcessor::setRenderThreads (numThreads);
+	if (workerPool)
+		groupBuffers.assign (kMaxGroups * numChannels * kScratchBlockSize, Precision (0));
+	else
+		groupBuffers.clear ();
 }
 
 //-----------------------------------------------------------------------------
@@ -252,6 +699,7 @@ void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
 		if (voices[i].getNoteId () != -1)
 			voices[i].reset ();
 	}
+	resetSlots ();
 	VoiceProcessor::clearAllVoices ();
 }
 
@@ -268,12 +716,11 @@ void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
 		{
 			if (e.noteOn.noteId == -1)
 				e.noteOn.noteId = e.noteOn.pitch;
-			VoiceClass* voice = getVoice (e.noteOn.noteId);
+			VoiceClass* voice = getVoice (e.noteOn.noteId, e.noteOn.pitch);
 			if (voice)
 			{
 				voice->noteOn (e.noteOn.pitch, e.noteOn.velocity, e.noteOn.tuning, e.sampleOffset,
 				               e.noteOn.noteId);
-				this->activeVoices++;
 				// data.outputEvents->addEvent (e);
 			}
 			break;
@@ -283,10 +730,11 @@ void VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
 		{
 			if (e.noteOff.noteId == -1)
 				e.noteOff.noteId = e.noteOff.pitch;
-			VoiceClass* voice = findVoice (e.noteOff.noteId);
-			if (voice)
+			int32 slot = findSlot (e.noteOff.noteId);
+			if (slot >= 0)
 			{
-				voice->noteOff (e.noteOff.velocity, e.sampleOffset);
+				voices[slot].noteOff (e.noteOff.velocity, e.sampleOffset);
+				slotReleased[slot] = true;
 				// data.outputEvents->addEvent (e);
 			}
 #if DEBUG_LOG
@@ -327,9 +775,10 @@ template <class Precision, class VoiceClass, int32 numChannels, int32 maxVoices,
 tresult VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoices,
                                      GlobalParameterStorage>::process (ProcessData& data)
 {
+	Precision** outputs = getChannelBuffers<Precision> (data.outputs[0]);
 	if (mClearOutputNeeded)
 		for (int32 i = 0; i < numChannels; i++)
-			memset (data.outputs[0].channelBuffers32[i], 0, data.numSamples * sizeof (Precision));
+			memset (outputs[i], 0, data.numSamples * sizeof (Precision));
 
 	IEventList* inputEvents = data.inputEvents;
 	if (inputEvents)
@@ -345,17 +794,7 @@ tresult VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoic
 		}
 	}
 
-	for (int32 i = 0; i < maxVoices; i++)
-	{
-		if (voices[i].getNoteId () != -1)
-		{
-			if (!voices[i].process ((Precision**)data.outputs[0].channelBuffers32, data.numSamples))
-			{
-				voices[i].reset ();
-				this->activeVoices--;
-			}
-		}
-	}
+	renderVoices (outputs, data.numSamples);
 	return kResultTrue;
 }
 
@@ -389,7 +828,7 @@ tresult VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoic
 	Precision* buffers[numChannels];
 	for (int32 i = 0; i < numChannels; i++)
 	{
-		buffers[i] = (Precision*)data.outputs[0].channelBuffers32[i];
+		buffers[i] = getChannelBuffers<Precision> (data.outputs[0])[i];
 		if (mClearOutputNeeded)
 			memset (buffers[i], 0, data.numSamples * sizeof (Precision));
 	}
@@ -428,17 +867,7 @@ tresult VoiceProcessorImplementation<Precision, VoiceClass, numChannels, maxVoic
 		} // end while (event != 0)
 
 		// now process the block
-		for (int32 i = 0; i < maxVoices; i++)
-		{
-			if (voices[i].getNoteId () != -1)
-			{
-				if (!voices[i].process (buffers, samplesToProcess))
-				{
-					voices[i].reset ();
-					this->activeVoices--;
-				}
-			}
-		}
+		renderVoices (buffers, samplesToProcess);
 
 		// update the counters
 		for (int32 i = 0; i < numChannels; i++)
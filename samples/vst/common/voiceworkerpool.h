@@ -0,0 +1,239 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Examples
+// Filename    : public.sdk/samples/vst/common/voiceworkerpool.h
+// Created by  : Steinberg, 10/2026
+// Description : Worker threads for the voice processor
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this
+//     software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "pluginterfaces/base/ftypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if SMTG_OS_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(_M_ARM64)
+#include <intrin.h>
+#endif
+
+namespace Steinberg {
+namespace Vst {
+
+//-----------------------------------------------------------------------------
+/** A small pool of worker threads running one job per processing block.
+
+run () hands the job to all workers and runs it on the calling thread as well, then spins until
+every worker has finished. The workers spin while waiting for the next job, so handing over a job
+is realtime safe and fast. When no job arrives for parkAfter, the workers go to sleep and the next
+run () wakes them up, which briefly locks a mutex.
+
+On the first run () the workers take over the scheduling priority of the calling thread, which is
+normally the realtime audio thread of the host.
+*/
+//-----------------------------------------------------------------------------
+class VoiceWorkerPool
+{
+public:
+	/** Called with the index of the thread, 0 is the thread calling run (). */
+	using Job = void (*) (void* context, int32 threadIndex);
+
+	/** numWorkers threads are started in addition to the thread calling run (). */
+	explicit VoiceWorkerPool (int32 numWorkers,
+	                          std::chrono::milliseconds parkAfter = std::chrono::milliseconds (20));
+	~VoiceWorkerPool ();
+
+	/** Returns the number of threads taking part in run (), including the calling thread. */
+	int32 getNumThreads () const { return static_cast<int32> (threads.size ()) + 1; }
+
+	/** Returns the number of sleeping workers. */
+	int32 getNumParkedWorkers () const { return numParked.load (); }
+
+	/** Calls job for every thread index and returns when all calls are done. */
+	void run (Job job, void* context);
+
+private:
+	void workerLoop (int32 threadIndex);
+	void adoptCallerPriority ();
+	/** Spins for a while, then yields so that the threads also progress on fewer cores. */
+	static void pause (uint32 spins);
+
+	std::vector<std::thread> threads;
+	std::chrono::milliseconds parkAfter;
+
+	Job job {nullptr};
+	void* context {nullptr};
+	std::atomic<uint32> generation {0};
+	std::atomic<int32> pending {0};
+	std::atomic<int32> numParked {0};
+	std::atomic<bool> quit {false};
+	bool priorityAdopted {false};
+
+	std::mutex parkMutex;
+	std::condition_variable parkCondition;
+};
+
+//-----------------------------------------------------------------------------
+inline VoiceWorkerPool::VoiceWorkerPool (int32 numWorkers, std::chrono::milliseconds parkAfter)
+: parkAfter (parkAfter)
+{
+	for (int32 i = 0; i < numWorkers; i++)
+	{
+		threads.emplace_back ([this, i] () { workerLoop (i + 1); });
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline VoiceWorkerPool::~VoiceWorkerPool ()
+{
+	{
+		std::lock_guard<std::mutex> lock (parkMutex);
+		quit = true;
+	}
+	parkCondition.notify_all ();
+	for (auto& thread : threads)
+		thread.join ();
+}
+
+//-----------------------------------------------------------------------------
+inline void VoiceWorkerPool::run (Job newJob, void* newContext)
+{
+	if (!priorityAdopted)
+		adoptCallerPriority ();
+
+	job = newJob;
+	context = newContext;
+	pending.store (static_cast<int32> (threads.size ()), std::memory_order_relaxed);
+	generation.fetch_add (1);
+
+	// a worker going to sleep increments numParked before it checks the generation, so either it
+	// sees the new generation or it is counted here
+	if (numParked.load () > 0)
+	{
+		std::lock_guard<std::mutex> lock (parkMutex);
+		parkCondition.notify_all ();
+	}
+
+	job (context, 0);
+
+	uint32 spins = 0;
+	while (pending.load (std::memory_order_acquire) > 0)
+		pause (++spins);
+}
+
+//-----------------------------------------------------------------------------
+inline void VoiceWorkerPool::workerLoop (int32 threadIndex)
+{
+	uint32 lastGeneration = 0;
+	while (true)
+	{
+		auto idleSince = std::chrono::steady_clock::now ();
+		uint32 spins = 0;
+		uint32 currentGeneration;
+		while ((currentGeneration = generation.load (std::memory_order_acquire)) ==
+		           lastGeneration &&
+		       !quit.load (std::memory_order_relaxed))
+		{
+			pause (++spins);
+			if ((spins & 0x3FF) != 0 || std::chrono::steady_clock::now () - idleSince < parkAfter)
+				continue;
+
+			std::unique_lock<std::mutex> lock (parkMutex);
+			numParked.fetch_add (1);
+			parkCondition.wait (lock, [&] () { return generation.load () != lastGeneration || quit; });
+			numParked.fetch_sub (1);
+			idleSince = std::chrono::steady_clock::now ();
+		}
+		if (quit)
+			break;
+
+		lastGeneration = currentGeneration;
+		job (context, threadIndex);
+		pending.fetch_sub (1, std::memory_order_release);
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline void VoiceWorkerPool::pause (uint32 spins)
+{
+	if (spins > 4096)
+	{
+		std::this_thread::yield ();
+		return;
+	}
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	_mm_pause ();
+#elif defined(_M_ARM64)
+	__yield ();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__ ("yield");
+#else
+	std::this_thread::yield ();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+inline void VoiceWorkerPool::adoptCallerPriority ()
+{
+	priorityAdopted = true;
+#if SMTG_OS_WINDOWS
+	int priority = GetThreadPriority (GetCurrentThread ());
+	for (auto& thread : threads)
+		SetThreadPriority (thread.native_handle (), priority);
+#else
+	int policy;
+	sched_param param {};
+	if (pthread_getschedparam (pthread_self (), &policy, &param) != 0)
+		return;
+	for (auto& thread : threads)
+		pthread_setschedparam (thread.native_handle (), policy, &param);
+#endif
+}
+
+//------------------------------------------------------------------------
+} // namespace Vst
+} // namespace Steinberg
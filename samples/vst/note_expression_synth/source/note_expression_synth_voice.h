@@ -160,6 +160,9 @@ public:
 
 	void setNoteExpressionValue (int32 index, ParamValue value) SMTG_OVERRIDE;
 
+	/** Returns the current volume, used for voice stealing. */
+	ParamValue getLevel () const { return currentVolume; }
+
 protected:
 	uint32 n;
 	int32 noisePos;
@@ -37,17 +37,7 @@
 
 #include "commonstringconvert.h"
 
-#include <codecvt>
-#include <istream>
-#include <locale>
-
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-#elif defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
+#include <cstring>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -56,41 +46,194 @@ namespace StringConvert {
 //------------------------------------------------------------------------
 namespace {
 
-#if defined(_MSC_VER) && _MSC_VER >= 1900
-#define USE_WCHAR_AS_UTF16TYPE
-using UTF16Type = wchar_t;
-#else
-using UTF16Type = char16_t;
-#endif
+constexpr char16_t kReplacementCharacter = 0xFFFD;
 
-using Converter = std::wstring_convert<std::codecvt_utf8_utf16<UTF16Type>, UTF16Type>;
+//------------------------------------------------------------------------
+/** true if the 8 bytes at data are all ASCII */
+inline bool isASCII8 (const char* data)
+{
+	uint64_t word;
+	memcpy (&word, data, sizeof (word));
+	return (word & 0x8080808080808080ull) == 0;
+}
 
 //------------------------------------------------------------------------
-Converter& converter ()
+/** decodes one code point, returns the number of bytes consumed or 0 for an invalid sequence */
+inline size_t decodeUTF8 (const unsigned char* data, size_t numBytes, uint32_t& codePoint)
 {
-	static Converter conv;
-	return conv;
+	auto lead = data[0];
+	size_t length;
+	uint32_t minimum;
+	if (lead < 0xC2)
+		return 0; // continuation byte or overlong two byte sequence
+	if (lead < 0xE0)
+	{
+		length = 2;
+		minimum = 0x80;
+		codePoint = lead & 0x1F;
+	}
+	else if (lead < 0xF0)
+	{
+		length = 3;
+		minimum = 0x800;
+		codePoint = lead & 0x0F;
+	}
+	else if (lead < 0xF5)
+	{
+		length = 4;
+		minimum = 0x10000;
+		codePoint = lead & 0x07;
+	}
+	else
+		return 0;
+	if (length > numBytes)
+		return 0;
+	for (size_t i = 1; i < length; ++i)
+	{
+		if ((data[i] & 0xC0) != 0x80)
+			return 0;
+		codePoint = (codePoint << 6) | (data[i] & 0x3F);
+	}
+	if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+		return 0;
+	return length;
 }
 
 //------------------------------------------------------------------------
 } // anonymous
 
+//------------------------------------------------------------------------
+bool utf8ToUtf16 (const char* utf8, size_t numBytes, char16_t* utf16, size_t maxUnits,
+                  size_t& numUnits)
+{
+	auto src = reinterpret_cast<const unsigned char*> (utf8);
+	size_t in = 0;
+	size_t out = 0;
+	while (in < numBytes)
+	{
+		// ASCII runs are widened 8 bytes at a time
+		while (in + 8 <= numBytes && out + 8 <= maxUnits && isASCII8 (utf8 + in))
+		{
+			for (size_t i = 0; i < 8; ++i)
+				utf16[out + i] = src[in + i];
+			in += 8;
+			out += 8;
+		}
+		if (in == numBytes)
+			break;
+		if (src[in] < 0x80)
+		{
+			if (out == maxUnits)
+				break;
+			utf16[out++] = src[in++];
+			continue;
+		}
+		uint32_t codePoint;
+		auto length = decodeUTF8 (src + in, numBytes - in, codePoint);
+		if (length == 0)
+		{
+			codePoint = kReplacementCharacter;
+			length = 1;
+		}
+		if (codePoint < 0x10000)
+		{
+			if (out == maxUnits)
+				break;
+			utf16[out++] = static_cast<char16_t> (codePoint);
+		}
+		else
+		{
+			if (out + 2 > maxUnits)
+				break;
+			codePoint -= 0x10000;
+			utf16[out++] = static_cast<char16_t> (0xD800 + (codePoint >> 10));
+			utf16[out++] = static_cast<char16_t> (0xDC00 + (codePoint & 0x3FF));
+		}
+		in += length;
+	}
+	numUnits = out;
+	return in == numBytes;
+}
+
+//------------------------------------------------------------------------
+bool utf16ToUtf8 (const char16_t* utf16, size_t numUnits, char* utf8, size_t maxBytes,
+                  size_t& numBytes)
+{
+	size_t in = 0;
+	size_t out = 0;
+	while (in < numUnits)
+	{
+		uint32_t codePoint = utf16[in];
+		if (codePoint < 0x80)
+		{
+			if (out == maxBytes)
+				break;
+			utf8[out++] = static_cast<char> (codePoint);
+			++in;
+			continue;
+		}
+		size_t consumed = 1;
+		if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+		{
+			if (codePoint <= 0xDBFF && in + 1 < numUnits && utf16[in + 1] >= 0xDC00 &&
+			    utf16[in + 1] <= 0xDFFF)
+			{
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (utf16[in + 1] - 0xDC00);
+				consumed = 2;
+			}
+			else
+				codePoint = kReplacementCharacter;
+		}
+		if (codePoint < 0x800)
+		{
+			if (out + 2 > maxBytes)
+				break;
+			utf8[out++] = static_cast<char> (0xC0 | (codePoint >> 6));
+			utf8[out++] = static_cast<char> (0x80 | (codePoint & 0x3F));
+		}
+		else if (codePoint < 0x10000)
+		{
+			if (out + 3 > maxBytes)
+				break;
+			utf8[out++] = static_cast<char> (0xE0 | (codePoint >> 12));
+			utf8[out++] = static_cast<char> (0x80 | ((codePoint >> 6) & 0x3F));
+			utf8[out++] = static_cast<char> (0x80 | (codePoint & 0x3F));
+		}
+		else
+		{
+			if (out + 4 > maxBytes)
+				break;
+			utf8[out++] = static_cast<char> (0xF0 | (codePoint >> 18));
+			utf8[out++] = static_cast<char> (0x80 | ((codePoint >> 12) & 0x3F));
+			utf8[out++] = static_cast<char> (0x80 | ((codePoint >> 6) & 0x3F));
+			utf8[out++] = static_cast<char> (0x80 | (codePoint & 0x3F));
+		}
+		in += consumed;
+	}
+	numBytes = out;
+	return in == numUnits;
+}
+
 //------------------------------------------------------------------------
 std::u16string convert (const std::string& utf8Str)
 {
-#if defined(USE_WCHAR_AS_UTF16TYPE)
-	auto wstr = converter ().from_bytes (utf8Str);
-	return {wstr.data (), wstr.data () + wstr.size ()};
-#else
-	return converter ().from_bytes (utf8Str);
-#endif
+	// an UTF-8 string never has less bytes than its UTF-16 form has code units
+	std::u16string result (utf8Str.size (), 0);
+	size_t numUnits = 0;
+	utf8ToUtf16 (utf8Str.data (), utf8Str.size (), &result[0], result.size (), numUnits);
+	result.resize (numUnits);
+	return result;
 }
 
 //------------------------------------------------------------------------
 std::string convert (const std::u16string& str)
 {
-	return converter ().to_bytes (reinterpret_cast<const UTF16Type*> (str.data ()),
-	                              reinterpret_cast<const UTF16Type*> (str.data () + str.size ()));
+	// a code unit needs at most three bytes, surrogate pairs need four bytes for two units
+	std::string result (str.size () * 3, 0);
+	size_t numBytes = 0;
+	utf16ToUtf8 (str.data (), str.size (), &result[0], result.size (), numBytes);
+	result.resize (numBytes);
+	return result;
 }
 
 //------------------------------------------------------------------------
@@ -113,9 +256,3 @@ std::string convert (const char* str, uint32_t max)
 //------------------------------------------------------------------------
 } // StringConvert
 } // Steinberg
-
-#ifdef __clang__
-#pragma clang diagnostic pop
-#elif defined(_MSC_VER)
-#pragma warning(pop)
-#endif
@@ -37,6 +37,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -74,6 +75,42 @@ std::string convert (const std::u16string& str);
  */
 std::string convert (const char* str, uint32_t max);
 
+//------------------------------------------------------------------------
+/**
+ *  convert an UTF-8 string buffer to an UTF-16 string buffer without allocating memory
+ *
+ *  invalid UTF-8 sequences are replaced with U+FFFD. If the destination is too small, it contains
+ *  as many complete characters as fit.
+ *
+ *  @param utf8      UTF-8 string buffer
+ *  @param numBytes  number of bytes in utf8
+ *  @param utf16     UTF-16 destination buffer (not zero terminated by this function)
+ *  @param maxUnits  number of code units which fit into utf16
+ *  @param numUnits  on return the number of code units written
+ *
+ *  @return true if the complete string was converted
+ */
+bool utf8ToUtf16 (const char* utf8, size_t numBytes, char16_t* utf16, size_t maxUnits,
+                  size_t& numUnits);
+
+//------------------------------------------------------------------------
+/**
+ *  convert an UTF-16 string buffer to an UTF-8 string buffer without allocating memory
+ *
+ *  unpaired surrogates are replaced with U+FFFD. If the destination is too small, it contains as
+ *  many complete characters as fit.
+ *
+ *  @param utf16     UTF-16 string buffer
+ *  @param numUnits  number of code units in utf16
+ *  @param utf8      UTF-8 destination buffer (not zero terminated by this function)
+ *  @param maxBytes  number of bytes which fit into utf8
+ *  @param numBytes  on return the number of bytes written
+ *
+ *  @return true if the complete string was converted
+ */
+bool utf16ToUtf8 (const char16_t* utf16, size_t numUnits, char* utf8, size_t maxBytes,
+                  size_t& numBytes);
+
 //------------------------------------------------------------------------
 /**
  *	convert a number to an UTF-16 string
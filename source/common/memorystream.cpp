@@ -36,6 +36,7 @@
 
 #include "memorystream.h"
 #include "pluginterfaces/base/futils.h"
+#include <algorithm>
 #include <cstdlib>
 
 namespace Steinberg {
@@ -68,11 +69,24 @@ MemoryStream::MemoryStream ()
 	FUNKNOWN_CTOR
 }
 
+//-----------------------------------------------------------------------------
+MemoryStream::MemoryStream (Allocator* allocator)
+: memory (nullptr)
+, memorySize (0)
+, size (0)
+, cursor (0)
+, ownMemory (true)
+, allocationError (false)
+, allocator (allocator)
+{
+	FUNKNOWN_CTOR
+}
+
 //-----------------------------------------------------------------------------
 MemoryStream::~MemoryStream () 
 { 
 	if (ownMemory && memory)
-		::free (memory);
+		freeMemory ();
 
 	FUNKNOWN_DTOR 
 }
@@ -192,13 +206,57 @@ TSize MemoryStream::getSize () const
 	return size;
 }
 
+//------------------------------------------------------------------------
+void MemoryStream::freeMemory ()
+{
+	if (allocator)
+		allocator->deallocate (memory, memorySize);
+	else
+		::free (memory);
+}
+
+//------------------------------------------------------------------------
+bool MemoryStream::resizeMemory (TSize newMemorySize)
+{
+	char* newMemory = nullptr;
+	if (allocator)
+	{
+		if (memory)
+			newMemory = (char*)allocator->reallocate (memory, memorySize, newMemorySize);
+		else
+			newMemory = (char*)allocator->allocate (newMemorySize);
+	}
+	else if (memory)
+	{
+		newMemory = (char*)realloc (memory, (size_t)newMemorySize);
+		if (newMemory == nullptr && newMemorySize > 0)
+		{
+			newMemory = (char*)malloc ((size_t)newMemorySize);
+			if (newMemory)
+			{
+				memcpy (newMemory, memory, (size_t)Min (newMemorySize, memorySize));
+				free (memory);
+			}
+		}
+	}
+	else
+		newMemory = (char*)malloc ((size_t)newMemorySize);
+
+	if (newMemory == nullptr)
+		return false;
+
+	memory = newMemory;
+	memorySize = newMemorySize;
+	return true;
+}
+
 //------------------------------------------------------------------------
 void MemoryStream::setSize (TSize s)
 {
 	if (s <= 0)
 	{
 		if (ownMemory && memory)
-			free (memory);
+			freeMemory ();
 
 		memory = nullptr;
 		memorySize = 0;
@@ -207,8 +265,7 @@ void MemoryStream::setSize (TSize s)
 		return;
 	}
 
-	TSize newMemorySize = (((Max (memorySize, s) - 1) / kMemGrowAmount) + 1) * kMemGrowAmount;
-	if (newMemorySize == memorySize)
+	if (s <= memorySize)
 	{
 		size = s;
 		return;
@@ -220,41 +277,43 @@ void MemoryStream::setSize (TSize s)
 		return;	
 	}
 
-	ownMemory = true;
-	char* newMemory = nullptr;
+	// grow geometrically to keep the number of reallocations low for big streams
+	TSize newMemorySize = Max (s, memorySize + memorySize / 2);
+	newMemorySize = (((newMemorySize - 1) / kMemGrowAmount) + 1) * kMemGrowAmount;
 
-	if (memory)
+	ownMemory = true;
+	if (resizeMemory (newMemorySize))
 	{
-		newMemory = (char*)realloc (memory, (size_t)newMemorySize);
-		if (newMemory == nullptr && newMemorySize > 0)
-		{
-			newMemory = (char*)malloc ((size_t)newMemorySize);
-			if (newMemory)
-			{
-				memcpy (newMemory, memory, (size_t)Min (newMemorySize, memorySize));           
-				free (memory);
-			}		
-		}
+		size = s;
+		return;
 	}
-	else
-		newMemory = (char*)malloc ((size_t)newMemorySize);
 
-	if (newMemory == nullptr)
-	{
-		if (newMemorySize > 0)
-			allocationError = true;
+	allocationError = true;
+	if (memory)
+		freeMemory ();
+	memory = nullptr;
+	memorySize = 0;
+	size = 0;
+	cursor = 0;
+}
 
-		memory = nullptr;
-		memorySize = 0;
-		size = 0;
-		cursor = 0;
-	}
-	else
-	{
-		memory = newMemory;
-		memorySize = newMemorySize;
-		size = s;
-	}
+//------------------------------------------------------------------------
+bool MemoryStream::reserve (TSize capacity)
+{
+	if (capacity <= memorySize)
+		return true;
+	if (memory && ownMemory == false)
+		return false;
+
+	ownMemory = true;
+	return resizeMemory ((((capacity - 1) / kMemGrowAmount) + 1) * kMemGrowAmount);
+}
+
+//------------------------------------------------------------------------
+void MemoryStream::clear ()
+{
+	size = 0;
+	cursor = 0;
 }
 
 //------------------------------------------------------------------------
@@ -287,24 +346,19 @@ bool MemoryStream::truncate ()
 	if (memorySize == size)
 		return true;
 
-	memorySize = size;
-	
-	if (memorySize == 0)
+	if (size == 0)
 	{
 		if (memory)
 		{
-			free (memory);
+			freeMemory ();
 			memory = nullptr;
 		}
+		memorySize = 0;
 	}
-	else
+	else if (memory)
 	{
-		if (memory)
-		{
-			char* newMemory = (char*)realloc (memory, (size_t)memorySize);
-			if (newMemory)
-				memory = newMemory;
-		}
+		// on failure the bigger block stays in use, memorySize must still describe it
+		resizeMemory (size);
 	}
 	return true;
 }
@@ -316,4 +370,85 @@ bool MemoryStream::truncateToCursor ()
 	return truncate ();
 }
 
+//------------------------------------------------------------------------
+// MemoryStreamPool
+//------------------------------------------------------------------------
+MemoryStreamPool::~MemoryStreamPool () noexcept
+{
+	purge ();
+}
+
+//------------------------------------------------------------------------
+void* MemoryStreamPool::allocate (TSize& size)
+{
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		// take the most recently released block which is big enough, this is the final block of
+		// the last stream, so a stream written again with similar content does not grow at all
+		for (auto it = freeBlocks.rbegin (); it != freeBlocks.rend (); ++it)
+		{
+			if (it->size < size)
+				continue;
+			void* memory = it->memory;
+			size = it->size;
+			freeBlocks.erase (std::next (it).base ());
+			return memory;
+		}
+	}
+	return malloc ((size_t)size);
+}
+
+//------------------------------------------------------------------------
+void* MemoryStreamPool::reallocate (void* memory, TSize oldSize, TSize& newSize)
+{
+	void* newMemory = allocate (newSize);
+	if (newMemory == nullptr)
+		return nullptr;
+	if (memory)
+	{
+		memcpy (newMemory, memory, (size_t)Min (oldSize, newSize));
+		deallocate (memory, oldSize);
+	}
+	return newMemory;
+}
+
+//------------------------------------------------------------------------
+void MemoryStreamPool::deallocate (void* memory, TSize size)
+{
+	if (memory == nullptr)
+		return;
+
+	std::lock_guard<std::mutex> lock (mutex);
+	if (freeBlocks.size () < maxFreeBlocks)
+	{
+		freeBlocks.push_back ({memory, size});
+		return;
+	}
+	if (freeBlocks.empty ())
+	{
+		free (memory);
+		return;
+	}
+	// pool is full, keep the bigger blocks
+	auto smallest = std::min_element (freeBlocks.begin (), freeBlocks.end (),
+	                                  [] (const Block& b1, const Block& b2) { return b1.size < b2.size; });
+	if (smallest->size < size)
+	{
+		free (smallest->memory);
+		freeBlocks.erase (smallest);
+		freeBlocks.push_back ({memory, size});
+		return;
+	}
+	free (memory);
+}
+
+//------------------------------------------------------------------------
+void MemoryStreamPool::purge ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	for (auto& block : freeBlocks)
+		free (block.memory);
+	freeBlocks.clear ();
+}
+
 } // namespace
@@ -38,18 +38,38 @@
 
 #include "pluginterfaces/base/ibstream.h"
 
+#include <mutex>
+#include <vector>
+
 namespace Steinberg {
 
 //------------------------------------------------------------------------
 /** Memory based Stream for IBStream implementation (using malloc).
 \ingroup sdkBase
+
+The memory grows geometrically, use reserve () when the final size is known in advance. The memory
+can be provided by a custom Allocator (for example a MemoryStreamPool) so that repeated state saves
+reuse the same memory blocks instead of allocating new ones.
 */
 class MemoryStream : public IBStream
 {
 public:
+	//------------------------------------------------------------------------
+	/** Allocator used by the stream to get its memory block */
+	struct Allocator
+	{
+		virtual ~Allocator () noexcept = default;
+		/** size may be increased by the allocator if it returns a bigger block */
+		virtual void* allocate (TSize& size) = 0;
+		/** returns the new memory block with the content of the old one, nullptr on failure */
+		virtual void* reallocate (void* memory, TSize oldSize, TSize& newSize) = 0;
+		virtual void deallocate (void* memory, TSize size) = 0;
+	};
+
 	//------------------------------------------------------------------------
 	MemoryStream ();
 	MemoryStream (void* memory, TSize memorySize); 	///< reuse a given memory without getting ownership
+	MemoryStream (Allocator* allocator);	///< use the allocator (must outlive the stream) instead of malloc
 	virtual ~MemoryStream ();
 
 	//---IBStream---------------------------------------
@@ -60,20 +80,59 @@ public:
 
 	TSize getSize () const;		///< returns the current memory size
 	void setSize (TSize size);	///< set the memory size, a realloc will occur if memory already used
+	TSize getCapacity () const { return memorySize; }	///< returns the size of the memory block
+	bool reserve (TSize capacity);	///< make sure the memory block can hold capacity bytes
+	void clear ();			///< set size and cursor to zero but keep the memory block for reuse
 	char* getData () const;		///< returns the memory pointer
-	char* detachData ();	///< returns the memory pointer and give up ownership
+	char* detachData ();	///< returns the memory pointer and give up ownership (free it with the allocator of the stream)
 	bool truncate ();		///< realloc to the current use memory size if needed
 	bool truncateToCursor ();	///< truncate memory at current cursor position
 
 	//------------------------------------------------------------------------
 	DECLARE_FUNKNOWN_METHODS
 protected:
+	bool resizeMemory (TSize newMemorySize);
+	void freeMemory ();
+
 	char* memory;				// memory block
 	TSize memorySize;			// size of the memory block
 	TSize size;					// size of the stream
 	int64 cursor;				// stream pointer
 	bool ownMemory;				// stream has allocated memory itself
 	bool allocationError;       // stream invalid
+	Allocator* allocator {nullptr}; // optional allocator (not owned)
+};
+
+//------------------------------------------------------------------------
+/** Allocator which keeps released memory blocks for reuse.
+\ingroup sdkBase
+
+Share one pool between streams which are created again and again (for example the streams used
+to autosave the plug-in state every few seconds), after the first round no more memory is
+allocated. The pool is thread safe and must outlive all streams using it.
+*/
+class MemoryStreamPool : public MemoryStream::Allocator
+{
+public:
+	MemoryStreamPool (uint32 maxFreeBlocks = 8) : maxFreeBlocks (maxFreeBlocks) {}
+	~MemoryStreamPool () noexcept override;
+
+	void* allocate (TSize& size) SMTG_OVERRIDE;
+	void* reallocate (void* memory, TSize oldSize, TSize& newSize) SMTG_OVERRIDE;
+	void deallocate (void* memory, TSize size) SMTG_OVERRIDE;
+
+	/** free all unused memory blocks */
+	void purge ();
+
+private:
+	struct Block
+	{
+		void* memory;
+		TSize size;
+	};
+	std::mutex mutex;
+	std::vector<Block> freeBlocks;
+	uint32 maxFreeBlocks;
 };
 
 } // namespace
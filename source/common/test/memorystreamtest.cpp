@@ -0,0 +1,245 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Common Classes
+// Filename    : public.sdk/source/common/test/memorystreamtest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test memory stream
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/common/memorystream.h"
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/fstrdefs.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+/** Keeps track of the blocks it handed out, reallocate fails on request */
+struct TestAllocator : MemoryStream::Allocator
+{
+	~TestAllocator () noexcept override
+	{
+		for (auto& block : blocks)
+			free (block.first);
+	}
+	void* allocate (TSize& size) override
+	{
+		++numAllocations;
+		void* memory = malloc ((size_t)size);
+		blocks[memory] = size;
+		return memory;
+	}
+	void* reallocate (void* memory, TSize oldSize, TSize& newSize) override
+	{
+		if (failReallocate)
+			return nullptr;
+		void* newMemory = allocate (newSize);
+		memcpy (newMemory, memory, (size_t)(oldSize < newSize ? oldSize : newSize));
+		deallocate (memory, oldSize);
+		return newMemory;
+	}
+	void deallocate (void* memory, TSize size) override
+	{
+		auto it = blocks.find (memory);
+		if (it == blocks.end () || it->second != size)
+			++numBadDeallocations;
+		else
+			blocks.erase (it);
+		free (memory);
+	}
+
+	std::map<void*, TSize> blocks;
+	int32 numAllocations {0};
+	int32 numBadDeallocations {0};
+	bool failReallocate {false};
+};
+
+//------------------------------------------------------------------------
+std::vector<char> makeTestData (size_t size)
+{
+	std::vector<char> data (size);
+	for (size_t i = 0; i < size; ++i)
+		data[i] = static_cast<char> (i * 7);
+	return data;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer MemoryStreamTests ([] () {
+	constexpr auto TestSuiteName = "MemoryStream";
+	registerTest (TestSuiteName, STR ("Reserve and clear"), [] (ITestResult* testResult) {
+		MemoryStream stream;
+		EXPECT_TRUE (stream.reserve (10000));
+		EXPECT_TRUE (stream.getCapacity () >= 10000);
+		char* data = stream.getData ();
+		auto content = makeTestData (10000);
+		int32 numBytes = 0;
+		EXPECT_EQ (stream.write (content.data (), 10000, &numBytes), kResultTrue);
+		EXPECT_EQ (numBytes, 10000);
+		EXPECT_TRUE (stream.getData () == data);
+
+		stream.clear ();
+		EXPECT_EQ (stream.getSize (), 0);
+		EXPECT_TRUE (stream.getCapacity () >= 10000);
+		EXPECT_EQ (stream.write (content.data (), 5000, &numBytes), kResultTrue);
+		EXPECT_TRUE (stream.getData () == data);
+		EXPECT_EQ (stream.getSize (), 5000);
+		EXPECT_EQ (memcmp (stream.getData (), content.data (), 5000), 0);
+
+		// memory not owned by the stream cannot grow
+		char buffer[16];
+		MemoryStream foreign (buffer, sizeof (buffer));
+		EXPECT_TRUE (foreign.reserve (16));
+		EXPECT_FALSE (foreign.reserve (17));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Geometric growth"), [] (ITestResult* testResult) {
+		TestAllocator allocator;
+		{
+			MemoryStream stream (&allocator);
+			auto content = makeTestData (100);
+			for (int32 i = 0; i < 10000; ++i)
+				stream.write (content.data (), 100, nullptr);
+			EXPECT_EQ (stream.getSize (), 1000000);
+			EXPECT_TRUE (allocator.numAllocations < 20);
+			stream.seek (0, IBStream::kIBSeekSet, nullptr);
+			std::vector<char> readData (100);
+			int32 numBytes = 0;
+			stream.read (readData.data (), 100, &numBytes);
+			EXPECT_EQ (numBytes, 100);
+			EXPECT_TRUE (readData == content);
+		}
+		EXPECT_TRUE (allocator.blocks.empty ());
+		EXPECT_EQ (allocator.numBadDeallocations, 0);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Allocator hooks"), [] (ITestResult* testResult) {
+		TestAllocator allocator;
+		{
+			MemoryStream stream (&allocator);
+			auto content = makeTestData (50000);
+			stream.write (content.data (), 50000, nullptr);
+			EXPECT_EQ (allocator.blocks.size (), 1u);
+			EXPECT_EQ (allocator.blocks.begin ()->second, stream.getCapacity ());
+
+			stream.setSize (100);
+			EXPECT_TRUE (stream.truncate ());
+			EXPECT_EQ (stream.getCapacity (), 100);
+			EXPECT_EQ (allocator.blocks.begin ()->second, 100);
+			EXPECT_EQ (memcmp (stream.getData (), content.data (), 100), 0);
+		}
+		EXPECT_TRUE (allocator.blocks.empty ());
+
+		// a failing truncate keeps the old block and its size
+		{
+			MemoryStream stream (&allocator);
+			auto content = makeTestData (50000);
+			stream.write (content.data (), 50000, nullptr);
+			auto capacity = stream.getCapacity ();
+			allocator.failReallocate = true;
+			stream.setSize (100);
+			EXPECT_TRUE (stream.truncate ());
+			EXPECT_EQ (stream.getCapacity (), capacity);
+			EXPECT_EQ (stream.getSize (), 100);
+		}
+		EXPECT_TRUE (allocator.blocks.empty ());
+		EXPECT_EQ (allocator.numBadDeallocations, 0);
+
+		// detached memory is freed with the allocator of the stream
+		{
+			MemoryStream stream (&allocator);
+			stream.write (makeTestData (10).data (), 10, nullptr);
+			auto capacity = stream.getCapacity ();
+			char* data = stream.detachData ();
+			EXPECT_EQ (stream.getCapacity (), 0);
+			allocator.deallocate (data, capacity);
+		}
+		EXPECT_TRUE (allocator.blocks.empty ());
+		EXPECT_EQ (allocator.numBadDeallocations, 0);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("MemoryStreamPool"), [] (ITestResult* testResult) {
+		MemoryStreamPool pool (2);
+		auto content = makeTestData (100000);
+		char* data = nullptr;
+		{
+			MemoryStream stream (&pool);
+			stream.write (content.data (), 100000, nullptr);
+			data = stream.getData ();
+		}
+		// the next stream of the same size gets the released block, already big enough
+		{
+			MemoryStream stream (&pool);
+			stream.write (content.data (), 100000, nullptr);
+			EXPECT_TRUE (stream.getData () == data);
+			EXPECT_EQ (memcmp (stream.getData (), content.data (), 100000), 0);
+		}
+		{
+			MemoryStream stream (&pool);
+			EXPECT_TRUE (stream.reserve (100000));
+			EXPECT_TRUE (stream.getData () == data);
+		}
+
+		// the pool keeps at most maxFreeBlocks blocks, the biggest ones
+		pool.purge ();
+		TSize sizes[] = {10, 20, 30};
+		void* blocks[3];
+		for (int32 i = 0; i < 3; ++i)
+			blocks[i] = pool.allocate (sizes[i]);
+		for (int32 i = 0; i < 3; ++i)
+			pool.deallocate (blocks[i], sizes[i]);
+		TSize size = 5;
+		EXPECT_TRUE (pool.allocate (size) == blocks[2]);
+		EXPECT_EQ (size, 30);
+		size = 5;
+		EXPECT_TRUE (pool.allocate (size) == blocks[1]);
+		EXPECT_EQ (size, 20);
+		size = 5;
+		void* memory = pool.allocate (size);
+		EXPECT_EQ (size, 5);
+		pool.deallocate (memory, size);
+		pool.deallocate (blocks[1], 20);
+		pool.deallocate (blocks[2], 30);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -531,13 +531,16 @@ int32 AAXWrapper::getParameterInfo (AAX_CParamID aaxId, Vst::ParameterInfo& para
 	if (id == -1)
 		return AAX_ERROR_INVALID_PARAMETER_ID;
 
-	std::map<ParamID, int32>::iterator iter = mParamIndexMap.find (id);
+	auto iter = mParamIndexMap.find (id);
 	if (iter == mParamIndexMap.end ())
 		return AAX_ERROR_INVALID_PARAMETER_ID;
 
-	if (mController->getParameterInfo (iter->second, paramInfo) != kResultTrue)
+	const ParamMetaData* metaData = getParamMetaData (iter->second);
+	if (!metaData)
 		return AAX_ERROR_INVALID_PARAMETER_ID;
 
+	paramInfo = metaData->info;
+
 	return AAX_SUCCESS;
 }
 
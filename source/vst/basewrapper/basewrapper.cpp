@@ -514,18 +514,8 @@ bool BaseWrapper::init ()
 		if (programListCount > 0)
 		{
 			ProgramListID rootUnitProgramListId = kNoProgramListId;
-			for (int32 i = 0; i < mUnitInfo->getUnitCount (); i++)
-			{
-				UnitInfo unit = {};
-				if (mUnitInfo->getUnitInfo (i, unit) == kResultTrue)
-				{
-					if (unit.id == kRootUnitId)
-					{
-						rootUnitProgramListId = unit.programListId;
-						break;
-					}
-				}
-			}
+			if (auto rootUnit = mUnitCache.find (kRootUnitId))
+				rootUnitProgramListId = rootUnit->programListId;
 
 			if (rootUnitProgramListId != kNoProgramListId)
 			{
@@ -664,84 +654,104 @@ float BaseWrapper::_getParameter (int32 index) const
 //------------------------------------------------------------------------
 void BaseWrapper::addParameterChange (ParamID id, ParamValue value, int32 sampleOffset)
 {
-	mGuiTransfer.addChange (id, value, sampleOffset);
+	addGuiChange (id, value, sampleOffset);
 	mInputTransfer.addChange (id, value, sampleOffset);
 }
 
+//------------------------------------------------------------------------
+void BaseWrapper::addGuiChange (ParamID id, ParamValue value, int32 sampleOffset)
+{
+	// publish the value before queuing the change, getLastParamChange must not return an older
+	// value while the change is pending
+	auto lastChange = findLastParamChange (id);
+	if (lastChange)
+		lastChange->value.store (value, std::memory_order_relaxed);
+	if (mGuiTransfer.addChange (id, value, sampleOffset) && lastChange)
+		lastChange->writeSequence.fetch_add (1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------
+BaseWrapper::LastParamChange* BaseWrapper::findLastParamChange (ParamID id)
+{
+	auto iter = mParamIndexMap.find (id);
+	if (iter == mParamIndexMap.end () || iter->second < 0 ||
+	    iter->second >= mNumLastParamChanges)
+		return nullptr;
+	return &mLastParamChanges[iter->second];
+}
+
 //------------------------------------------------------------------------
 /*!	Usually VST 2 hosts call setParameter (...) and getParameterDisplay (...) synchronously.
 In setParameter (...) param changes get queued (guiTransfer) and transfered in idle (::onTimer).
 The ::onTimer call almost always comes AFTER getParameterDisplay (...) and therefore returns an
 old
 value. To avoid sending back old values, getLastParamChange (...) returns the latest value
-from the guiTransfer queue. */
+from the guiTransfer queue. The value is read from mLastParamChanges, which is updated next to
+the queue, so this does not need to drain the queue. */
 //------------------------------------------------------------------------
 bool BaseWrapper::getLastParamChange (ParamID id, ParamValue& value)
 {
-	ParameterChanges changes;
-	mGuiTransfer.transferChangesTo (changes);
-	for (int32 i = 0; i < changes.getParameterCount (); ++i)
-	{
-		IParamValueQueue* queue = changes.getParameterData (i);
-		if (queue)
-		{
-			if (queue->getParameterId () == id)
-			{
-				int32 points = queue->getPointCount ();
-				if (points > 0)
-				{
-					mGuiTransfer.transferChangesFrom (changes);
-					int32 sampleOffset = 0;
-					return queue->getPoint (points - 1, sampleOffset, value) == kResultTrue;
-				}
-			}
-		}
-	}
-
-	mGuiTransfer.transferChangesFrom (changes);
-	return false;
+	auto lastChange = findLastParamChange (id);
+	if (!lastChange)
+		return false;
+	if (lastChange->writeSequence.load (std::memory_order_acquire) ==
+	    lastChange->readSequence.load (std::memory_order_relaxed))
+		return false;
+	value = lastChange->value.load (std::memory_order_relaxed);
+	return true;
 }
 
 //------------------------------------------------------------------------
 void BaseWrapper::getUnitPath (UnitID unitID, String& path) const
 {
-	if (!mUnitInfo)
-		return;
+	//! Prepend the unit path up to the root unit (e.g. "Modulators.LFO 1.". Separator is a ".")
+	if (auto unitPath = mUnitCache.getPath (unitID))
+		path.insertAt (0, String (unitPath->data ()));
+}
 
-	//! Build the unit path up to the root unit (e.g. "Modulators.LFO 1.". Separator is a ".")
-	for (int32 unitIndex = 0; unitIndex < mUnitInfo->getUnitCount (); ++unitIndex)
+//------------------------------------------------------------------------
+void BaseWrapper::updateParamMetaData ()
+{
+	int32 paramCount = mController ? mController->getParameterCount () : 0;
+	mParamMetaData.resize (paramCount);
+	for (int32 i = 0; i < paramCount; i++)
 	{
-		UnitInfo info = {};
-		mUnitInfo->getUnitInfo (unitIndex, info);
-		if (info.id == unitID)
-		{
-			String unitName (info.name);
-			unitName.append (".");
-			path.insertAt (0, unitName);
-			if (info.parentUnitId != kRootUnitId)
-				getUnitPath (info.parentUnitId, path);
-
-			break;
-		}
+		auto& metaData = mParamMetaData[i];
+		metaData.info = {};
+		metaData.valid = mController->getParameterInfo (i, metaData.info) == kResultTrue;
 	}
 }
+
+//------------------------------------------------------------------------
+const BaseWrapper::ParamMetaData* BaseWrapper::getParamMetaData (int32 vst3Index) const
+{
+	if (vst3Index < 0 || vst3Index >= static_cast<int32> (mParamMetaData.size ()))
+		return nullptr;
+	const auto& metaData = mParamMetaData[vst3Index];
+	return metaData.valid ? &metaData : nullptr;
+}
+
 //------------------------------------------------------------------------
 int32 BaseWrapper::_getChunk (void** data, bool /*isPreset*/)
 {
 	// Host stores plug-in state. Returns the size in bytes of the chunk (Plug-in allocates the data
 	// array)
-	MemoryStream componentStream;
+	// the streams keep their memory between calls, repeated saves do not allocate
+	auto& componentStream = mComponentStateStream;
+	componentStream.clear ();
 	if (mComponent && mComponent->getState (&componentStream) != kResultTrue)
-		componentStream.setSize (0);
+		componentStream.clear ();
 
-	MemoryStream controllerStream;
+	auto& controllerStream = mControllerStateStream;
+	controllerStream.clear ();
 	if (mController && mController->getState (&controllerStream) != kResultTrue)
-		controllerStream.setSize (0);
+		controllerStream.clear ();
 
 	if (componentStream.getSize () + controllerStream.getSize () == 0)
 		return 0;
 
-	mChunk.setSize (0);
+	mChunk.clear ();
+	mChunk.reserve (2 * sizeof (int64) + componentStream.getSize () + controllerStream.getSize ());
 	IBStreamer acc (&mChunk, kLittleEndian);
 
 	acc.writeInt64 (componentStream.getSize ());
@@ -764,6 +774,9 @@ int32 BaseWrapper::_setChunk (void* data, int32 byteSize, bool isPreset)
 	// throw away all previously queued parameter changes, they are obsolete
 	mGuiTransfer.removeChanges ();
 	mInputTransfer.removeChanges ();
+	for (int32 i = 0; i < mNumLastParamChanges; ++i)
+		mLastParamChanges[i].readSequence.store (
+		    mLastParamChanges[i].writeSequence.load (std::memory_order_acquire));
 
 	MemoryStream chunk (data, byteSize);
 	IBStreamer acc (&chunk, kLittleEndian);
@@ -823,17 +836,10 @@ bool BaseWrapper::getProgramListAndUnit (int32 midiChannel, UnitID& unitId,
 	// use the first input event bus (VST 2 has only 1 bus for event)
 	if (mUnitInfo->getUnitByBus (kEvent, kInput, 0, midiChannel, unitId) == kResultTrue)
 	{
-		for (int32 i = 0, unitCount = mUnitInfo->getUnitCount (); i < unitCount; i++)
+		if (auto unit = mUnitCache.find (unitId))
 		{
-			UnitInfo unitInfoStruct = {};
-			if (mUnitInfo->getUnitInfo (i, unitInfoStruct) == kResultTrue)
-			{
-				if (unitId == unitInfoStruct.id)
-				{
-					programListId = unitInfoStruct.programListId;
-					return programListId != kNoProgramListId;
-				}
-			}
+			programListId = unit->programListId;
+			return programListId != kNoProgramListId;
 		}
 	}
 
@@ -944,13 +950,18 @@ void BaseWrapper::setupParameters ()
 	std::vector<ParameterInfo> programParameterInfos;
 	std::vector<int32> programParameterIdxs;
 
-	int32 paramCount = mController ? mController->getParameterCount () : 0;
+	mUnitCache.update (mUnitInfo);
+	updateParamMetaData ();
+
+	int32 paramCount = static_cast<int32> (mParamMetaData.size ());
+	mParameterMap.reserve (paramCount);
+	mParamIndexMap.reserve (paramCount);
 	int32 numParamID = 0;
 	for (int32 i = 0; i < paramCount; i++)
 	{
-		ParameterInfo paramInfo = {};
-		if (mController->getParameterInfo (i, paramInfo) == kResultTrue)
+		if (const ParamMetaData* metaData = getParamMetaData (i))
 		{
+			const ParameterInfo& paramInfo = metaData->info;
 			//--- ------------------------------------------
 			if ((paramInfo.flags & ParameterInfo::kIsBypass) != 0)
 			{
@@ -1003,6 +1014,11 @@ void BaseWrapper::setupParameters ()
 	mInputTransfer.setMaxParameters (paramCount);
 	mOutputTransfer.setMaxParameters (paramCount);
 	mGuiTransfer.setMaxParameters (paramCount);
+	if (mNumLastParamChanges != paramCount)
+	{
+		mNumLastParamChanges = paramCount;
+		mLastParamChanges.reset (paramCount > 0 ? new LastParamChange[paramCount] : nullptr);
+	}
 	mInputChanges.setMaxParameters (paramCount);
 	mOutputChanges.setMaxParameters (paramCount);
 
@@ -1174,7 +1190,7 @@ void BaseWrapper::processMidiEvent (Event& toAdd, char* midiData, bool isLive, i
 					if (IParamValueQueue* queue = mInputChanges.addParameterData (paramID, index))
 						queue->addPoint (toAdd.sampleOffset, value, index);
 
-					mGuiTransfer.addChange (paramID, value, toAdd.sampleOffset);
+					addGuiChange (paramID, value, toAdd.sampleOffset);
 				}
 			}
 		}
@@ -1196,7 +1212,7 @@ void BaseWrapper::processMidiEvent (Event& toAdd, char* midiData, bool isLive, i
 					if (IParamValueQueue* queue = mInputChanges.addParameterData (paramID, index))					
 						queue->addPoint (toAdd.sampleOffset, value, index);
 					
-					mGuiTransfer.addChange (paramID, value, toAdd.sampleOffset);
+					addGuiChange (paramID, value, toAdd.sampleOffset);
 				}
 			}
 		}
@@ -1215,7 +1231,7 @@ void BaseWrapper::processMidiEvent (Event& toAdd, char* midiData, bool isLive, i
 					if (IParamValueQueue* queue = mInputChanges.addParameterData (paramID, index))
 						queue->addPoint (toAdd.sampleOffset, value, index);
 
-					mGuiTransfer.addChange (paramID, value, toAdd.sampleOffset);
+					addGuiChange (paramID, value, toAdd.sampleOffset);
 				}
 			}
 		}
@@ -1379,6 +1395,8 @@ void BaseWrapper::onTimer (Timer*)
 	}
 	while (mGuiTransfer.getNextChange (id, value, sampleOffset))
 	{
+		if (auto lastChange = findLastParamChange (id))
+			lastChange->readSequence.fetch_add (1, std::memory_order_relaxed);
 		mController->setParamNormalized (id, value);
 	}
 }
@@ -1412,9 +1430,16 @@ tresult PLUGIN_API BaseWrapper::restartComponent (int32 flags)
 		result = kResultTrue;
 	}
 
+	//--- ----------------------
+	// units are renamed or restructured together with the parameter or bus titles
+	if (flags & (kParamTitlesChanged | kIoChanged | kIoTitlesChanged))
+		mUnitCache.update (mUnitInfo);
+
 	//--- ----------------------
 	if ((flags & kParamValuesChanged) || (flags & kParamTitlesChanged))
 	{
+		if (flags & kParamTitlesChanged)
+			updateParamMetaData ();
 		_updateDisplay ();
 		result = kResultTrue;
 	}
@@ -51,11 +51,15 @@
 #include "public.sdk/source/vst/hosting/parameterchanges.h"
 #include "public.sdk/source/vst/hosting/pluginterfacesupport.h"
 #include "public.sdk/source/vst/hosting/processdata.h"
+#include "public.sdk/source/vst/utility/unitinfocache.h"
 
 #include "base/source/fstring.h"
 #include "base/source/timer.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 //------------------------------------------------------------------------
@@ -199,12 +203,24 @@ protected:
 	void initMidiCtrlerAssignment ();
 	void getUnitPath (UnitID unitID, String& path) const;
 
+	/** Parameter metadata, queried once in setupParameters and again when the controller
+	 *  restarts with kParamTitlesChanged. */
+	struct ParamMetaData
+	{
+		ParameterInfo info;
+		bool valid {false};
+	};
+	/** Returns the metadata of the parameter with the controller index vst3Index or nullptr. */
+	const ParamMetaData* getParamMetaData (int32 vst3Index) const;
+	void updateParamMetaData ();
+
 	uint32 countMainBusChannels (BusDirection dir, uint64& mainBusBitset);
 
 	/**	Returns the last param change from guiTransfer queue. */
 	bool getLastParamChange (ParamID id, ParamValue& value);
 
 	void addParameterChange (ParamID id, ParamValue value, int32 sampleOffset);
+	void addGuiChange (ParamID id, ParamValue value, int32 sampleOffset);
 
 	void setVendorName (char* name);
 	void setEffectName (char* name);
@@ -249,7 +265,9 @@ protected:
 	};
 
 	std::vector<ParamMapEntry> mParameterMap;
-	std::map<ParamID, int32> mParamIndexMap;
+	std::unordered_map<ParamID, int32> mParamIndexMap;
+	std::vector<ParamMetaData> mParamMetaData; // indexed by the controller parameter index
+	UnitInfoCache mUnitCache;
 	ParamID mBypassParameterID = kNoParamId;
 	ParamID mProgramParameterID = kNoParamId;
 	int32 mProgramParameterIdx = -1;
@@ -268,7 +286,22 @@ protected:
 	ParameterChangeTransfer mOutputTransfer;
 	ParameterChangeTransfer mGuiTransfer;
 
+	/** Latest value queued in mGuiTransfer for a parameter, indexed through mParamIndexMap. The
+	 *  value is pending while writeSequence (changes added) differs from readSequence (changes
+	 *  taken out in onTimer). */
+	struct LastParamChange
+	{
+		std::atomic<ParamValue> value {0.};
+		std::atomic<uint32> writeSequence {0};
+		std::atomic<uint32> readSequence {0};
+	};
+	std::unique_ptr<LastParamChange[]> mLastParamChanges;
+	int32 mNumLastParamChanges {0};
+	LastParamChange* findLastParamChange (ParamID id);
+
 	MemoryStream mChunk;
+	MemoryStream mComponentStateStream;
+	MemoryStream mControllerStateStream;
 
 	IPtr<Timer> mTimer;
 	IPtr<IPluginFactory> mFactory;
@@ -35,10 +35,215 @@
 //-----------------------------------------------------------------------------
 
 #include "connectionproxy.h"
+#include "hostclasses.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
 
 namespace Steinberg {
 namespace Vst {
 
+//------------------------------------------------------------------------
+/** Bounded multi-producer queue, the UI thread is the only consumer.
+
+HostMessages are copied into pre-allocated slot messages, so the senders neither lock nor allocate
+once a slot has held a message of the same size. */
+struct ConnectionProxy::MessageQueue
+{
+	struct Slot
+	{
+		IPtr<HostMessage> message;
+		std::atomic<bool> inUse {false};
+	};
+
+	struct Entry
+	{
+		IMessage* message {nullptr};
+		Slot* slot {nullptr}; // nullptr if the message is queued by reference
+	};
+
+	explicit MessageQueue (uint32 minCapacity)
+	{
+		while (capacity < minCapacity)
+			capacity <<= 1;
+		cells.reset (new Cell[capacity]);
+		for (uint32 i = 0; i < capacity; ++i)
+			cells[i].sequence.store (i, std::memory_order_relaxed);
+		slots.reset (new Slot[capacity]);
+		for (uint32 i = 0; i < capacity; ++i)
+			slots[i].message = makeSlotMessage ();
+		batch.reserve (capacity);
+	}
+
+	~MessageQueue () noexcept
+	{
+		Entry entry;
+		while (pop (entry))
+		{
+			if (!entry.slot)
+				entry.message->release ();
+		}
+	}
+
+	static IPtr<HostMessage> makeSlotMessage ()
+	{
+		auto message = owned (new HostMessage);
+		message->getAttributes ();
+		return message;
+	}
+
+	/** called by the senders, returns a free slot or nullptr if all slots are in use */
+	Slot* acquireSlot ()
+	{
+		auto start = nextSlot.fetch_add (1, std::memory_order_relaxed);
+		for (uint32 i = 0; i < capacity; ++i)
+		{
+			auto& slot = slots[(start + i) & (capacity - 1)];
+			bool inUse = false;
+			if (!slot.inUse.load (std::memory_order_relaxed) &&
+			    slot.inUse.compare_exchange_strong (inUse, true, std::memory_order_acquire))
+				return &slot;
+		}
+		return nullptr;
+	}
+
+	/** called by the senders, queues a copy of a HostMessage or a reference to other messages */
+	bool enqueue (IMessage* message)
+	{
+		Entry entry {message, nullptr};
+		if (dynamic_cast<HostMessage*> (message))
+		{
+			entry.slot = acquireSlot ();
+			if (!entry.slot)
+				return false;
+			entry.slot->message->assign (message);
+			entry.message = entry.slot->message;
+		}
+		else
+			message->addRef ();
+		if (push (entry))
+			return true;
+		if (entry.slot)
+			entry.slot->inUse.store (false, std::memory_order_release);
+		else
+			message->release ();
+		return false;
+	}
+
+	/** called on the UI thread when a dequeued message is done */
+	void release (Entry& entry)
+	{
+		if (!entry.slot)
+		{
+			entry.message->release ();
+			return;
+		}
+		// the receiver may keep the message, the slot gets a new one then
+		if (!entry.slot->message->resetForReuse ())
+			entry.slot->message = makeSlotMessage ();
+		entry.slot->inUse.store (false, std::memory_order_release);
+	}
+
+	bool push (const Entry& entry)
+	{
+		Cell* cell = nullptr;
+		auto pos = enqueuePos.load (std::memory_order_relaxed);
+		while (true)
+		{
+			cell = &cells[pos & (capacity - 1)];
+			auto sequence = cell->sequence.load (std::memory_order_acquire);
+			auto diff = static_cast<intptr_t> (sequence) - static_cast<intptr_t> (pos);
+			if (diff == 0)
+			{
+				if (enqueuePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				return false; // full
+			else
+				pos = enqueuePos.load (std::memory_order_relaxed);
+		}
+		cell->entry = entry;
+		cell->sequence.store (pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop (Entry& entry)
+	{
+		auto pos = dequeuePos.load (std::memory_order_relaxed);
+		auto& cell = cells[pos & (capacity - 1)];
+		auto sequence = cell.sequence.load (std::memory_order_acquire);
+		if (static_cast<intptr_t> (sequence) - static_cast<intptr_t> (pos + 1) < 0)
+			return false; // empty
+		entry = cell.entry;
+		cell.sequence.store (pos + capacity, std::memory_order_release);
+		dequeuePos.store (pos + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	uint32 size () const
+	{
+		return static_cast<uint32> (enqueuePos.load (std::memory_order_relaxed) -
+		                            dequeuePos.load (std::memory_order_relaxed));
+	}
+
+	bool isCoalesced (const char* messageID) const
+	{
+		return messageID && std::any_of (coalescedIDs.begin (), coalescedIDs.end (),
+		                                 [&] (const auto& id) { return id == messageID; });
+	}
+
+	/** replaces all but the latest message of each coalesced ID in the batch with nullptr */
+	void coalesceBatch ()
+	{
+		seenIDs.clear ();
+		for (auto it = batch.rbegin (); it != batch.rend (); ++it)
+		{
+			auto messageID = it->message->getMessageID ();
+			if (!isCoalesced (messageID))
+				continue;
+			if (std::none_of (seenIDs.begin (), seenIDs.end (),
+			                  [&] (const char* id) { return strcmp (id, messageID) == 0; }))
+			{
+				seenIDs.push_back (messageID);
+				continue;
+			}
+			release (*it);
+			it->message = nullptr;
+			++numCoalesced;
+		}
+	}
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence {0};
+		Entry entry;
+	};
+
+	uint32 capacity {1};
+	std::unique_ptr<Cell[]> cells;
+	std::unique_ptr<Slot[]> slots;
+	alignas (64) std::atomic<uint32> nextSlot {0};
+	alignas (64) std::atomic<size_t> enqueuePos {0};
+	alignas (64) std::atomic<size_t> dequeuePos {0};
+
+	std::atomic<uint64> numQueued {0};
+	std::atomic<uint64> numRejected {0};
+	std::atomic<uint32> highWaterMark {0};
+
+	// only used on the UI thread
+	uint64 numDelivered {0};
+	uint64 numCoalesced {0};
+	bool draining {false};
+	std::vector<Entry> batch;
+	std::vector<const char*> seenIDs;
+	std::vector<std::string> coalescedIDs;
+};
+
 //------------------------------------------------------------------------
 IMPLEMENT_FUNKNOWN_METHODS (ConnectionProxy, IConnectionPoint, IConnectionPoint::iid)
 
@@ -94,7 +299,30 @@ tresult PLUGIN_API ConnectionProxy::notify (IMessage* message)
 	{
 		// We discard the message if we are not in the UI main thread
 		if (threadChecker && threadChecker->test ())
+		{
+			// deliver the queued messages first to keep the order
+			if (queue && !queue->draining)
+				drainQueue (std::numeric_limits<uint32>::max ());
 			return dstConnection->notify (message);
+		}
+		// ...unless the queued mode is enabled
+		if (queue && message)
+		{
+			// queue a copy, the sender may change or reuse the message after notify returns
+			if (!queue->enqueue (message))
+			{
+				++queue->numRejected;
+				return kOutOfMemory;
+			}
+			++queue->numQueued;
+			auto size = queue->size ();
+			auto highWaterMark = queue->highWaterMark.load (std::memory_order_relaxed);
+			while (size > highWaterMark &&
+			       !queue->highWaterMark.compare_exchange_weak (highWaterMark, size))
+			{
+			}
+			return kResultTrue;
+		}
 	}
 	return kResultFalse;
 }
@@ -105,6 +333,83 @@ bool ConnectionProxy::disconnect ()
 	return disconnect (dstConnection) == kResultTrue;
 }
 
+//------------------------------------------------------------------------
+bool ConnectionProxy::setQueued (bool state, uint32 capacity)
+{
+	// the pending messages can only be delivered on the UI thread
+	if (!threadChecker || !threadChecker->test ())
+		return false;
+
+	std::vector<std::string> coalescedIDs;
+	if (queue)
+	{
+		drainQueue (std::numeric_limits<uint32>::max ());
+		coalescedIDs = std::move (queue->coalescedIDs);
+		queue.reset ();
+	}
+	if (state)
+	{
+		queue = std::make_unique<MessageQueue> (std::max<uint32> (capacity, 1));
+		queue->coalescedIDs = std::move (coalescedIDs);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+void ConnectionProxy::addCoalescedMessageID (const char* messageID)
+{
+	if (queue && messageID && !queue->isCoalesced (messageID))
+		queue->coalescedIDs.emplace_back (messageID);
+}
+
+//------------------------------------------------------------------------
+uint32 ConnectionProxy::drainQueue (uint32 maxMessages)
+{
+	if (!queue || queue->draining || !threadChecker || !threadChecker->test ())
+		return 0;
+
+	queue->draining = true;
+	auto& batch = queue->batch;
+	maxMessages = std::min (maxMessages, queue->capacity);
+	MessageQueue::Entry entry;
+	while (batch.size () < maxMessages && queue->pop (entry))
+		batch.push_back (entry);
+	if (!queue->coalescedIDs.empty ())
+		queue->coalesceBatch ();
+
+	uint32 numDelivered = 0;
+	for (auto& entry : batch)
+	{
+		if (!entry.message)
+			continue;
+		if (dstConnection)
+		{
+			dstConnection->notify (entry.message);
+			++numDelivered;
+		}
+		queue->release (entry);
+	}
+	batch.clear ();
+	queue->numDelivered += numDelivered;
+	queue->draining = false;
+	return numDelivered;
+}
+
+//------------------------------------------------------------------------
+ConnectionProxy::QueueStatistics ConnectionProxy::getQueueStatistics () const
+{
+	QueueStatistics statistics;
+	if (queue)
+	{
+		statistics.numQueued = queue->numQueued;
+		statistics.numDelivered = queue->numDelivered;
+		statistics.numCoalesced = queue->numCoalesced;
+		statistics.numRejected = queue->numRejected;
+		statistics.highWaterMark = queue->highWaterMark;
+	}
+	return statistics;
+}
+
 //------------------------------------------------------------------------
 } // Vst
 } // Steinberg
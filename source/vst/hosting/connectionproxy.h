@@ -38,12 +38,23 @@
 
 #include "pluginterfaces/vst/ivstmessage.h"
 #include "public.sdk/source/common/threadchecker.h"
+#include <memory>
 
 namespace Steinberg {
 namespace Vst {
 
 //------------------------------------------------------------------------
 /** Helper for creating and initializing component.
+
+By default messages are only forwarded when notify is called on the UI thread, messages from other
+threads are discarded. In queued mode (setQueued) copies of these messages are put into a lock-free
+queue. The copies are made into messages which are allocated by setQueued, so the sending thread
+neither locks nor allocates. Messages which are not HostMessages cannot be copied, they are queued
+by reference.
+
+Only the UI thread empties the queue: the host has to call drainQueue regularly on it (for example
+from its idle timer), a notify on the UI thread delivers the pending messages, too. Messages from
+other threads are rejected while the queue is full.
 \ingroup Helper */
 //------------------------------------------------------------------------
 class ConnectionProxy : public IConnectionPoint
@@ -59,13 +70,38 @@ public:
 
 	bool disconnect ();
 
+	//--- queued mode (call these on the UI thread)
+	struct QueueStatistics
+	{
+		uint64 numQueued {0};		///< messages accepted from other threads
+		uint64 numDelivered {0};	///< queued messages delivered to the destination
+		uint64 numCoalesced {0};	///< queued messages replaced by a newer one with the same ID
+		uint64 numRejected {0};		///< messages rejected because the queue was full
+		uint32 highWaterMark {0};	///< maximum number of messages waiting in the queue
+	};
+
+	/** Enables the queued mode with room for capacity messages (rounded up to a power of two).
+	 *	Disabling it delivers the pending messages. Change the mode only while no other thread
+	 *	sends messages. Returns false (and changes nothing) when not called on the UI thread. */
+	bool setQueued (bool state, uint32 capacity = 1024);
+	bool isQueued () const { return queue != nullptr; }
+	/** Queued messages with this ID are coalesced, only the latest of a batch is delivered. */
+	void addCoalescedMessageID (const char* messageID);
+	/** Delivers up to maxMessages queued messages, returns the number of delivered messages.
+	 *	Does nothing when not called on the UI thread. */
+	uint32 drainQueue (uint32 maxMessages = 256);
+	QueueStatistics getQueueStatistics () const;
+
 //------------------------------------------------------------------------
 	DECLARE_FUNKNOWN_METHODS
 protected:
+	struct MessageQueue;
+
 	std::unique_ptr<ThreadChecker> threadChecker {ThreadChecker::create ()};
 
 	IPtr<IConnectionPoint> srcConnection;
 	IPtr<IConnectionPoint> dstConnection;
+	std::unique_ptr<MessageQueue> queue;
 };
 }
 } // namespaces
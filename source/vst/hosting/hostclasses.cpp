@@ -38,16 +38,73 @@
 #include "public.sdk/source/vst/utility/stringconvert.h"
 
 #include <algorithm>
+#include <cstring>
+#include <mutex>
 
 namespace Steinberg {
 namespace Vst {
 
+//-----------------------------------------------------------------------------
+/** Keeps released HostMessages for reuse. */
+class HostMessagePool : public std::enable_shared_from_this<HostMessagePool>
+{
+public:
+	static constexpr size_t kMaxFreeMessages = 64;
+
+	HostMessagePool () { freeMessages.reserve (kMaxFreeMessages); }
+	~HostMessagePool () noexcept
+	{
+		for (auto message : freeMessages)
+			delete message;
+	}
+
+	HostMessage* allocate ()
+	{
+		HostMessage* message = nullptr;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			if (!freeMessages.empty ())
+			{
+				message = freeMessages.back ();
+				freeMessages.pop_back ();
+			}
+		}
+		if (!message)
+			message = new HostMessage;
+		message->pool = shared_from_this ();
+		return message;
+	}
+
+	/** called when the reference count of the message dropped to zero */
+	static void recycle (HostMessage* message)
+	{
+		// the pool may be deleted when this reference is gone
+		auto self = std::move (message->pool);
+		message->reset ();
+		message->__funknownRefCount = 1;
+		{
+			std::lock_guard<std::mutex> guard (self->mutex);
+			if (self->freeMessages.size () < kMaxFreeMessages)
+			{
+				self->freeMessages.push_back (message);
+				message = nullptr;
+			}
+		}
+		delete message;
+	}
+
+private:
+	std::mutex mutex;
+	std::vector<HostMessage*> freeMessages;
+};
+
 //-----------------------------------------------------------------------------
 HostApplication::HostApplication ()
 {
 	FUNKNOWN_CTOR
 
 	mPlugInterfaceSupport = owned (new PlugInterfaceSupport);
+	mMessagePool = std::make_shared<HostMessagePool> ();
 }
 
 //-----------------------------------------------------------------------------
@@ -62,7 +119,7 @@ tresult PLUGIN_API HostApplication::createInstance (TUID cid, TUID _iid, void**
 	if (FUnknownPrivate::iidEqual (cid, IMessage::iid) &&
 	    FUnknownPrivate::iidEqual (_iid, IMessage::iid))
 	{
-		*obj = new HostMessage;
+		*obj = mMessagePool->allocate ();
 		return kResultTrue;
 	}
 	if (FUnknownPrivate::iidEqual (cid, IAttributeList::iid) &&
@@ -107,45 +164,115 @@ uint32 PLUGIN_API HostApplication::release ()
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-IMPLEMENT_FUNKNOWN_METHODS (HostMessage, IMessage, IMessage::iid)
+IMPLEMENT_QUERYINTERFACE (HostMessage, IMessage, IMessage::iid)
+
 //-----------------------------------------------------------------------------
-HostMessage::HostMessage () {FUNKNOWN_CTOR}
+uint32 PLUGIN_API HostMessage::addRef ()
+{
+	return FUnknownPrivate::atomicAdd (__funknownRefCount, 1);
+}
 
 //-----------------------------------------------------------------------------
-HostMessage::~HostMessage () noexcept
+uint32 PLUGIN_API HostMessage::release ()
 {
-	setMessageID (nullptr);
-	FUNKNOWN_DTOR
+	auto refCount = FUnknownPrivate::atomicAdd (__funknownRefCount, -1);
+	if (refCount == 0)
+	{
+		if (pool)
+			HostMessagePool::recycle (this);
+		else
+			delete this;
+	}
+	return refCount;
 }
 
+//-----------------------------------------------------------------------------
+HostMessage::HostMessage () {FUNKNOWN_CTOR}
+
+//-----------------------------------------------------------------------------
+HostMessage::~HostMessage () noexcept {FUNKNOWN_DTOR}
+
 //-----------------------------------------------------------------------------
 const char* PLUGIN_API HostMessage::getMessageID ()
 {
-	return messageId;
+	return hasMessageId ? messageId.data () : nullptr;
 }
 
 //-----------------------------------------------------------------------------
 void PLUGIN_API HostMessage::setMessageID (const char* mid)
 {
-	if (messageId)
-		delete[] messageId;
-	messageId = nullptr;
+	hasMessageId = mid != nullptr;
+	// assign keeps the capacity, so recycled messages do not allocate
 	if (mid)
-	{
-		size_t len = strlen (mid) + 1;
-		messageId = new char[len];
-		strcpy (messageId, mid);
-	}
+		messageId.assign (mid);
+	else
+		messageId.clear ();
 }
 
 //-----------------------------------------------------------------------------
 IAttributeList* PLUGIN_API HostMessage::getAttributes ()
 {
 	if (!attributeList)
-		attributeList = HostAttributeList::make ();
+		attributeList = owned (new HostAttributeList);
 	return attributeList;
 }
 
+//-----------------------------------------------------------------------------
+IPtr<IMessage> HostMessage::copy (IMessage* message)
+{
+	auto source = dynamic_cast<HostMessage*> (message);
+	if (!source)
+		return nullptr;
+
+	IPtr<HostMessage> result = owned (source->pool ? source->pool->allocate () : new HostMessage);
+	result->assign (source);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+bool HostMessage::assign (IMessage* message)
+{
+	auto source = dynamic_cast<HostMessage*> (message);
+	if (!source)
+		return false;
+
+	setMessageID (source->getMessageID ());
+	if (source->attributeList)
+	{
+		getAttributes ();
+		attributeList->assign (*source->attributeList);
+	}
+	else if (attributeList)
+		attributeList->clear ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool HostMessage::resetForReuse ()
+{
+	// adding zero is an atomic read, the count cannot rise again once only the owner holds it
+	if (FUnknownPrivate::atomicAdd (__funknownRefCount, 0) != 1)
+		return false;
+	reset ();
+	// a shared attribute list was dropped by reset, the next user gets a new one
+	getAttributes ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void HostMessage::reset ()
+{
+	setMessageID (nullptr);
+	if (attributeList)
+	{
+		// only reuse the attribute list if the plug-in does not hold a reference to it
+		if (attributeList->isShared ())
+			attributeList = nullptr;
+		else
+			attributeList->clear ();
+	}
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -159,65 +286,60 @@ struct HostAttributeList::Attribute
 		kString,
 		kBinary
 	};
-	Attribute () = default;
+	/** strings and binary data up to this size are stored without allocation */
+	static constexpr uint32 kInlineSize = 64;
 
-	Attribute (int64 value) : type (Type::kInteger) { v.intValue = value; }
-	Attribute (double value) : type (Type::kFloat) { v.floatValue = value; }
-	/* size is in code unit (count of TChar) */
-	Attribute (const TChar* value, uint32 sizeInCodeUnit)
-	: size (sizeInCodeUnit), type (Type::kString)
+	void set (int64 value)
 	{
-		v.stringValue = new TChar[sizeInCodeUnit];
-		memcpy (v.stringValue, value, sizeInCodeUnit * sizeof (TChar));
+		type = Type::kInteger;
+		v.intValue = value;
 	}
-	Attribute (const void* value, uint32 sizeInBytes) : size (sizeInBytes), type (Type::kBinary)
+	void set (double value)
 	{
-		v.binaryValue = new char[sizeInBytes];
-		memcpy (v.binaryValue, value, sizeInBytes);
+		type = Type::kFloat;
+		v.floatValue = value;
 	}
-	Attribute (Attribute&& o) SMTG_NOEXCEPT { *this = std::move (o); }
-	Attribute& operator= (Attribute&& o) SMTG_NOEXCEPT
+	void set (Type dataType, const void* value, uint32 sizeInBytes)
 	{
-		v = o.v;
-		size = o.size;
-		type = o.type;
-		o.size = 0;
-		o.type = Type::kUninitialized;
-		o.v = {};
-		return *this;
-	}
-	~Attribute () noexcept
-	{
-		if (size)
-			delete[] v.binaryValue;
+		void* dst = inlineData;
+		if (sizeInBytes > kInlineSize)
+		{
+			// keep the larger buffer of a previous value
+			if (heapSize < sizeInBytes)
+			{
+				heapData.reset (new char[sizeInBytes]);
+				heapSize = sizeInBytes;
+			}
+			dst = heapData.get ();
+		}
+		if (sizeInBytes)
+			memcpy (dst, value, sizeInBytes);
+		type = dataType;
+		size = sizeInBytes;
 	}
 
 	int64 intValue () const { return v.intValue; }
 	double floatValue () const { return v.floatValue; }
-	/* sizeInCodeUnit is in code unit (count of TChar) */
-	const TChar* stringValue (uint32& sizeInCodeUnit)
-	{
-		sizeInCodeUnit = size;
-		return v.stringValue;
-	}
-	const void* binaryValue (uint32& sizeInBytes)
+	/* sizeInBytes of string and binary values */
+	const void* data (uint32& sizeInBytes) const
 	{
 		sizeInBytes = size;
-		return v.binaryValue;
+		return size > kInlineSize ? heapData.get () : inlineData;
 	}
 
-	Type getType () const { return type; }
+	std::string id;
+	Type type {Type::kUninitialized};
 
 private:
 	union v
 	{
 		int64 intValue;
 		double floatValue;
-		TChar* stringValue;
-		char* binaryValue;
 	} v {};
 	uint32 size {0};
-	Type type {Type::kUninitialized};
+	uint32 heapSize {0};
+	std::unique_ptr<char[]> heapData;
+	alignas (8) char inlineData[kInlineSize];
 };
 
 //-----------------------------------------------------------------------------
@@ -232,17 +354,83 @@ IPtr<IAttributeList> HostAttributeList::make ()
 }
 
 //-----------------------------------------------------------------------------
-HostAttributeList::HostAttributeList () {FUNKNOWN_CTOR}
+HostAttributeList::HostAttributeList ()
+{
+	FUNKNOWN_CTOR
+}
 
 //-----------------------------------------------------------------------------
 HostAttributeList::~HostAttributeList () noexcept {FUNKNOWN_DTOR}
 
+//-----------------------------------------------------------------------------
+bool HostAttributeList::isShared ()
+{
+	// adding zero is an atomic read, the count cannot rise again once only the message holds it
+	return FUnknownPrivate::atomicAdd (__funknownRefCount, 0) != 1;
+}
+
+//-----------------------------------------------------------------------------
+void HostAttributeList::assign (const HostAttributeList& other)
+{
+	clear ();
+	for (const auto& attr : other.list)
+	{
+		uint32 size = 0;
+		switch (attr.type)
+		{
+			case Attribute::Type::kUninitialized: break;
+			case Attribute::Type::kInteger: findOrAdd (attr.id.data ()).set (attr.intValue ()); break;
+			case Attribute::Type::kFloat: findOrAdd (attr.id.data ()).set (attr.floatValue ()); break;
+			case Attribute::Type::kString:
+			case Attribute::Type::kBinary:
+			{
+				auto data = attr.data (size);
+				findOrAdd (attr.id.data ()).set (attr.type, data, size);
+				break;
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void HostAttributeList::clear ()
+{
+	// the identifiers are kept, a recycled message usually sets the same attributes again
+	static constexpr size_t kMaxKeptAttributes = 32;
+	if (list.size () > kMaxKeptAttributes)
+		list.clear ();
+	for (auto& attr : list)
+		attr.type = Attribute::Type::kUninitialized;
+}
+
+//-----------------------------------------------------------------------------
+HostAttributeList::Attribute* HostAttributeList::find (AttrID aid)
+{
+	for (auto& attr : list)
+	{
+		if (attr.id == aid)
+			return &attr;
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+HostAttributeList::Attribute& HostAttributeList::findOrAdd (AttrID aid)
+{
+	if (auto attr = find (aid))
+		return *attr;
+	// a deque never moves its elements when growing at the end
+	list.emplace_back ();
+	list.back ().id = aid;
+	return list.back ();
+}
+
 //-----------------------------------------------------------------------------
 tresult PLUGIN_API HostAttributeList::setInt (AttrID aid, int64 value)
 {
 	if (!aid)
 		return kInvalidArgument;
-	list[aid] = Attribute (value);
+	findOrAdd (aid).set (value);
 	return kResultTrue;
 }
 
@@ -251,10 +439,10 @@ tresult PLUGIN_API HostAttributeList::getInt (AttrID aid, int64& value)
 {
 	if (!aid)
 		return kInvalidArgument;
-	auto it = list.find (aid);
-	if (it != list.end () && it->second.getType () == Attribute::Type::kInteger)
+	auto attr = find (aid);
+	if (attr && attr->type == Attribute::Type::kInteger)
 	{
-		value = it->second.intValue ();
+		value = attr->intValue ();
 		return kResultTrue;
 	}
 	return kResultFalse;
@@ -265,7 +453,7 @@ tresult PLUGIN_API HostAttributeList::setFloat (AttrID aid, double value)
 {
 	if (!aid)
 		return kInvalidArgument;
-	list[aid] = Attribute (value);
+	findOrAdd (aid).set (value);
 	return kResultTrue;
 }
 
@@ -274,10 +462,10 @@ tresult PLUGIN_API HostAttributeList::getFloat (AttrID aid, double& value)
 {
 	if (!aid)
 		return kInvalidArgument;
-	auto it = list.find (aid);
-	if (it != list.end () && it->second.getType () == Attribute::Type::kFloat)
+	auto attr = find (aid);
+	if (attr && attr->type == Attribute::Type::kFloat)
 	{
-		value = it->second.floatValue ();
+		value = attr->floatValue ();
 		return kResultTrue;
 	}
 	return kResultFalse;
@@ -290,7 +478,8 @@ tresult PLUGIN_API HostAttributeList::setString (AttrID aid, const TChar* string
 		return kInvalidArgument;
 	// + 1 for the null-terminate
 	auto length = tstrlen (string) + 1;
-	list[aid] = Attribute (string, length);
+	findOrAdd (aid).set (Attribute::Type::kString, string,
+	                     static_cast<uint32> (length * sizeof (TChar)));
 	return kResultTrue;
 }
 
@@ -299,12 +488,12 @@ tresult PLUGIN_API HostAttributeList::getString (AttrID aid, TChar* string, uint
 {
 	if (!aid)
 		return kInvalidArgument;
-	auto it = list.find (aid);
-	if (it != list.end () && it->second.getType () == Attribute::Type::kString)
+	auto attr = find (aid);
+	if (attr && attr->type == Attribute::Type::kString)
 	{
-		uint32 sizeInCodeUnit = 0;
-		const TChar* _string = it->second.stringValue (sizeInCodeUnit);
-		memcpy (string, _string, std::min<uint32> (sizeInCodeUnit * sizeof (TChar), sizeInBytes));
+		uint32 size = 0;
+		const void* _string = attr->data (size);
+		memcpy (string, _string, std::min<uint32> (size, sizeInBytes));
 		return kResultTrue;
 	}
 	return kResultFalse;
@@ -315,7 +504,7 @@ tresult PLUGIN_API HostAttributeList::setBinary (AttrID aid, const void* data, u
 {
 	if (!aid)
 		return kInvalidArgument;
-	list[aid] = Attribute (data, sizeInBytes);
+	findOrAdd (aid).set (Attribute::Type::kBinary, data, sizeInBytes);
 	return kResultTrue;
 }
 
@@ -324,10 +513,10 @@ tresult PLUGIN_API HostAttributeList::getBinary (AttrID aid, const void*& data,
 {
 	if (!aid)
 		return kInvalidArgument;
-	auto it = list.find (aid);
-	if (it != list.end () && it->second.getType () == Attribute::Type::kBinary)
+	auto attr = find (aid);
+	if (attr && attr->type == Attribute::Type::kBinary)
 	{
-		data = it->second.binaryValue (sizeInBytes);
+		data = attr->data (sizeInBytes);
 		return kResultTrue;
 	}
 	sizeInBytes = 0;
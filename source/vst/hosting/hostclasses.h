@@ -38,15 +38,20 @@
 
 #include "public.sdk/source/vst/hosting/pluginterfacesupport.h"
 #include "pluginterfaces/vst/ivsthostapplication.h"
-#include <map>
+#include <deque>
 #include <memory>
 #include <string>
 
 namespace Steinberg {
 namespace Vst {
 
+class HostMessagePool;
+
 //------------------------------------------------------------------------
 /** Implementation's example of IHostApplication.
+
+Messages created via createInstance are recycled when the plug-in releases them.
+
 \ingroup hostingBase
 */
 class HostApplication : public IHostApplication
@@ -65,10 +70,15 @@ public:
 
 private:
 	IPtr<PlugInterfaceSupport> mPlugInterfaceSupport;
+	std::shared_ptr<HostMessagePool> mMessagePool;
 };
 
 //------------------------------------------------------------------------
 /** Example, ready to use implementation of IAttributeList.
+
+The attributes are kept in a flat list, small strings and binary data are stored inline. Adding
+attributes does not move the existing ones, the data returned by getBinary stays valid until the
+attribute is set again or the list is cleared.
 \ingroup hostingBase
 */
 class HostAttributeList final : public IAttributeList
@@ -86,13 +96,25 @@ public:
 	tresult PLUGIN_API setBinary (AttrID aid, const void* data, uint32 sizeInBytes) override;
 	tresult PLUGIN_API getBinary (AttrID aid, const void*& data, uint32& sizeInBytes) override;
 
+	/** removes all attributes, the memory is kept for reuse */
+	void clear ();
+
 	virtual ~HostAttributeList () noexcept;
 	DECLARE_FUNKNOWN_METHODS
 private:
+	friend class HostMessage;
 	HostAttributeList ();
 
+	/** true if someone else than the owning message holds a reference */
+	bool isShared ();
+	/** sets all attributes of other, reusing the memory of this list */
+	void assign (const HostAttributeList& other);
+
 	struct Attribute;
-	std::map<std::string, Attribute> list;
+	Attribute* find (AttrID aid);
+	Attribute& findOrAdd (AttrID aid);
+
+	std::deque<Attribute> list;
 };
 
 //------------------------------------------------------------------------
@@ -109,10 +131,25 @@ public:
 	void PLUGIN_API setMessageID (const char* messageID) override;
 	IAttributeList* PLUGIN_API getAttributes () override;
 
+	/** returns a copy of message if it is a HostMessage (recycled messages are reused), nullptr
+	 *	for other IMessage implementations */
+	static IPtr<IMessage> copy (IMessage* message);
+	/** copies the ID and the attributes of message into this message, reusing its memory. Returns
+	 *	false if message is not a HostMessage. */
+	bool assign (IMessage* message);
+	/** clears this message for reuse by its owner, returns false (and changes nothing) if someone
+	 *	else holds a reference to it */
+	bool resetForReuse ();
+
 	DECLARE_FUNKNOWN_METHODS
 private:
-	char* messageId {nullptr};
-	IPtr<IAttributeList> attributeList;
+	friend class HostMessagePool;
+	void reset ();
+
+	std::string messageId;
+	bool hasMessageId {false};
+	IPtr<HostAttributeList> attributeList;
+	std::shared_ptr<HostMessagePool> pool;
 };
 
 //------------------------------------------------------------------------
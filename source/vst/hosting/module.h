@@ -36,8 +36,10 @@
 
 #pragma once
 
+#include "../moduleinfo/moduleinfo.h"
 #include "../utility/uid.h"
 #include "pluginterfaces/base/ipluginbase.h"
+#include <chrono>
 #include <utility>
 #include <vector>
 
@@ -176,8 +178,24 @@ public:
 	using PathList = std::vector<std::string>;
 	using SnapshotList = std::vector<Snapshot>;
 
+	/** Options for createLazy */
+	struct LazyOptions
+	{
+		/** module info to use instead of the moduleinfo.json of the bundle, e.g. from a host
+		 *	cache created with ModuleInfoLib::createModuleInfo */
+		Optional<Steinberg::ModuleInfo> moduleInfo;
+		/** time after the last use until unloadIfIdle unloads the library, only done if the
+		 *	factory sets PFactoryInfo::kClassesDiscardable */
+		std::chrono::milliseconds idleTimeout {30000};
+	};
+
 //------------------------------------------------------------------------
 	static Ptr create (const std::string& path, std::string& errorDescription);
+	/** create a module which serves the factory and class infos from the module info and only
+	 *	loads the library on the first createInstance. Falls back to create if there is no module
+	 *	info. Demand loading is only implemented on Linux, the other platforms use create. */
+	static Ptr createLazy (const std::string& path, const LazyOptions& options,
+	                       std::string& errorDescription);
 	static PathList getModulePaths ();
 	static SnapshotList getSnapshots (const std::string& modulePath);
 	/** get the path to the module info json file if it exists */
@@ -189,6 +207,16 @@ public:
 	const std::string& getPath () const noexcept { return path; }
 	const PluginFactory& getFactory () const noexcept { return factory; }
 	bool isBundle () const noexcept { return hasBundleStructure; }
+
+	/** is the library loaded */
+	virtual bool isLoaded () const noexcept { return true; }
+	/** unload the library of a lazy module if no PluginFactory copy other than the one of the
+	 *	module is alive and it was not used for the idle timeout. Hosts must keep a copy of the
+	 *	factory as long as they use instances created by it (like PlugProvider does), instances
+	 *	created via the factory of the module itself keep the library loaded until the module is
+	 *	destroyed. Call this periodically on the main thread. Returns true if the library was
+	 *	unloaded. */
+	virtual bool unloadIfIdle () noexcept { return false; }
 //------------------------------------------------------------------------
 protected:
 	virtual ~Module () noexcept = default;
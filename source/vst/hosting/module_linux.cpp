@@ -35,13 +35,18 @@
 //-----------------------------------------------------------------------------
 
 #include "module.h"
+#include "public.sdk/source/vst/moduleinfo/moduleinfoparser.h"
 #include "public.sdk/source/vst/utility/optional.h"
 #include "public.sdk/source/vst/utility/stringconvert.h"
 
 #include "pluginterfaces/base/funknownimpl.h"
 
 #include <algorithm>
+#include <cstring>
 #include <dlfcn.h>
+#include <fstream>
+#include <mutex>
+#include <sstream>
 #include <sys/types.h>
 #include <sys/utsname.h>
 #include <unistd.h>
@@ -124,18 +129,71 @@ Optional<Path> getApplicationPath ()
 }
 
 //------------------------------------------------------------------------
-class LinuxModule : public Module
+class LinuxLibrary
 {
 public:
+	using PluginFactoryPtr = PluginFactory::PluginFactoryPtr;
+
+	~LinuxLibrary () { close (); }
+
 	template <typename T>
 	T getFunctionPointer (const char* name)
 	{
 		return reinterpret_cast<T> (dlsym (mModule, name));
 	}
 
-	~LinuxModule () override
+	bool open (const Path& modulePath, std::string& errorDescription)
 	{
-		factory = PluginFactory (nullptr);
+		mModule = dlopen (reinterpret_cast<const char*> (modulePath.generic_string ().data ()),
+		                  RTLD_LAZY);
+		if (!mModule)
+		{
+			errorDescription = "dlopen failed.\n";
+			errorDescription += dlerror ();
+			return false;
+		}
+		// ModuleEntry is mandatory
+		auto moduleEntry = getFunctionPointer<ModuleEntryFunc> ("ModuleEntry");
+		if (!moduleEntry)
+		{
+			errorDescription =
+			    "The shared library does not export the required 'ModuleEntry' function";
+			return false;
+		}
+		// ModuleExit is mandatory
+		auto moduleExit = getFunctionPointer<ModuleExitFunc> ("ModuleExit");
+		if (!moduleExit)
+		{
+			errorDescription =
+			    "The shared library does not export the required 'ModuleExit' function";
+			return false;
+		}
+		auto factoryProc = getFunctionPointer<GetFactoryProc> ("GetPluginFactory");
+		if (!factoryProc)
+		{
+			errorDescription =
+			    "The shared library does not export the required 'GetPluginFactory' function";
+			return false;
+		}
+
+		if (!moduleEntry (mModule))
+		{
+			errorDescription = "Calling 'ModuleEntry' failed";
+			return false;
+		}
+		auto f = Steinberg::U::cast<Steinberg::IPluginFactory> (owned (factoryProc ()));
+		if (!f)
+		{
+			errorDescription = "Calling 'GetPluginFactory' returned nullptr";
+			return false;
+		}
+		factory = f;
+		return true;
+	}
+
+	void close ()
+	{
+		factory = nullptr;
 
 		if (mModule)
 		{
@@ -143,7 +201,260 @@ public:
 				moduleExit ();
 
 			dlclose (mModule);
+			mModule = nullptr;
+		}
+	}
+
+	bool isOpen () const { return factory != nullptr; }
+	const PluginFactoryPtr& getFactory () const { return factory; }
+
+private:
+	PluginFactoryPtr factory;
+	void* mModule {nullptr};
+};
+
+//------------------------------------------------------------------------
+void copyString (Steinberg::char8* dest, size_t destSize, const std::string& str)
+{
+	auto size = std::min (str.size (), destSize - 1);
+	memcpy (dest, str.data (), size);
+	dest[size] = 0;
+}
+
+//------------------------------------------------------------------------
+/** Plug-in factory serving the factory and class infos from the module info. The library is
+ *	loaded on the first createInstance and can be unloaded again when the factory is idle. */
+class LazyPluginFactory : public Steinberg::IPluginFactory3
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	using PFactoryInfo = Steinberg::PFactoryInfo;
+	using PClassInfo = Steinberg::PClassInfo;
+	using PClassInfo2 = Steinberg::PClassInfo2;
+	using PClassInfoW = Steinberg::PClassInfoW;
+	using tresult = Steinberg::tresult;
+	using int32 = Steinberg::int32;
+
+	LazyPluginFactory (Path&& modulePath, const Steinberg::ModuleInfo& moduleInfo,
+	                   std::chrono::milliseconds idleTimeout)
+	: modulePath (std::move (modulePath)), idleTimeout (idleTimeout)
+	{
+		FUNKNOWN_CTOR
+
+		const auto& fi = moduleInfo.factoryInfo;
+		copyString (factoryInfo.vendor, PFactoryInfo::kNameSize, fi.vendor);
+		copyString (factoryInfo.url, PFactoryInfo::kURLSize, fi.url);
+		copyString (factoryInfo.email, PFactoryInfo::kEmailSize, fi.email);
+		factoryInfo.flags = fi.flags;
+
+		classes.reserve (moduleInfo.classes.size ());
+		for (const auto& ci : moduleInfo.classes)
+		{
+			auto uid = UID::fromString (ci.cid);
+			if (!uid)
+				continue;
+			ClassEntry entry;
+			entry.info = ci;
+			entry.uid = *uid;
+			classes.emplace_back (std::move (entry));
+		}
+	}
+
+	virtual ~LazyPluginFactory ()
+	{
+		library.close ();
+		FUNKNOWN_DTOR
+	}
+
+	bool isLoaded ()
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		return library.isOpen ();
+	}
+
+	bool unloadIfIdle ()
+	{
+		if (!isDiscardable ())
+			return false;
+		std::lock_guard<std::mutex> guard (mutex);
+		if (!library.isOpen () || pinned || Clock::now () - lastUse < idleTimeout)
+			return false;
+		// the owners of instances keep a PluginFactory copy as long as they use them.
+		// createInstance waits for the mutex, so no new instance can appear before closing.
+		if (!isOnlyReferencedByModule ())
+			return false;
+		library.close ();
+		return true;
+	}
+
+	//--- IPluginFactory --------------------
+	tresult PLUGIN_API getFactoryInfo (PFactoryInfo* info) override
+	{
+		if (!info)
+			return Steinberg::kInvalidArgument;
+		*info = factoryInfo;
+		return Steinberg::kResultTrue;
+	}
+
+	int32 PLUGIN_API countClasses () override { return static_cast<int32> (classes.size ()); }
+
+	tresult PLUGIN_API getClassInfo (int32 index, PClassInfo* info) override
+	{
+		if (!info || index < 0 || index >= countClasses ())
+			return Steinberg::kInvalidArgument;
+		const auto& entry = classes[index];
+		memcpy (info->cid, entry.uid.data (), sizeof (Steinberg::TUID));
+		info->cardinality = entry.info.cardinality;
+		copyString (info->category, PClassInfo::kCategorySize, entry.info.category);
+		copyString (info->name, PClassInfo::kNameSize, entry.info.name);
+		return Steinberg::kResultTrue;
+	}
+
+	tresult PLUGIN_API createInstance (Steinberg::FIDString cid, Steinberg::FIDString _iid,
+	                                   void** obj) override
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		lastUse = Clock::now ();
+		if (!library.isOpen ())
+		{
+			std::string errorDescription;
+			if (!library.open (modulePath, errorDescription))
+			{
+				library.close ();
+				return Steinberg::kResultFalse;
+			}
+			if (hostContext)
+			{
+				if (auto f3 = Steinberg::U::cast<Steinberg::IPluginFactory3> (library.getFactory ()))
+					f3->setHostContext (hostContext);
+			}
+		}
+		auto result = library.getFactory ()->createInstance (cid, _iid, obj);
+		// created via the factory of the module, nobody tells when this instance is released
+		if (result == Steinberg::kResultTrue && isDiscardable () && isOnlyReferencedByModule ())
+			pinned = true;
+		return result;
+	}
+
+	//--- IPluginFactory2 -------------------
+	tresult PLUGIN_API getClassInfo2 (int32 index, PClassInfo2* info) override
+	{
+		if (!info || index < 0 || index >= countClasses ())
+			return Steinberg::kInvalidArgument;
+		const auto& entry = classes[index];
+		memcpy (info->cid, entry.uid.data (), sizeof (Steinberg::TUID));
+		info->cardinality = entry.info.cardinality;
+		copyString (info->category, PClassInfo::kCategorySize, entry.info.category);
+		copyString (info->name, PClassInfo::kNameSize, entry.info.name);
+		info->classFlags = entry.info.flags;
+		copyString (info->subCategories, PClassInfo2::kSubCategoriesSize,
+		            joinSubCategories (entry.info));
+		copyString (info->vendor, PClassInfo2::kVendorSize, entry.info.vendor);
+		copyString (info->version, PClassInfo2::kVersionSize, entry.info.version);
+		copyString (info->sdkVersion, PClassInfo2::kVersionSize, entry.info.sdkVersion);
+		return Steinberg::kResultTrue;
+	}
+
+	//--- IPluginFactory3 -------------------
+	tresult PLUGIN_API getClassInfoUnicode (int32 index, PClassInfoW* info) override
+	{
+		namespace StringConvert = Steinberg::Vst::StringConvert;
+		if (!info || index < 0 || index >= countClasses ())
+			return Steinberg::kInvalidArgument;
+		const auto& entry = classes[index];
+		memcpy (info->cid, entry.uid.data (), sizeof (Steinberg::TUID));
+		info->cardinality = entry.info.cardinality;
+		copyString (info->category, PClassInfo::kCategorySize, entry.info.category);
+		StringConvert::convert (entry.info.name, info->name, PClassInfo::kNameSize);
+		info->classFlags = entry.info.flags;
+		copyString (info->subCategories, PClassInfo2::kSubCategoriesSize,
+		            joinSubCategories (entry.info));
+		StringConvert::convert (entry.info.vendor, info->vendor, PClassInfo2::kVendorSize);
+		StringConvert::convert (entry.info.version, info->version, PClassInfo2::kVersionSize);
+		StringConvert::convert (entry.info.sdkVersion, info->sdkVersion,
+		                        PClassInfo2::kVersionSize);
+		return Steinberg::kResultTrue;
+	}
+
+	tresult PLUGIN_API setHostContext (Steinberg::FUnknown* context) override
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		hostContext = context;
+		if (library.isOpen ())
+		{
+			if (auto f3 = Steinberg::U::cast<Steinberg::IPluginFactory3> (library.getFactory ()))
+				return f3->setHostContext (context);
 		}
+		return Steinberg::kResultTrue;
+	}
+
+	DECLARE_FUNKNOWN_METHODS
+
+private:
+	struct ClassEntry
+	{
+		Steinberg::ModuleInfo::ClassInfo info;
+		UID uid;
+	};
+
+	bool isDiscardable () const
+	{
+		return (factoryInfo.flags & PFactoryInfo::kClassesDiscardable) != 0;
+	}
+
+	/** true if no PluginFactory copy other than the one of the module exists */
+	bool isOnlyReferencedByModule ()
+	{
+		// adding zero is an atomic read of the reference count
+		return Steinberg::FUnknownPrivate::atomicAdd (__funknownRefCount, 0) == 1;
+	}
+
+	static std::string joinSubCategories (const Steinberg::ModuleInfo::ClassInfo& info)
+	{
+		std::string result;
+		for (const auto& subCategory : info.subCategories)
+		{
+			if (!result.empty ())
+				result += "|";
+			result += subCategory;
+		}
+		return result;
+	}
+
+	Path modulePath;
+	PFactoryInfo factoryInfo {};
+	std::vector<ClassEntry> classes;
+	std::chrono::milliseconds idleTimeout;
+
+	std::mutex mutex;
+	LinuxLibrary library;
+	bool pinned {false};
+	Steinberg::FUnknown* hostContext {nullptr};
+	Clock::time_point lastUse {};
+};
+
+IMPLEMENT_REFCOUNT (LazyPluginFactory)
+
+//------------------------------------------------------------------------
+Steinberg::tresult PLUGIN_API LazyPluginFactory::queryInterface (const Steinberg::TUID _iid,
+                                                                 void** obj)
+{
+	QUERY_INTERFACE (_iid, obj, Steinberg::FUnknown::iid, Steinberg::IPluginFactory)
+	QUERY_INTERFACE (_iid, obj, Steinberg::IPluginFactory::iid, Steinberg::IPluginFactory)
+	QUERY_INTERFACE (_iid, obj, Steinberg::IPluginFactory2::iid, Steinberg::IPluginFactory2)
+	QUERY_INTERFACE (_iid, obj, Steinberg::IPluginFactory3::iid, Steinberg::IPluginFactory3)
+	*obj = nullptr;
+	return Steinberg::kNoInterface;
+}
+
+//------------------------------------------------------------------------
+class LinuxModule : public Module
+{
+public:
+	~LinuxModule () override
+	{
+		factory = PluginFactory (nullptr);
+		library.close ();
 	}
 
 	static Optional<Path> getSOPath (const std::string& inPath)
@@ -180,57 +491,67 @@ public:
 			errorDescription = inPath + " is not a module directory.";
 			return false;
 		}
-
-		mModule = dlopen (reinterpret_cast<const char*> (modulePath->generic_string ().data ()),
-		                  RTLD_LAZY);
-		if (!mModule)
-		{
-			errorDescription = "dlopen failed.\n";
-			errorDescription += dlerror ();
+		if (!library.open (*modulePath, errorDescription))
 			return false;
-		}
-		// ModuleEntry is mandatory
-		auto moduleEntry = getFunctionPointer<ModuleEntryFunc> ("ModuleEntry");
-		if (!moduleEntry)
-		{
-			errorDescription =
-			    "The shared library does not export the required 'ModuleEntry' function";
-			return false;
-		}
-		// ModuleExit is mandatory
-		auto moduleExit = getFunctionPointer<ModuleExitFunc> ("ModuleExit");
-		if (!moduleExit)
-		{
-			errorDescription =
-			    "The shared library does not export the required 'ModuleExit' function";
-			return false;
-		}
-		auto factoryProc = getFunctionPointer<GetFactoryProc> ("GetPluginFactory");
-		if (!factoryProc)
-		{
-			errorDescription =
-			    "The shared library does not export the required 'GetPluginFactory' function";
-			return false;
-		}
+		factory = PluginFactory (library.getFactory ());
+		return true;
+	}
 
-		if (!moduleEntry (mModule))
-		{
-			errorDescription = "Calling 'ModuleEntry' failed";
-			return false;
-		}
-		auto f = Steinberg::U::cast<Steinberg::IPluginFactory> (owned (factoryProc ()));
-		if (!f)
+	bool loadLazy (const std::string& inPath, const Steinberg::ModuleInfo& moduleInfo,
+	               std::chrono::milliseconds idleTimeout, std::string& errorDescription)
+	{
+		auto modulePath = getSOPath (inPath);
+		if (!modulePath)
 		{
-			errorDescription = "Calling 'GetPluginFactory' returned nullptr";
+			errorDescription = inPath + " is not a module directory.";
 			return false;
 		}
-		factory = PluginFactory (f);
+		// the factory is owned by the PluginFactory of the module
+		lazyFactory = new LazyPluginFactory (std::move (*modulePath), moduleInfo, idleTimeout);
+		factory = PluginFactory (owned (lazyFactory));
 		return true;
 	}
 
-	void* mModule {nullptr};
+	bool isLoaded () const noexcept override
+	{
+		return lazyFactory ? lazyFactory->isLoaded () : library.isOpen ();
+	}
+
+	bool unloadIfIdle () noexcept override
+	{
+		return lazyFactory ? lazyFactory->unloadIfIdle () : false;
+	}
+
+	void setPath (const std::string& inPath)
+	{
+		path = inPath;
+		auto it = std::find_if (inPath.rbegin (), inPath.rend (),
+		                        [] (const std::string::value_type& c) { return c == '/'; });
+		if (it != inPath.rend ())
+			name = {it.base (), inPath.end ()};
+	}
+
+	LinuxLibrary library;
+	LazyPluginFactory* lazyFactory {nullptr};
 };
 
+//------------------------------------------------------------------------
+Optional<Steinberg::ModuleInfo> readModuleInfo (const std::string& modulePath)
+{
+	auto infoPath = Module::getModuleInfoPath (modulePath);
+	if (!infoPath)
+		return {};
+	std::ifstream file (*infoPath, std::ios_base::in | std::ios_base::binary);
+	if (!file.is_open ())
+		return {};
+	std::stringstream data;
+	data << file.rdbuf ();
+	auto moduleInfo = Steinberg::ModuleInfoLib::parseJson (data.str (), nullptr);
+	if (!moduleInfo)
+		return {};
+	return Optional<Steinberg::ModuleInfo> (std::move (*moduleInfo));
+}
+
 //------------------------------------------------------------------------
 void findFilesWithExt (const std::string& path, const std::string& ext, Module::PathList& pathList,
                        bool recursive = true)
@@ -269,11 +590,28 @@ Module::Ptr Module::create (const std::string& path, std::string& errorDescripti
 	auto _module = std::make_shared<LinuxModule> ();
 	if (_module->load (path, errorDescription))
 	{
-		_module->path = path;
-		auto it = std::find_if (path.rbegin (), path.rend (),
-		                        [] (const std::string::value_type& c) { return c == '/'; });
-		if (it != path.rend ())
-			_module->name = {it.base (), path.end ()};
+		_module->setPath (path);
+		return _module;
+	}
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+Module::Ptr Module::createLazy (const std::string& path, const LazyOptions& options,
+                                std::string& errorDescription)
+{
+	Optional<Steinberg::ModuleInfo> moduleInfo;
+	if (options.moduleInfo)
+		moduleInfo = Optional<Steinberg::ModuleInfo> (*options.moduleInfo);
+	else
+		moduleInfo = readModuleInfo (path);
+	if (!moduleInfo)
+		return create (path, errorDescription);
+
+	auto _module = std::make_shared<LinuxModule> ();
+	if (_module->loadLazy (path, *moduleInfo, options.idleTimeout, errorDescription))
+	{
+		_module->setPath (path);
 		return _module;
 	}
 	return nullptr;
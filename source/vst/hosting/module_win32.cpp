@@ -564,6 +564,14 @@ Module::Ptr Module::create (const std::string& path, std::string& errorDescripti
 	return nullptr;
 }
 
+//------------------------------------------------------------------------
+Module::Ptr Module::createLazy (const std::string& path, const LazyOptions& /*options*/,
+                                std::string& errorDescription)
+{
+	// demand loading is not implemented on this platform
+	return create (path, errorDescription);
+}
+
 //------------------------------------------------------------------------
 Module::PathList Module::getModulePaths ()
 {
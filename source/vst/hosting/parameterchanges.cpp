@@ -87,6 +87,14 @@ tresult PLUGIN_API ParameterValueQueue::getPoint (int32 index, int32& sampleOffs
 //-----------------------------------------------------------------------------
 tresult PLUGIN_API ParameterValueQueue::addPoint (int32 sampleOffset, ParamValue value, int32& index)
 {
+	// points usually arrive in time order
+	if (values.empty () || values.back ().sampleOffset < sampleOffset)
+	{
+		index = static_cast<int32> (values.size ());
+		values.emplace_back (value, sampleOffset);
+		return kResultTrue;
+	}
+
 	auto destIndex = static_cast<int32>(values.size ());
 	for (uint32 i = 0; i < values.size (); i++)
 	{
@@ -236,7 +244,7 @@ void ParameterChangeTransfer::setMaxParameters (int32 maxParameters)
 }
 
 //-----------------------------------------------------------------------------
-void ParameterChangeTransfer::addChange (ParamID pid, ParamValue value, int32 sampleOffset)
+bool ParameterChangeTransfer::addChange (ParamID pid, ParamValue value, int32 sampleOffset)
 {
 	if (changes)
 	{
@@ -248,8 +256,12 @@ void ParameterChangeTransfer::addChange (ParamID pid, ParamValue value, int32 sa
 		if (newWriteIndex >= size)
 			newWriteIndex = 0;
 		if (readIndex != newWriteIndex)
+		{
 			writeIndex = newWriteIndex;
+			return true;
+		}
 	}
+	return false;
 }
 
 //-----------------------------------------------------------------------------
@@ -114,7 +114,8 @@ public:
 
 	void setMaxParameters (int32 maxParameters);
 
-	void addChange (ParamID pid, ParamValue value, int32 sampleOffset);
+	/** returns false if the transfer is full and the change was dropped */
+	bool addChange (ParamID pid, ParamValue value, int32 sampleOffset);
 	bool getNextChange (ParamID& pid, ParamValue& value, int32& sampleOffset);
 
 	void transferChangesTo (ParameterChanges& dest);
@@ -37,14 +37,23 @@
 #include "plugprovider.h"
 
 #include "connectionproxy.h"
+#include "processdata.h"
+#include "threadpool.h"
+#include "public.sdk/source/vst/utility/memoryibstream.h"
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
 #include "pluginterfaces/vst/ivstcomponent.h"
 #include "pluginterfaces/vst/ivsteditcontroller.h"
 #include "pluginterfaces/vst/ivstmessage.h"
 
 #include <cstdio>
 #include <iostream>
+#include <mutex>
 
 static std::ostream* errorStream = &std::cout;
+// plug-ins may be set up on several threads at once
+static std::mutex errorStreamMutex;
+// plug-in factories are not required to be thread safe
+static std::mutex factoryMutex;
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -65,6 +74,8 @@ PlugProvider::PlugProvider (const PluginFactory& factory, ClassInfo classInfo, b
 //------------------------------------------------------------------------
 PlugProvider::~PlugProvider ()
 {
+	if (pendingSetup.valid ())
+		pendingSetup.wait ();
 	terminatePlugin ();
 }
 
@@ -72,6 +83,7 @@ PlugProvider::~PlugProvider ()
 template <typename Proc>
 void PlugProvider::printError (Proc p) const
 {
+	std::lock_guard<std::mutex> lock (errorStreamMutex);
 	if (errorStream)
 	{
 		p (*errorStream);
@@ -88,9 +100,170 @@ bool PlugProvider::initialize ()
 	return true;
 }
 
+//------------------------------------------------------------------------
+bool PlugProvider::initializeAsync (ThreadPool& threadPool, const AsyncOptions& options)
+{
+	if (pendingSetup.valid () || component)
+		return false;
+
+	setupOptions = options;
+	pendingWarmUp = options.warmUp;
+	auto hostContext = PluginContextFactory::instance ().getPluginContext ();
+	if (!options.canInitializeOnWorker || !options.canInitializeOnWorker (classInfo))
+	{
+		std::promise<bool> result;
+		result.set_value (createPlugin (hostContext));
+		pendingSetup = result.get_future ();
+		return true;
+	}
+
+	// the connection proxies check the thread they are created on, so only creating and
+	// initializing is done on the worker, connecting is done in waitForInitialize
+	auto task = std::make_shared<std::packaged_task<bool ()>> (
+	    [this, hostContext] () { return createPlugin (hostContext); });
+	pendingSetup = task->get_future ();
+	threadPool.addTask ([task] () { (*task) (); });
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool PlugProvider::waitForInitialize ()
+{
+	if (!pendingSetup.valid ())
+		return component != nullptr;
+
+	auto created = pendingSetup.get ();
+	auto state = std::move (pendingState);
+	return created && finishSetup (state.get ());
+}
+
+//------------------------------------------------------------------------
+bool PlugProvider::finishSetup (CloneState* state)
+{
+	// spare instances taken for a clone are already connected
+	if (!isSingleComponent && !componentCP && !connectComponents ())
+		return false;
+
+	if (state)
+	{
+		if (!componentStateRestored && !restoreComponentState (*state))
+			return false;
+		restoreControllerState (*state);
+	}
+	else
+		syncControllerState ();
+	componentStateRestored = false;
+
+	if (pendingWarmUp)
+	{
+		pendingWarmUp = false;
+		warmUpPlugin (setupOptions);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+struct PlugProvider::CloneState
+{
+	IPtr<ResizableMemoryIBStream> componentState {owned (new ResizableMemoryIBStream)};
+	IPtr<ResizableMemoryIBStream> controllerState {owned (new ResizableMemoryIBStream)};
+};
+
+//------------------------------------------------------------------------
+IPtr<PlugProvider> PlugProvider::clone (ThreadPool& threadPool, const AsyncOptions& options,
+                                        PlugProviderPool* spares)
+{
+	if (pendingSetup.valid ())
+		waitForInitialize ();
+	if (!component)
+		return nullptr;
+
+	// reuse the buffers of the last clone unless its setup still reads them
+	if (!cloneState || cloneState.use_count () > 1)
+		cloneState = std::make_shared<CloneState> ();
+	auto state = cloneState;
+	state->componentState->clear ();
+	state->controllerState->clear ();
+	if (component->getState (state->componentState) != kResultTrue)
+		return nullptr;
+	if (controller && !isSingleComponent &&
+	    controller->getState (state->controllerState) != kResultTrue)
+		state->controllerState->clear ();
+
+	IPtr<PlugProvider> result = spares ? spares->take (classInfo.ID ()) : nullptr;
+	const bool isSpare = result != nullptr;
+	if (!result)
+		result = owned (new PlugProvider (factory, classInfo, plugIsGlobal));
+
+	// a spare is connected already, its state is restored in waitForInitialize on this thread
+	result->pendingState = state;
+	result->setupOptions = options;
+	result->pendingWarmUp = !isSpare && options.warmUp;
+	auto hostContext = PluginContextFactory::instance ().getPluginContext ();
+	auto provider = result.get ();
+	auto setup = [provider, state, isSpare, hostContext] () {
+		if (isSpare)
+			return true;
+		if (!provider->createPlugin (hostContext))
+			return false;
+		// nothing is connected yet, so the component state can be restored here
+		provider->componentStateRestored = provider->restoreComponentState (*state);
+		return provider->componentStateRestored;
+	};
+	if (!options.canInitializeOnWorker || !options.canInitializeOnWorker (classInfo))
+	{
+		std::promise<bool> promise;
+		promise.set_value (setup ());
+		result->pendingSetup = promise.get_future ();
+		return result;
+	}
+	auto task = std::make_shared<std::packaged_task<bool ()>> (std::move (setup));
+	result->pendingSetup = task->get_future ();
+	threadPool.addTask ([task] () { (*task) (); });
+	return result;
+}
+
+//------------------------------------------------------------------------
+bool PlugProvider::restoreComponentState (CloneState& state)
+{
+	state.componentState->rewind ();
+	return component->setState (state.componentState) == kResultTrue;
+}
+
+//------------------------------------------------------------------------
+void PlugProvider::restoreControllerState (CloneState& state)
+{
+	if (!controller || isSingleComponent)
+		return;
+
+	state.componentState->rewind ();
+	controller->setComponentState (state.componentState);
+	if (state.controllerState->getSize () > 0)
+	{
+		state.controllerState->rewind ();
+		controller->setState (state.controllerState);
+	}
+}
+
+//------------------------------------------------------------------------
+void PlugProvider::syncControllerState ()
+{
+	if (!controller || isSingleComponent)
+		return;
+
+	auto stream = owned (new ResizableMemoryIBStream);
+	if (component->getState (stream) != kResultTrue)
+		return;
+	stream->rewind ();
+	controller->setComponentState (stream);
+}
+
 //------------------------------------------------------------------------
 IComponent* PLUGIN_API PlugProvider::getComponent ()
 {
+	if (pendingSetup.valid ())
+		waitForInitialize ();
+
 	if (!component)
 		setupPlugin (PluginContextFactory::instance ().getPluginContext ());
 
@@ -145,13 +318,24 @@ tresult PLUGIN_API PlugProvider::releasePlugIn (IComponent* iComponent,
 
 //------------------------------------------------------------------------
 bool PlugProvider::setupPlugin (FUnknown* hostContext)
+{
+	if (!createPlugin (hostContext))
+		return false;
+	return isSingleComponent || connectComponents ();
+}
+
+//------------------------------------------------------------------------
+bool PlugProvider::createPlugin (FUnknown* hostContext)
 {
 	bool res = false;
-	bool isSingleComponent = false;
+	isSingleComponent = false;
 
 	//---create Plug-in here!--------------
 	// create its component part
-	component = factory.createInstance<IComponent> (classInfo.ID ());
+	{
+		std::lock_guard<std::mutex> lock (factoryMutex);
+		component = factory.createInstance<IComponent> (classInfo.ID ());
+	}
 	if (component)
 	{
 		// initialize the component with our context
@@ -189,7 +373,10 @@ bool PlugProvider::setupPlugin (FUnknown* hostContext)
 			if (component->getControllerClassId (controllerCID) == kResultTrue)
 			{
 				// create its controller part created from the factory
-				controller = factory.createInstance<IEditController> (VST3::UID (controllerCID));
+				{
+					std::lock_guard<std::mutex> lock (factoryMutex);
+					controller = factory.createInstance<IEditController> (VST3::UID (controllerCID));
+				}
 				if (controller)
 				{
 					// initialize the component with our context
@@ -228,19 +415,51 @@ bool PlugProvider::setupPlugin (FUnknown* hostContext)
 			controller.reset ();
 		}
 	}
-	else if (errorStream)
+	else
 	{
 		printError ([&] (std::ostream& stream) {
 			stream << "Failed to create component instance of " << classInfo.name () << "!\n";
 		});
 	}
-
-	if (res && !isSingleComponent)
-		return connectComponents ();
-
 	return res;
 }
 
+//------------------------------------------------------------------------
+void PlugProvider::warmUpPlugin (const AsyncOptions& options)
+{
+	auto processor = U::cast<IAudioProcessor> (component);
+	if (!processor)
+		return;
+
+	ProcessSetup setup {kRealtime, kSample32, options.warmUpBlockSize, options.warmUpSampleRate};
+	if (processor->setupProcessing (setup) != kResultTrue)
+		return;
+	if (component->setActive (true) != kResultTrue)
+		return;
+
+	HostProcessData processData;
+	if (processData.prepare (*component, options.warmUpBlockSize, kSample32))
+	{
+		processData.processMode = kRealtime;
+		processData.numSamples = options.warmUpBlockSize;
+		for (int32 i = 0; i < processData.numInputs; ++i)
+		{
+			auto& bus = processData.inputs[i];
+			for (int32 c = 0; c < bus.numChannels; ++c)
+				memset (bus.channelBuffers32[c], 0, options.warmUpBlockSize * sizeof (Sample32));
+			bus.silenceFlags = HostProcessData::kAllChannelsSilent;
+		}
+		auto result = processor->setProcessing (true);
+		if (result == kResultTrue || result == kNotImplemented)
+		{
+			for (int32 i = 0; i < options.warmUpProcessCalls; ++i)
+				processor->process (processData);
+			processor->setProcessing (false);
+		}
+	}
+	component->setActive (false);
+}
+
 //------------------------------------------------------------------------
 bool PlugProvider::connectComponents ()
 {
@@ -332,9 +551,82 @@ void PlugProvider::terminatePlugin ()
 //------------------------------------------------------------------------
 void PlugProvider::setErrorStream (std::ostream* stream)
 {
+	std::lock_guard<std::mutex> lock (errorStreamMutex);
 	errorStream = stream;
 }
 
+//------------------------------------------------------------------------
+// PlugProviderPool
+//------------------------------------------------------------------------
+PlugProviderPool::PlugProviderPool (ThreadPool& threadPool, const PlugProvider::AsyncOptions& options)
+: threadPool (threadPool), options (options)
+{
+}
+
+//------------------------------------------------------------------------
+PlugProviderPool::~PlugProviderPool () noexcept
+{
+	clear ();
+}
+
+//------------------------------------------------------------------------
+void PlugProviderPool::setNumSpares (const PluginFactory& factory, const ClassInfo& classInfo,
+                                     uint32 numSpares)
+{
+	if (numSpares == 0)
+	{
+		spares.erase (classInfo.ID ());
+		return;
+	}
+	auto it = spares.find (classInfo.ID ());
+	if (it == spares.end ())
+		it = spares.emplace (classInfo.ID (), Spares {factory, classInfo}).first;
+	it->second.numSpares = numSpares;
+	while (it->second.providers.size () > numSpares)
+		it->second.providers.pop_back ();
+	refill (it->second);
+}
+
+//------------------------------------------------------------------------
+IPtr<PlugProvider> PlugProviderPool::take (const VST3::UID& classID)
+{
+	auto it = spares.find (classID);
+	if (it == spares.end ())
+		return nullptr;
+
+	auto& providers = it->second.providers;
+	while (!providers.empty ())
+	{
+		auto provider = providers.front ();
+		providers.pop_front ();
+		if (provider->waitForInitialize ())
+		{
+			refill (it->second);
+			return provider;
+		}
+	}
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+void PlugProviderPool::clear ()
+{
+	// the providers wait for their pending setup when destroyed
+	spares.clear ();
+}
+
+//------------------------------------------------------------------------
+void PlugProviderPool::refill (Spares& spares)
+{
+	while (spares.providers.size () < spares.numSpares)
+	{
+		auto provider = owned (new PlugProvider (spares.factory, spares.classInfo, true));
+		if (!provider->initializeAsync (threadPool, options))
+			break;
+		spares.providers.push_back (provider);
+	}
+}
+
 //------------------------------------------------------------------------
 } // Vst
 } // Steinberg
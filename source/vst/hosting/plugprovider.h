@@ -40,6 +40,11 @@
 #include "pluginterfaces/vst/ivsttestplugprovider.h"
 #include "pluginterfaces/base/funknownimpl.h"
 
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <ostream>
 
 namespace Steinberg {
@@ -48,6 +53,8 @@ namespace Vst {
 class IComponent;
 class IEditController;
 class ConnectionProxy;
+class ThreadPool;
+class PlugProviderPool;
 
 //------------------------------------------------------------------------
 /** Helper for creating and initializing component.
@@ -66,6 +73,37 @@ public:
 
 	bool initialize ();
 
+	/** Options for initializeAsync */
+	struct AsyncOptions
+	{
+		/** Returns true if the class may be created and initialized on a worker thread. The VST 3
+		 *	threading rules ask for the UI thread, so only allow classes known to cope with it.
+		 *	Without a predicate the plug-in is set up on the calling thread. */
+		std::function<bool (const ClassInfo&)> canInitializeOnWorker;
+
+		/** run setupProcessing, setActive and a few silent process calls to fault in the code and
+		 *	data pages of the instance before playback starts. This is done by waitForInitialize
+		 *	after component and controller are connected and in sync. */
+		bool warmUp {true};
+		SampleRate warmUpSampleRate {48000.};
+		int32 warmUpBlockSize {512};
+		int32 warmUpProcessCalls {4};
+	};
+
+	/** Starts creating and initializing the plug-in on the thread pool. Start all plug-ins of a
+	 *	project first, then call waitForInitialize for each of them on the calling thread. */
+	bool initializeAsync (ThreadPool& threadPool, const AsyncOptions& options);
+	/** Waits until the plug-in is initialized, connects component and controller, sends the
+	 *	component state to the controller and warms the plug-in up. */
+	bool waitForInitialize ();
+
+	/** Creates a new provider of the same class with the current state of this plug-in.
+	 *	The states are serialized into buffers retained by this provider for the next clone. The
+	 *	new instance is taken from spares if available, otherwise it is created like in
+	 *	initializeAsync. Call waitForInitialize on the result before using it. */
+	IPtr<PlugProvider> clone (ThreadPool& threadPool, const AsyncOptions& options,
+	                          PlugProviderPool* spares = nullptr);
+
 	IPtr<IComponent> getComponentPtr () const { return component; }
 	IPtr<IEditController> getControllerPtr () const { return controller; }
 	const ClassInfo& getClassInfo () const { return classInfo; }
@@ -88,6 +126,14 @@ public:
 //------------------------------------------------------------------------
 protected:
 	bool setupPlugin (FUnknown* hostContext);
+	bool createPlugin (FUnknown* hostContext);
+	void warmUpPlugin (const AsyncOptions& options);
+
+	struct CloneState;
+	bool finishSetup (CloneState* state);
+	bool restoreComponentState (CloneState& state);
+	void restoreControllerState (CloneState& state);
+	void syncControllerState ();
 	bool connectComponents ();
 	bool disconnectComponents ();
 	void terminatePlugin ();
@@ -103,7 +149,51 @@ protected:
 	IPtr<ConnectionProxy> componentCP;
 	IPtr<ConnectionProxy> controllerCP;
 
+	std::future<bool> pendingSetup;
+	std::shared_ptr<CloneState> pendingState;
+	AsyncOptions setupOptions;
+	bool pendingWarmUp {false};
+	bool componentStateRestored {false};
+	std::shared_ptr<CloneState> cloneState;
 	bool plugIsGlobal;
+	bool isSingleComponent {false};
+};
+
+//------------------------------------------------------------------------
+/** Keeps initialized spare instances of plug-in classes for PlugProvider::clone.
+\ingroup hostingBase */
+//------------------------------------------------------------------------
+class PlugProviderPool
+{
+public:
+	using ClassInfo = PlugProvider::ClassInfo;
+	using PluginFactory = PlugProvider::PluginFactory;
+
+	PlugProviderPool (ThreadPool& threadPool, const PlugProvider::AsyncOptions& options);
+	~PlugProviderPool () noexcept;
+
+	/** Keeps numSpares instances of the class initialized (0 removes them). */
+	void setNumSpares (const PluginFactory& factory, const ClassInfo& classInfo, uint32 numSpares);
+	/** Takes an initialized instance and starts creating a replacement. Returns nullptr if there
+	 *	is no spare instance of the class. */
+	IPtr<PlugProvider> take (const VST3::UID& classID);
+	/** Removes all spare instances. */
+	void clear ();
+
+//------------------------------------------------------------------------
+private:
+	struct Spares
+	{
+		PluginFactory factory;
+		ClassInfo classInfo;
+		uint32 numSpares {0};
+		std::deque<IPtr<PlugProvider>> providers;
+	};
+	void refill (Spares& spares);
+
+	ThreadPool& threadPool;
+	PlugProvider::AsyncOptions options;
+	std::map<VST3::UID, Spares> spares;
 };
 
 //------------------------------------------------------------------------
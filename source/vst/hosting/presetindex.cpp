@@ -0,0 +1,455 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/presetindex.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Parallel VST 3 preset library indexer with on-disk cache
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "presetindex.h"
+#include "threadpool.h"
+
+#include "public.sdk/source/vst/vstpresetfile.h"
+#include "pluginterfaces/base/funknownimpl.h"
+#include "pluginterfaces/vst/vstpresetkeys.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <unordered_map>
+
+#if SMTG_CPP17
+
+#if __has_include(<filesystem>)
+#define USE_EXPERIMENTAL_FS 0
+#elif __has_include(<experimental/filesystem>)
+#define USE_EXPERIMENTAL_FS 1
+#endif
+
+#else // !SMTG_CPP17
+
+#define USE_EXPERIMENTAL_FS 1
+
+#endif // SMTG_CPP17
+
+#if USE_EXPERIMENTAL_FS == 1
+
+#include <experimental/filesystem>
+namespace filesystem = std::experimental::filesystem;
+
+#else // USE_EXPERIMENTAL_FS == 0
+
+#include <filesystem>
+namespace filesystem = std::filesystem;
+
+#endif // USE_EXPERIMENTAL_FS
+
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+constexpr auto kIndexFileHeader = "VST3PresetIndex 1";
+constexpr auto kPresetExtension = ".vstpreset";
+constexpr char kTagSeparator = '|';
+
+//------------------------------------------------------------------------
+struct PresetFileInfo
+{
+	std::string path;
+	int64 modificationTime;
+};
+using PresetFileInfoList = std::vector<PresetFileInfo>;
+
+//------------------------------------------------------------------------
+int64 getModificationTime (const filesystem::path& path)
+{
+	try
+	{
+		auto time = filesystem::last_write_time (path);
+		return static_cast<int64> (time.time_since_epoch ().count ());
+	}
+	catch (...)
+	{
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------
+void findPresetFiles (const filesystem::path& path, PresetFileInfoList& list)
+{
+	try
+	{
+		for (auto& p : filesystem::recursive_directory_iterator (path))
+		{
+			if (p.path ().extension () != kPresetExtension)
+				continue;
+			if (filesystem::is_directory (p.path ()))
+				continue;
+			list.push_back ({p.path ().generic_string (), getModificationTime (p.path ())});
+		}
+	}
+	catch (...)
+	{
+	}
+}
+
+//------------------------------------------------------------------------
+void splitTags (const std::string& str, std::vector<std::string>& tags)
+{
+	std::string::size_type start = 0;
+	while (start <= str.size ())
+	{
+		auto end = str.find (kTagSeparator, start);
+		if (end == std::string::npos)
+			end = str.size ();
+		if (end > start)
+		{
+			auto tag = str.substr (start, end - start);
+			if (std::find (tags.begin (), tags.end (), tag) == tags.end ())
+				tags.emplace_back (std::move (tag));
+		}
+		start = end + 1;
+	}
+}
+
+//------------------------------------------------------------------------
+std::string unescapeXML (const std::string& str)
+{
+	static const std::pair<const char*, char> entities[] = {
+	    {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+
+	std::string result;
+	result.reserve (str.size ());
+	for (std::string::size_type i = 0; i < str.size (); ++i)
+	{
+		if (str[i] == '&')
+		{
+			bool replaced = false;
+			for (const auto& entity : entities)
+			{
+				auto length = strlen (entity.first);
+				if (str.compare (i, length, entity.first) == 0)
+				{
+					result += entity.second;
+					i += length - 1;
+					replaced = true;
+					break;
+				}
+			}
+			if (replaced)
+				continue;
+		}
+		result += str[i];
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** returns the value of the XML attribute 'name' inside of the element [start, end) */
+bool getXMLAttribute (const std::string& xml, std::string::size_type start,
+                      std::string::size_type end, const char* name, std::string& value)
+{
+	std::string pattern = std::string (" ") + name + "=\"";
+	auto pos = xml.find (pattern, start);
+	if (pos == std::string::npos || pos >= end)
+		return false;
+	pos += pattern.size ();
+	auto valueEnd = xml.find ('"', pos);
+	if (valueEnd == std::string::npos || valueEnd > end)
+		return false;
+	value = unescapeXML (xml.substr (pos, valueEnd - pos));
+	return true;
+}
+
+//------------------------------------------------------------------------
+/** parses the <Attr id="..." value="..."/> elements of the preset meta info */
+void parseMetaInfo (const std::string& xml, PresetIndex::Entry& entry)
+{
+	std::string::size_type pos = 0;
+	while ((pos = xml.find ("<Attr", pos)) != std::string::npos)
+	{
+		auto end = xml.find ('>', pos);
+		if (end == std::string::npos)
+			break;
+
+		std::string id;
+		std::string value;
+		if (getXMLAttribute (xml, pos, end, "id", id) &&
+		    getXMLAttribute (xml, pos, end, "value", value))
+		{
+			if (id == PresetAttributes::kName)
+				entry.name = value;
+			else if (id == PresetAttributes::kInstrument)
+				entry.category = value;
+			else if (id == PresetAttributes::kCharacter || id == PresetAttributes::kStyle)
+				splitTags (value, entry.tags);
+		}
+		pos = end;
+	}
+}
+
+//------------------------------------------------------------------------
+std::string escapeField (const std::string& str)
+{
+	std::string result;
+	result.reserve (str.size ());
+	for (auto c : str)
+	{
+		switch (c)
+		{
+			case '\\': result += "\\\\"; break;
+			case '\t': result += "\\t"; break;
+			case '\n': result += "\\n"; break;
+			case '\r': result += "\\r"; break;
+			default: result += c; break;
+		}
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+std::vector<std::string> splitFields (const std::string& line)
+{
+	std::vector<std::string> fields (1);
+	for (std::string::size_type i = 0; i < line.size (); ++i)
+	{
+		auto c = line[i];
+		if (c == '\t')
+		{
+			fields.emplace_back ();
+			continue;
+		}
+		if (c == '\\' && i + 1 < line.size ())
+		{
+			switch (line[++i])
+			{
+				case 't': c = '\t'; break;
+				case 'n': c = '\n'; break;
+				case 'r': c = '\r'; break;
+				default: c = line[i]; break;
+			}
+		}
+		fields.back () += c;
+	}
+	return fields;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+// PresetIndex::Entry
+//------------------------------------------------------------------------
+bool PresetIndex::Entry::hasTag (const std::string& tag) const
+{
+	return std::find (tags.begin (), tags.end (), tag) != tags.end ();
+}
+
+//------------------------------------------------------------------------
+// PresetIndex
+//------------------------------------------------------------------------
+bool PresetIndex::readEntry (const std::string& path, Entry& entry)
+{
+	auto stream = owned (FileStream::open (path.data (), "rb"));
+	if (!stream)
+		return false;
+
+	// reads only the header and the chunk list
+	PresetFile presetFile (stream);
+	if (!presetFile.readChunkList ())
+		return false;
+
+	entry.path = path;
+	entry.classID = presetFile.getClassID ();
+	entry.name.clear ();
+	entry.category.clear ();
+	entry.tags.clear ();
+
+	int32 size = 0;
+	if (presetFile.readMetaInfo (nullptr, size))
+	{
+		std::string xml (static_cast<size_t> (size), '\0');
+		if (presetFile.readMetaInfo (&xml[0], size))
+		{
+			xml.resize (static_cast<size_t> (std::max<int32> (size, 0)));
+			parseMetaInfo (xml, entry);
+		}
+	}
+	if (entry.name.empty ())
+		entry.name = filesystem::path (path).stem ().generic_string ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+PresetIndex::ScanResult PresetIndex::scan (const PathList& directories, uint32 numThreads)
+{
+	ScanResult result;
+
+	PresetFileInfoList files;
+	for (const auto& directory : directories)
+		findPresetFiles (directory, files);
+	result.numFiles = static_cast<uint32> (files.size ());
+
+	std::unordered_map<std::string, Entry*> cache;
+	cache.reserve (entries.size ());
+	for (auto& entry : entries)
+		cache.emplace (entry.path, &entry);
+
+	EntryList newEntries (files.size ());
+	std::vector<size_t> filesToParse;
+	for (size_t i = 0; i < files.size (); ++i)
+	{
+		auto it = cache.find (files[i].path);
+		if (it != cache.end () && it->second->modificationTime == files[i].modificationTime)
+		{
+			newEntries[i] = std::move (*it->second);
+			++result.numCached;
+			continue;
+		}
+		filesToParse.push_back (i);
+	}
+
+	std::vector<uint8> parsed (files.size (), 0);
+	if (!filesToParse.empty ())
+	{
+		std::atomic<size_t> nextFile {0};
+		ThreadPool threadPool (numThreads);
+		for (uint32 i = 0; i < threadPool.getNumThreads (); ++i)
+		{
+			threadPool.addTask ([&] () {
+				size_t index;
+				while ((index = nextFile++) < filesToParse.size ())
+				{
+					auto fileIndex = filesToParse[index];
+					auto& entry = newEntries[fileIndex];
+					if (readEntry (files[fileIndex].path, entry))
+					{
+						entry.modificationTime = files[fileIndex].modificationTime;
+						parsed[fileIndex] = 1;
+					}
+				}
+			});
+		}
+		threadPool.waitAll ();
+	}
+
+	entries.clear ();
+	entries.reserve (files.size ());
+	for (size_t i = 0; i < files.size (); ++i)
+	{
+		if (newEntries[i].path.empty ())
+		{
+			++result.numFailed;
+			continue;
+		}
+		if (parsed[i])
+			++result.numParsed;
+		entries.emplace_back (std::move (newEntries[i]));
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+PresetIndex::EntryList PresetIndex::find (const FUID& classID, const std::string& tag) const
+{
+	EntryList result;
+	for (const auto& entry : entries)
+	{
+		if (entry.classID != classID)
+			continue;
+		if (!tag.empty () && !entry.hasTag (tag))
+			continue;
+		result.push_back (entry);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+bool PresetIndex::load (const std::string& indexPath)
+{
+	std::ifstream stream (indexPath, std::ios::in | std::ios::binary);
+	if (!stream.is_open ())
+		return false;
+
+	std::string line;
+	if (!std::getline (stream, line) || line != kIndexFileHeader)
+		return false;
+
+	EntryList newEntries;
+	while (std::getline (stream, line))
+	{
+		// path, modification time, class ID, name, category, tags...
+		auto fields = splitFields (line);
+		if (fields.size () < 5)
+			return false;
+
+		Entry entry;
+		entry.path = std::move (fields[0]);
+		entry.modificationTime = std::strtoll (fields[1].data (), nullptr, 10);
+		if (!entry.classID.fromString (fields[2].data ()))
+			return false;
+		entry.name = std::move (fields[3]);
+		entry.category = std::move (fields[4]);
+		for (size_t i = 5; i < fields.size (); ++i)
+			entry.tags.emplace_back (std::move (fields[i]));
+		newEntries.emplace_back (std::move (entry));
+	}
+	entries = std::move (newEntries);
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool PresetIndex::save (const std::string& indexPath) const
+{
+	std::ofstream stream (indexPath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!stream.is_open ())
+		return false;
+
+	stream << kIndexFileHeader << '\n';
+	for (const auto& entry : entries)
+	{
+		char8 classString[33] = {0};
+		entry.classID.toString (classString);
+
+		stream << escapeField (entry.path) << '\t' << entry.modificationTime << '\t'
+		       << classString << '\t' << escapeField (entry.name) << '\t'
+		       << escapeField (entry.category);
+		for (const auto& tag : entry.tags)
+			stream << '\t' << escapeField (tag);
+		stream << '\n';
+	}
+	return stream.good ();
+}
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
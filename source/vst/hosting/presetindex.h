@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/presetindex.h
+// Created by  : Steinberg, 10/2026
+// Description : Parallel VST 3 preset library indexer with on-disk cache
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "pluginterfaces/base/funknown.h"
+
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** Index of a VST 3 preset library.
+ *
+ *	Scans directories for .vstpreset files on a thread pool. For each file only the header,
+ *	the chunk list and the meta info ('Info') chunk are read, the component and controller
+ *	states are never touched. The index can be saved to and loaded from disk, a file is only
+ *	parsed again when its modification time changed.
+ *
+ *	Example:
+ *	\code{.cpp}
+ *	PresetIndex index;
+ *	index.load (cachePath);
+ *	index.scan ({userPresetFolder, factoryPresetFolder});
+ *	index.save (cachePath);
+ *	auto presets = index.find (processorClassID, "Warm");
+ *	\endcode
+\ingroup hostingBase
+*/
+class PresetIndex
+{
+public:
+	/** An indexed preset */
+	struct Entry
+	{
+		std::string path;
+		int64 modificationTime {0};
+		FUID classID;				///< component (processor) class ID
+		std::string name;			///< PresetAttributes::kName or the file name
+		std::string category;		///< PresetAttributes::kInstrument
+		std::vector<std::string> tags; ///< PresetAttributes::kCharacter and kStyle
+
+		bool hasTag (const std::string& tag) const;
+	};
+	using EntryList = std::vector<Entry>;
+	using PathList = std::vector<std::string>;
+
+	/** Statistics of the last scan */
+	struct ScanResult
+	{
+		uint32 numFiles {0};	///< number of preset files found
+		uint32 numParsed {0};	///< number of files which were (re-)read
+		uint32 numCached {0};	///< number of files taken unchanged from the index
+		uint32 numFailed {0};	///< number of files which could not be read
+	};
+
+	/** Scans the directories recursively, numThreads == 0 uses the number of hardware threads.
+	 *	Entries of files which do not exist anymore are removed. */
+	ScanResult scan (const PathList& directories, uint32 numThreads = 0);
+
+	/** Returns all presets for the given class ID, optionally only the ones with the given tag */
+	EntryList find (const FUID& classID, const std::string& tag = {}) const;
+
+	const EntryList& getEntries () const { return entries; }
+	void clear () { entries.clear (); }
+
+	/** Loads an index file previously written with save () */
+	bool load (const std::string& indexPath);
+	/** Writes the index to disk */
+	bool save (const std::string& indexPath) const;
+
+	/** Reads the class ID and the meta info of a single preset file */
+	static bool readEntry (const std::string& path, Entry& entry);
+
+//------------------------------------------------------------------------
+private:
+	EntryList entries;
+};
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
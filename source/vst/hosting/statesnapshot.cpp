@@ -0,0 +1,323 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/statesnapshot.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Differential plug-in state snapshots for autosave and undo
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "statesnapshot.h"
+
+#include "public.sdk/source/vst/utility/memoryibstream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+inline bool verify (tresult result)
+{
+	return result == kResultOk || result == kNotImplemented;
+}
+
+//------------------------------------------------------------------------
+uint64 hashBlock (const uint8* data, size_t size)
+{
+	constexpr uint64 kPrime = 0x100000001B3ull;
+	uint64 hash = 0xCBF29CE484222325ull ^ size;
+	size_t i = 0;
+	for (; i + sizeof (uint64) <= size; i += sizeof (uint64))
+	{
+		uint64 word;
+		memcpy (&word, data + i, sizeof (uint64));
+		hash = (hash ^ word) * kPrime;
+		hash ^= hash >> 29;
+	}
+	for (; i < size; ++i)
+		hash = (hash ^ data[i]) * kPrime;
+	return hash ^ (hash >> 32);
+}
+
+//------------------------------------------------------------------------
+bool serializeStates (IComponent* component, IEditController* controller,
+                      ResizableMemoryIBStream& componentStream,
+                      ResizableMemoryIBStream& controllerStream)
+{
+	if (!component || !verify (component->getState (&componentStream)))
+		return false;
+	if (controller && !verify (controller->getState (&controllerStream)))
+		return false;
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+StateSnapshotStore::StateSnapshotStore (size_t blockSize)
+: blockSize (std::max<size_t> (blockSize, 64))
+{
+}
+
+//------------------------------------------------------------------------
+StateSnapshotStore::~StateSnapshotStore () noexcept
+{
+	backgroundThread.waitAll ();
+}
+
+//------------------------------------------------------------------------
+auto StateSnapshotStore::takeSnapshot (IComponent* component, IEditController* controller)
+    -> SnapshotID
+{
+	ResizableMemoryIBStream componentStream;
+	ResizableMemoryIBStream controllerStream;
+	if (!serializeStates (component, controller, componentStream, controllerStream))
+		return kInvalidSnapshotID;
+	return addSnapshot (componentStream.getData (), componentStream.getSize (),
+	                    controllerStream.getData (), controllerStream.getSize ());
+}
+
+//------------------------------------------------------------------------
+auto StateSnapshotStore::takeSnapshotAsync (IComponent* component, IEditController* controller,
+                                            bool serializeOnBackgroundThread)
+    -> std::future<SnapshotID>
+{
+	auto promise = std::make_shared<std::promise<SnapshotID>> ();
+	auto future = promise->get_future ();
+
+	if (serializeOnBackgroundThread)
+	{
+		IPtr<IComponent> componentPtr (component);
+		IPtr<IEditController> controllerPtr (controller);
+		backgroundThread.addTask ([this, promise, componentPtr, controllerPtr] () {
+			promise->set_value (takeSnapshot (componentPtr, controllerPtr));
+		});
+		return future;
+	}
+
+	auto componentStream = owned (new ResizableMemoryIBStream);
+	auto controllerStream = owned (new ResizableMemoryIBStream);
+	if (!serializeStates (component, controller, *componentStream, *controllerStream))
+	{
+		promise->set_value (kInvalidSnapshotID);
+		return future;
+	}
+	backgroundThread.addTask ([this, promise, componentStream, controllerStream] () {
+		promise->set_value (addSnapshot (componentStream->getData (), componentStream->getSize (),
+		                                 controllerStream->getData (),
+		                                 controllerStream->getSize ()));
+	});
+	return future;
+}
+
+//------------------------------------------------------------------------
+auto StateSnapshotStore::addSnapshot (const void* componentState, size_t componentStateSize,
+                                      const void* controllerState, size_t controllerStateSize)
+    -> SnapshotID
+{
+	if ((componentStateSize && !componentState) || (controllerStateSize && !controllerState))
+		return kInvalidSnapshotID;
+
+	Snapshot snapshot;
+	snapshot.componentSize = componentStateSize;
+	snapshot.controllerSize = controllerStateSize;
+
+	std::lock_guard<std::mutex> lock (mutex);
+	statistics.lastNewBlocks = 0;
+	statistics.lastReusedBlocks = 0;
+	addBlocks (static_cast<const uint8*> (componentState), componentStateSize,
+	           snapshot.componentBlocks);
+	addBlocks (static_cast<const uint8*> (controllerState), controllerStateSize,
+	           snapshot.controllerBlocks);
+
+	auto id = nextID++;
+	snapshots.emplace (id, std::move (snapshot));
+	statistics.numSnapshots = snapshots.size ();
+	statistics.numBlocks = blocks.size ();
+	return id;
+}
+
+//------------------------------------------------------------------------
+void StateSnapshotStore::addBlocks (const uint8* data, size_t size, BlockList& blockList)
+{
+	blockList.reserve ((size + blockSize - 1) / blockSize);
+	for (size_t offset = 0; offset < size; offset += blockSize)
+	{
+		auto blockData = data + offset;
+		auto blockDataSize = std::min (blockSize, size - offset);
+		auto hash = hashBlock (blockData, blockDataSize);
+
+		BlockPtr block;
+		auto range = blocks.equal_range (hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			const auto& candidate = it->second->data;
+			if (candidate.size () == blockDataSize &&
+			    memcmp (candidate.data (), blockData, blockDataSize) == 0)
+			{
+				block = it->second;
+				break;
+			}
+		}
+		if (block)
+		{
+			++statistics.lastReusedBlocks;
+		}
+		else
+		{
+			block = std::make_shared<Block> ();
+			block->hash = hash;
+			block->data.assign (blockData, blockData + blockDataSize);
+			blocks.emplace (hash, block);
+			statistics.storedBytes += blockDataSize;
+			++statistics.lastNewBlocks;
+		}
+		++block->refCount;
+		blockList.emplace_back (std::move (block));
+	}
+}
+
+//------------------------------------------------------------------------
+void StateSnapshotStore::releaseBlocks (const BlockList& blockList)
+{
+	for (const auto& block : blockList)
+	{
+		if (--block->refCount > 0)
+			continue;
+		auto range = blocks.equal_range (block->hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second != block)
+				continue;
+			statistics.storedBytes -= block->data.size ();
+			blocks.erase (it);
+			break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+void StateSnapshotStore::copyBlocks (const BlockList& blockList, size_t size,
+                                     std::vector<uint8>& data)
+{
+	data.clear ();
+	data.reserve (size);
+	for (const auto& block : blockList)
+		data.insert (data.end (), block->data.begin (), block->data.end ());
+}
+
+//------------------------------------------------------------------------
+void StateSnapshotStore::writeBlocks (const BlockList& blockList, size_t size,
+                                      ResizableMemoryIBStream& stream)
+{
+	stream.reserve (size);
+	for (const auto& block : blockList)
+		stream.write (block->data.data (), static_cast<int32> (block->data.size ()), nullptr);
+}
+
+//------------------------------------------------------------------------
+bool StateSnapshotStore::getSnapshotData (SnapshotID id, std::vector<uint8>& componentState,
+                                          std::vector<uint8>& controllerState) const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	auto it = snapshots.find (id);
+	if (it == snapshots.end ())
+		return false;
+	copyBlocks (it->second.componentBlocks, it->second.componentSize, componentState);
+	copyBlocks (it->second.controllerBlocks, it->second.controllerSize, controllerState);
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool StateSnapshotStore::restoreSnapshot (SnapshotID id, IComponent* component,
+                                          IEditController* controller) const
+{
+	if (!component)
+		return false;
+
+	ResizableMemoryIBStream componentStream;
+	ResizableMemoryIBStream controllerStream;
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		auto it = snapshots.find (id);
+		if (it == snapshots.end ())
+			return false;
+		writeBlocks (it->second.componentBlocks, it->second.componentSize, componentStream);
+		writeBlocks (it->second.controllerBlocks, it->second.controllerSize, controllerStream);
+	}
+
+	componentStream.rewind ();
+	if (!verify (component->setState (&componentStream)))
+		return false;
+
+	if (controller)
+	{
+		componentStream.rewind ();
+		if (!verify (controller->setComponentState (&componentStream)))
+			return false;
+		if (controllerStream.getSize () > 0)
+		{
+			controllerStream.rewind ();
+			if (!verify (controller->setState (&controllerStream)))
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool StateSnapshotStore::removeSnapshot (SnapshotID id)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	auto it = snapshots.find (id);
+	if (it == snapshots.end ())
+		return false;
+	releaseBlocks (it->second.componentBlocks);
+	releaseBlocks (it->second.controllerBlocks);
+	snapshots.erase (it);
+	statistics.numSnapshots = snapshots.size ();
+	statistics.numBlocks = blocks.size ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+auto StateSnapshotStore::getStatistics () const -> Statistics
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return statistics;
+}
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
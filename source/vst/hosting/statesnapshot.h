@@ -0,0 +1,153 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/statesnapshot.h
+// Created by  : Steinberg, 10/2026
+// Description : Differential plug-in state snapshots for autosave and undo
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "public.sdk/source/vst/hosting/threadpool.h"
+#include "pluginterfaces/base/smartpointer.h"
+#include "pluginterfaces/vst/ivstcomponent.h"
+#include "pluginterfaces/vst/ivsteditcontroller.h"
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+class ResizableMemoryIBStream;
+
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** Store for plug-in state snapshots which only keeps changed data.
+ *
+ *	The component and controller states are split into blocks of a fixed size. Every block is
+ *	stored once in a content addressed store, a snapshot is the list of its blocks. Taking a
+ *	snapshot of a plug-in whose state did not change therefore does not need any new memory,
+ *	only blocks which changed since the last snapshot are added.
+ *
+ *	Hashing and storing the blocks is done on a background thread. Calling getState on the
+ *	background thread too is only done when the caller allows it (the VST 3 API defines
+ *	getState as UI thread call, a host should only allow it for plug-ins known to support it).
+ *
+ *	\code{.cpp}
+ *	StateSnapshotStore store;
+ *	// every few seconds:
+ *	auto id = store.takeSnapshotAsync (component, controller, false).get ();
+ *	// undo:
+ *	store.restoreSnapshot (id, component, controller);
+ *	\endcode
+\ingroup hostingBase
+*/
+class StateSnapshotStore
+{
+public:
+	using SnapshotID = uint64;
+	static constexpr SnapshotID kInvalidSnapshotID = 0;
+	static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+	explicit StateSnapshotStore (size_t blockSize = kDefaultBlockSize);
+	~StateSnapshotStore () noexcept;
+
+	/** serialises the states on the calling thread and stores them */
+	SnapshotID takeSnapshot (IComponent* component, IEditController* controller = nullptr);
+	/** stores the states on the background thread. If serializeOnBackgroundThread is false
+	 *	getState is called on the calling thread and only the storing is done in the background. */
+	std::future<SnapshotID> takeSnapshotAsync (IComponent* component,
+	                                           IEditController* controller = nullptr,
+	                                           bool serializeOnBackgroundThread = false);
+	/** stores already serialised states */
+	SnapshotID addSnapshot (const void* componentState, size_t componentStateSize,
+	                        const void* controllerState = nullptr, size_t controllerStateSize = 0);
+
+	/** applies the states of the snapshot to the component and the controller */
+	bool restoreSnapshot (SnapshotID id, IComponent* component,
+	                      IEditController* controller = nullptr) const;
+	/** copies the states of the snapshot */
+	bool getSnapshotData (SnapshotID id, std::vector<uint8>& componentState,
+	                      std::vector<uint8>& controllerState) const;
+	/** removes a snapshot, blocks not used by other snapshots are freed */
+	bool removeSnapshot (SnapshotID id);
+
+	struct Statistics
+	{
+		size_t numSnapshots {0};
+		size_t numBlocks {0};		///< number of unique blocks in the store
+		size_t storedBytes {0};		///< memory used by the unique blocks
+		size_t lastNewBlocks {0};	///< blocks added by the last snapshot
+		size_t lastReusedBlocks {0}; ///< blocks of the last snapshot already in the store
+	};
+	Statistics getStatistics () const;
+
+//------------------------------------------------------------------------
+private:
+	struct Block
+	{
+		uint64 hash;
+		std::vector<uint8> data;
+		uint32 refCount {0};
+	};
+	using BlockPtr = std::shared_ptr<Block>;
+	using BlockList = std::vector<BlockPtr>;
+
+	struct Snapshot
+	{
+		BlockList componentBlocks;
+		BlockList controllerBlocks;
+		size_t componentSize {0};
+		size_t controllerSize {0};
+	};
+
+	void addBlocks (const uint8* data, size_t size, BlockList& blocks);
+	void releaseBlocks (const BlockList& blocks);
+	static void copyBlocks (const BlockList& blocks, size_t size, std::vector<uint8>& data);
+	static void writeBlocks (const BlockList& blocks, size_t size, ResizableMemoryIBStream& stream);
+
+	const size_t blockSize;
+	mutable std::mutex mutex;
+	std::unordered_multimap<uint64, BlockPtr> blocks;
+	std::map<SnapshotID, Snapshot> snapshots;
+	SnapshotID nextID {1};
+	Statistics statistics;
+	ThreadPool backgroundThread {1};
+};
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
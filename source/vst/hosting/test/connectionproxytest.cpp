@@ -44,7 +44,9 @@
 #include <condition_variable>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -68,9 +70,15 @@ public:
 		return kResultTrue;
 	}
 
-	tresult PLUGIN_API notify (IMessage*) override
+	tresult PLUGIN_API notify (IMessage* message) override
 	{
 		messageReceived = true;
+		lastMessage = message;
+		messageIDs.emplace_back (message->getMessageID () ? message->getMessageID () : "");
+		int64 value = 0;
+		if (message->getAttributes () &&
+		    message->getAttributes ()->getInt ("Value", value) == kResultTrue)
+			values.push_back (value);
 		return kResultTrue;
 	}
 
@@ -80,8 +88,19 @@ public:
 
 	IConnectionPoint* other {nullptr};
 	bool messageReceived {false};
+	IMessage* lastMessage {nullptr};
+	std::vector<std::string> messageIDs;
+	std::vector<int64> values;
 };
 
+//------------------------------------------------------------------------
+template <typename Proc>
+void runOnThread (Proc proc)
+{
+	std::thread thread (proc);
+	thread.join ();
+}
+
 //------------------------------------------------------------------------
 ModuleInitializer ConnectionProxyTests ([] () {
 	constexpr auto TestSuiteName = "ConnectionProxy";
@@ -140,6 +159,228 @@ ModuleInitializer ConnectionProxyTests ([] () {
 		thread.join ();
 		return true;
 	});
+	registerTest (TestSuiteName, STR ("Queue message from 2nd thread"), [] (ITestResult* testResult) {
+		ConnectionPoint cp1;
+		ConnectionPoint cp2;
+		ConnectionProxy proxy (&cp1);
+		proxy.setQueued (true);
+		EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+
+		tresult notifyResult = kResultFalse;
+		runOnThread ([&] () {
+			auto msg = owned (new HostMessage);
+			msg->setMessageID ("Thread");
+			notifyResult = proxy.notify (msg);
+		});
+		EXPECT_EQ (notifyResult, kResultTrue);
+		EXPECT_FALSE (cp2.messageReceived);
+		EXPECT_EQ (proxy.drainQueue (), 1u);
+		EXPECT_EQ (cp2.messageIDs.size (), 1u);
+		EXPECT_EQ (cp2.messageIDs[0], "Thread");
+		EXPECT_EQ (proxy.drainQueue (), 0u);
+
+		auto statistics = proxy.getQueueStatistics ();
+		EXPECT_EQ (statistics.numQueued, 1u);
+		EXPECT_EQ (statistics.numDelivered, 1u);
+		EXPECT_EQ (statistics.highWaterMark, 1u);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Queued messages keep their order"),
+	              [] (ITestResult* testResult) {
+		              ConnectionPoint cp1;
+		              ConnectionPoint cp2;
+		              ConnectionProxy proxy (&cp1);
+		              proxy.setQueued (true);
+		              EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		              runOnThread ([&] () {
+			              auto msg = owned (new HostMessage);
+			              msg->setMessageID ("First");
+			              proxy.notify (msg);
+		              });
+		              HostMessage msg;
+		              msg.setMessageID ("Second");
+		              EXPECT_EQ (proxy.notify (&msg), kResultTrue);
+		              EXPECT_EQ (cp2.messageIDs.size (), 2u);
+		              EXPECT_EQ (cp2.messageIDs[0], "First");
+		              EXPECT_EQ (cp2.messageIDs[1], "Second");
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Queue messages from several threads"),
+	              [] (ITestResult* testResult) {
+		              ConnectionPoint cp1;
+		              ConnectionPoint cp2;
+		              ConnectionProxy proxy (&cp1);
+		              proxy.setQueued (true, 4096);
+		              EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		              std::vector<std::thread> threads;
+		              for (auto i = 0; i < 4; ++i)
+		              {
+			              threads.emplace_back ([&] () {
+				              auto msg = owned (new HostMessage);
+				              for (auto j = 0; j < 1000; ++j)
+					              proxy.notify (msg);
+			              });
+		              }
+		              uint32 numDelivered = 0;
+		              while (numDelivered < 4000)
+			              numDelivered += proxy.drainQueue ();
+		              for (auto& thread : threads)
+			              thread.join ();
+		              EXPECT_EQ (cp2.messageIDs.size (), 4000u);
+		              EXPECT_EQ (proxy.getQueueStatistics ().numRejected, 0u);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Coalesce queued messages"), [] (ITestResult* testResult) {
+		ConnectionPoint cp1;
+		ConnectionPoint cp2;
+		ConnectionProxy proxy (&cp1);
+		proxy.setQueued (true);
+		proxy.addCoalescedMessageID ("Meter");
+		EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		runOnThread ([&] () {
+			for (auto id : {"Meter", "Data", "Meter", "Data", "Meter"})
+			{
+				auto msg = owned (new HostMessage);
+				msg->setMessageID (id);
+				proxy.notify (msg);
+			}
+		});
+		EXPECT_EQ (proxy.drainQueue (), 3u);
+		EXPECT_EQ (cp2.messageIDs.size (), 3u);
+		EXPECT_EQ (cp2.messageIDs[0], "Data");
+		EXPECT_EQ (cp2.messageIDs[1], "Data");
+		EXPECT_EQ (cp2.messageIDs[2], "Meter");
+		EXPECT_EQ (proxy.getQueueStatistics ().numCoalesced, 2u);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Reject messages when queue is full"),
+	              [] (ITestResult* testResult) {
+		              ConnectionPoint cp1;
+		              ConnectionPoint cp2;
+		              ConnectionProxy proxy (&cp1);
+		              proxy.setQueued (true, 4);
+		              EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		              std::vector<tresult> results;
+		              runOnThread ([&] () {
+			              auto msg = owned (new HostMessage);
+			              for (auto i = 0; i < 6; ++i)
+				              results.push_back (proxy.notify (msg));
+		              });
+		              EXPECT_EQ (results[3], kResultTrue);
+		              EXPECT_EQ (results[4], kOutOfMemory);
+		              auto statistics = proxy.getQueueStatistics ();
+		              EXPECT_EQ (statistics.numQueued, 4u);
+		              EXPECT_EQ (statistics.numRejected, 2u);
+		              EXPECT_EQ (statistics.highWaterMark, 4u);
+		              EXPECT_EQ (proxy.drainQueue (), 4u);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Queued messages are copies"), [] (ITestResult* testResult) {
+		ConnectionPoint cp1;
+		ConnectionPoint cp2;
+		ConnectionProxy proxy (&cp1);
+		proxy.setQueued (true);
+		EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		runOnThread ([&] () {
+			auto msg = owned (new HostMessage);
+			msg->setMessageID ("Before");
+			msg->getAttributes ()->setInt ("Value", 1);
+			proxy.notify (msg);
+			// the sender reuses its message
+			msg->setMessageID ("After");
+			msg->getAttributes ()->setInt ("Value", 2);
+			proxy.notify (msg);
+		});
+		EXPECT_EQ (proxy.drainQueue (), 2u);
+		EXPECT_EQ (cp2.messageIDs.size (), 2u);
+		EXPECT_EQ (cp2.messageIDs[0], "Before");
+		EXPECT_EQ (cp2.messageIDs[1], "After");
+		EXPECT_EQ (cp2.values.size (), 2u);
+		EXPECT_EQ (cp2.values[0], 1);
+		EXPECT_EQ (cp2.values[1], 2);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Queued copies do not use the message pool"),
+	              [] (ITestResult* testResult) {
+		              HostApplication hostApp;
+		              TUID iid;
+		              IMessage::iid.toTUID (iid);
+		              ConnectionPoint cp1;
+		              ConnectionPoint cp2;
+		              ConnectionProxy proxy (&cp1);
+		              proxy.setQueued (true, 1);
+		              EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		              IMessage* msg {nullptr};
+		              EXPECT_EQ (hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&msg)),
+		                         kResultTrue);
+		              msg->setMessageID ("Pooled");
+		              runOnThread ([&] () { proxy.notify (msg); });
+		              EXPECT_EQ (proxy.drainQueue (), 1u);
+		              auto queuedMessage = cp2.lastMessage;
+		              EXPECT_NE (queuedMessage, msg);
+		              msg->release ();
+
+		              // the pool (which locks) only got back the sent message, the copy was made
+		              // into a message of the queue
+		              IMessage* first {nullptr};
+		              IMessage* second {nullptr};
+		              hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&first));
+		              hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&second));
+		              EXPECT_EQ (first, msg);
+		              EXPECT_NE (second, queuedMessage);
+
+		              // and this message is reused for the next copy
+		              runOnThread ([&] () { proxy.notify (first); });
+		              EXPECT_EQ (proxy.drainQueue (), 1u);
+		              EXPECT_EQ (cp2.lastMessage, queuedMessage);
+		              EXPECT_EQ (cp2.messageIDs.size (), 2u);
+		              EXPECT_EQ (cp2.messageIDs[1], "");
+		              first->release ();
+		              second->release ();
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Change queued mode on UI thread only"),
+	              [] (ITestResult* testResult) {
+		              ConnectionPoint cp1;
+		              ConnectionPoint cp2;
+		              ConnectionProxy proxy (&cp1);
+		              EXPECT_TRUE (proxy.setQueued (true));
+		              EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		              bool result = true;
+		              runOnThread ([&] () {
+			              auto msg = owned (new HostMessage);
+			              msg->setMessageID ("Thread");
+			              proxy.notify (msg);
+			              result = proxy.setQueued (false);
+		              });
+		              EXPECT_FALSE (result);
+		              EXPECT_TRUE (proxy.isQueued ());
+		              EXPECT_TRUE (cp2.messageIDs.empty ());
+
+		              // disabling the queued mode delivers the pending message
+		              EXPECT_TRUE (proxy.setQueued (false));
+		              EXPECT_FALSE (proxy.isQueued ());
+		              EXPECT_EQ (cp2.messageIDs.size (), 1u);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Count only delivered messages"),
+	              [] (ITestResult* testResult) {
+		              ConnectionPoint cp1;
+		              ConnectionPoint cp2;
+		              ConnectionProxy proxy (&cp1);
+		              proxy.setQueued (true);
+		              EXPECT_EQ (proxy.connect (&cp2), kResultTrue);
+		              runOnThread ([&] () {
+			              auto msg = owned (new HostMessage);
+			              proxy.notify (msg);
+		              });
+		              EXPECT_TRUE (proxy.disconnect ());
+		              EXPECT_EQ (proxy.drainQueue (), 0u);
+		              auto statistics = proxy.getQueueStatistics ();
+		              EXPECT_EQ (statistics.numQueued, 1u);
+		              EXPECT_EQ (statistics.numDelivered, 0u);
+		              return true;
+	              });
 });
 
 //------------------------------------------------------------------------
@@ -41,6 +41,8 @@
 #include "pluginterfaces/base/fstrdefs.h"
 
 #include <array>
+#include <string>
+#include <thread>
 #include <vector>
 
 //------------------------------------------------------------------------
@@ -74,6 +76,80 @@ ModuleInitializer HostApplicationTests ([] () {
 		instance->release ();
 		return true;
 	});
+	registerTest (TestSuiteName, STR ("Recycle IMessage"), [] (ITestResult* testResult) {
+		HostApplication hostApp;
+		TUID iid;
+		IMessage::iid.toTUID (iid);
+		IMessage* message {nullptr};
+		EXPECT_EQ (hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&message)),
+		           kResultTrue);
+		message->setMessageID ("Test");
+		EXPECT_EQ (message->getAttributes ()->setInt ("Int", 1), kResultTrue);
+		auto firstMessage = message;
+		message->release ();
+
+		EXPECT_EQ (hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&message)),
+		           kResultTrue);
+		EXPECT_EQ (message, firstMessage);
+		EXPECT_EQ (message->getMessageID (), nullptr);
+		int64 value = 0;
+		EXPECT_EQ (message->getAttributes ()->getInt ("Int", value), kResultFalse);
+		message->release ();
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Recycled IMessage keeps shared attributes"),
+	              [] (ITestResult* testResult) {
+		              HostApplication hostApp;
+		              TUID iid;
+		              IMessage::iid.toTUID (iid);
+		              IMessage* message {nullptr};
+		              EXPECT_EQ (
+		                  hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&message)),
+		                  kResultTrue);
+		              IPtr<IAttributeList> attributes = message->getAttributes ();
+		              EXPECT_EQ (attributes->setInt ("Int", 1), kResultTrue);
+		              message->release ();
+
+		              int64 value = 0;
+		              EXPECT_EQ (attributes->getInt ("Int", value), kResultTrue);
+		              EXPECT_EQ (value, 1);
+		              EXPECT_EQ (
+		                  hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&message)),
+		                  kResultTrue);
+		              EXPECT_NE (message->getAttributes (), attributes.get ());
+		              message->release ();
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Release IMessage on several threads"),
+	              [] (ITestResult* testResult) {
+		              HostApplication hostApp;
+		              TUID iid;
+		              IMessage::iid.toTUID (iid);
+		              constexpr int32 numThreads = 4;
+		              for (int32 round = 0; round < 200; ++round)
+		              {
+			              IMessage* message {nullptr};
+			              EXPECT_EQ (hostApp.createInstance (
+			                             iid, iid, reinterpret_cast<void**> (&message)),
+			                         kResultTrue);
+			              message->getAttributes ()->setInt ("Round", round);
+			              for (int32 i = 1; i < numThreads; ++i)
+				              message->addRef ();
+			              std::vector<std::thread> threads;
+			              for (int32 i = 0; i < numThreads; ++i)
+				              threads.emplace_back ([message] () { message->release (); });
+			              for (auto& thread : threads)
+				              thread.join ();
+		              }
+		              IMessage* message {nullptr};
+		              EXPECT_EQ (
+		                  hostApp.createInstance (iid, iid, reinterpret_cast<void**> (&message)),
+		                  kResultTrue);
+		              int64 value = 0;
+		              EXPECT_EQ (message->getAttributes ()->getInt ("Round", value), kResultFalse);
+		              message->release ();
+		              return true;
+	              });
 });
 
 //------------------------------------------------------------------------
@@ -136,6 +212,78 @@ ModuleInitializer HostAttributeListTests ([] () {
 		EXPECT_EQ (value, testValue3);
 		return true;
 	});
+	registerTest (TestSuiteName, STR ("Change Type"), [] (ITestResult* testResult) {
+		auto attrList = HostAttributeList::make ();
+		EXPECT_EQ (attrList->setInt ("Value", 5), kResultTrue);
+		EXPECT_EQ (attrList->setFloat ("Value", 0.5), kResultTrue);
+		int64 intValue = 0;
+		EXPECT_EQ (attrList->getInt ("Value", intValue), kResultFalse);
+		double floatValue = 0.;
+		EXPECT_EQ (attrList->getFloat ("Value", floatValue), kResultTrue);
+		EXPECT_EQ (floatValue, 0.5);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Large Binary"), [] (ITestResult* testResult) {
+		auto attrList = HostAttributeList::make ();
+		std::vector<uint8> testData (1000);
+		for (size_t i = 0; i < testData.size (); ++i)
+			testData[i] = static_cast<uint8> (i);
+		EXPECT_EQ (attrList->setBinary ("Binary", testData.data (), 8), kResultTrue);
+		EXPECT_EQ (attrList->setBinary ("Binary", testData.data (),
+		                                static_cast<uint32> (testData.size ())),
+		           kResultTrue);
+		const void* data;
+		uint32 dataSize {0};
+		EXPECT_EQ (attrList->getBinary ("Binary", data, dataSize), kResultTrue);
+		EXPECT_EQ (dataSize, static_cast<uint32> (testData.size ()));
+		EXPECT_EQ (memcmp (data, testData.data (), dataSize), 0);
+		EXPECT_EQ (attrList->setBinary ("Binary", testData.data () + 1, 4), kResultTrue);
+		EXPECT_EQ (attrList->getBinary ("Binary", data, dataSize), kResultTrue);
+		EXPECT_EQ (dataSize, 4u);
+		EXPECT_EQ (memcmp (data, testData.data () + 1, dataSize), 0);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Binary data stays valid when adding attributes"),
+	              [] (ITestResult* testResult) {
+		              auto attrList = HostAttributeList::make ();
+		              std::vector<uint8> testData (1000);
+		              for (size_t i = 0; i < testData.size (); ++i)
+			              testData[i] = static_cast<uint8> (i);
+		              EXPECT_EQ (attrList->setBinary ("Small", testData.data (), 8), kResultTrue);
+		              EXPECT_EQ (attrList->setBinary ("Large", testData.data (),
+		                                              static_cast<uint32> (testData.size ())),
+		                         kResultTrue);
+		              const void* smallData;
+		              const void* largeData;
+		              uint32 dataSize {0};
+		              EXPECT_EQ (attrList->getBinary ("Small", smallData, dataSize), kResultTrue);
+		              EXPECT_EQ (attrList->getBinary ("Large", largeData, dataSize), kResultTrue);
+		              for (auto i = 0; i < 100; ++i)
+		              {
+			              auto id = "Int" + std::to_string (i);
+			              EXPECT_EQ (attrList->setInt (id.data (), i), kResultTrue);
+		              }
+		              const void* data;
+		              EXPECT_EQ (attrList->getBinary ("Small", data, dataSize), kResultTrue);
+		              EXPECT_EQ (data, smallData);
+		              EXPECT_EQ (memcmp (smallData, testData.data (), 8), 0);
+		              EXPECT_EQ (attrList->getBinary ("Large", data, dataSize), kResultTrue);
+		              EXPECT_EQ (data, largeData);
+		              EXPECT_EQ (memcmp (largeData, testData.data (), dataSize), 0);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Equal IDs at different addresses"),
+	              [] (ITestResult* testResult) {
+		              auto attrList = HostAttributeList::make ();
+		              std::string id = "Int";
+		              EXPECT_EQ (attrList->setInt (id.data (), 5), kResultTrue);
+		              id = "Int";
+		              int64 value = 0;
+		              EXPECT_EQ (attrList->getInt ("Int", value), kResultTrue);
+		              EXPECT_EQ (value, 5);
+		              EXPECT_EQ (attrList->getInt ("In", value), kResultFalse);
+		              return true;
+	              });
 });
 
 //------------------------------------------------------------------------
@@ -220,6 +220,17 @@ ModuleInitializer ParameterChangeTransferTests ([] () {
 		EXPECT_EQ (change, test);
 		return true;
 	});
+	registerTest (TestSuiteName, STR ("Add change to full transfer"), [] (ITestResult* testResult) {
+		// room for twice the parameters, one slot is kept free to detect the full state
+		ParameterChangeTransfer transfer (1);
+		EXPECT_TRUE (transfer.addChange (1, 0.1, 0));
+		EXPECT_FALSE (transfer.addChange (1, 0.2, 0));
+		ParamChange test {};
+		EXPECT_TRUE (transfer.getNextChange (test.id, test.value, test.sampleOffset));
+		EXPECT_EQ (test.value, 0.1);
+		EXPECT_TRUE (transfer.addChange (1, 0.3, 0));
+		return true;
+	});
 	registerTest (TestSuiteName, STR ("Remove changes"), [] (ITestResult* testResult) {
 		ParameterChangeTransfer transfer (1);
 		ParamChange change {1, 0.8, 2};
@@ -0,0 +1,477 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/test/plugprovidertest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test plug-in provider
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/plugprovider.h"
+#include "public.sdk/source/vst/hosting/threadpool.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/fstrdefs.h"
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstcomponent.h"
+#include "pluginterfaces/vst/ivsteditcontroller.h"
+#include "pluginterfaces/vst/ivstmessage.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+const VST3::UID componentUID (0x1A2B3C4D, 0x11111111, 0x22222222, 0x33333333);
+const VST3::UID controllerUID (0x1A2B3C4D, 0x44444444, 0x55555555, 0x66666666);
+const VST3::UID missingUID (0x1A2B3C4D, 0x77777777, 0x88888888, 0x99999999);
+
+//------------------------------------------------------------------------
+/** Records the calls to the test plug-in in the order they arrive */
+struct CallLog
+{
+	void add (const std::string& call)
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		calls.push_back (call);
+	}
+	int32 indexOf (const std::string& call)
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		auto it = std::find (calls.begin (), calls.end (), call);
+		return it == calls.end () ? -1 : static_cast<int32> (it - calls.begin ());
+	}
+	int32 count (const std::string& call)
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		return static_cast<int32> (std::count (calls.begin (), calls.end (), call));
+	}
+	void clear ()
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		calls.clear ();
+	}
+
+	std::mutex mutex;
+	std::vector<std::string> calls;
+};
+
+//------------------------------------------------------------------------
+bool readInt (IBStream* stream, int32& value)
+{
+	int32 numRead = 0;
+	return stream && stream->read (&value, sizeof (value), &numRead) == kResultTrue &&
+	       numRead == sizeof (value);
+}
+
+//------------------------------------------------------------------------
+class TestComponent
+: public U::Implements<U::Directly<IComponent, IAudioProcessor, IConnectionPoint>,
+                       U::Indirectly<IPluginBase>>
+{
+public:
+	TestComponent (CallLog& log) : log (log) {}
+
+	//--- IPluginBase
+	tresult PLUGIN_API initialize (FUnknown*) override
+	{
+		log.add ("component initialize");
+		return kResultOk;
+	}
+	tresult PLUGIN_API terminate () override { return kResultOk; }
+
+	//--- IComponent
+	tresult PLUGIN_API getControllerClassId (TUID classId) override
+	{
+		memcpy (classId, controllerUID.data (), sizeof (TUID));
+		return kResultTrue;
+	}
+	tresult PLUGIN_API setIoMode (IoMode) override { return kNotImplemented; }
+	int32 PLUGIN_API getBusCount (MediaType, BusDirection) override { return 0; }
+	tresult PLUGIN_API getBusInfo (MediaType, BusDirection, int32, BusInfo&) override
+	{
+		return kInvalidArgument;
+	}
+	tresult PLUGIN_API getRoutingInfo (RoutingInfo&, RoutingInfo&) override
+	{
+		return kNotImplemented;
+	}
+	tresult PLUGIN_API activateBus (MediaType, BusDirection, int32, TBool) override
+	{
+		return kInvalidArgument;
+	}
+	tresult PLUGIN_API setActive (TBool state) override
+	{
+		log.add (state ? "setActive" : "setInactive");
+		return kResultOk;
+	}
+	tresult PLUGIN_API setState (IBStream* state) override
+	{
+		return readInt (state, value) ? kResultTrue : kResultFalse;
+	}
+	tresult PLUGIN_API getState (IBStream* state) override
+	{
+		return state->write (&value, sizeof (value), nullptr);
+	}
+
+	//--- IAudioProcessor
+	tresult PLUGIN_API setBusArrangements (SpeakerArrangement*, int32, SpeakerArrangement*,
+	                                       int32) override
+	{
+		return kResultFalse;
+	}
+	tresult PLUGIN_API getBusArrangement (BusDirection, int32, SpeakerArrangement&) override
+	{
+		return kInvalidArgument;
+	}
+	tresult PLUGIN_API canProcessSampleSize (int32 size) override
+	{
+		return size == kSample32 ? kResultTrue : kResultFalse;
+	}
+	uint32 PLUGIN_API getLatencySamples () override { return 0; }
+	tresult PLUGIN_API setupProcessing (ProcessSetup&) override
+	{
+		log.add ("setupProcessing");
+		return kResultOk;
+	}
+	tresult PLUGIN_API setProcessing (TBool) override { return kResultOk; }
+	tresult PLUGIN_API process (ProcessData&) override
+	{
+		log.add ("process");
+		return kResultOk;
+	}
+	uint32 PLUGIN_API getTailSamples () override { return kNoTail; }
+
+	//--- IConnectionPoint
+	tresult PLUGIN_API connect (IConnectionPoint*) override
+	{
+		log.add ("component connect");
+		return kResultTrue;
+	}
+	tresult PLUGIN_API disconnect (IConnectionPoint*) override { return kResultTrue; }
+	tresult PLUGIN_API notify (IMessage*) override { return kResultTrue; }
+
+	CallLog& log;
+	int32 value {0};
+};
+
+//------------------------------------------------------------------------
+class TestController
+: public U::Implements<U::Directly<IEditController, IConnectionPoint>, U::Indirectly<IPluginBase>>
+{
+public:
+	TestController (CallLog& log) : log (log) {}
+
+	//--- IPluginBase
+	tresult PLUGIN_API initialize (FUnknown*) override
+	{
+		log.add ("controller initialize");
+		return kResultOk;
+	}
+	tresult PLUGIN_API terminate () override { return kResultOk; }
+
+	//--- IEditController
+	tresult PLUGIN_API setComponentState (IBStream* state) override
+	{
+		log.add ("setComponentState");
+		return readInt (state, componentValue) ? kResultTrue : kResultFalse;
+	}
+	tresult PLUGIN_API setState (IBStream* state) override
+	{
+		return readInt (state, value) ? kResultTrue : kResultFalse;
+	}
+	tresult PLUGIN_API getState (IBStream* state) override
+	{
+		return state->write (&value, sizeof (value), nullptr);
+	}
+	int32 PLUGIN_API getParameterCount () override { return 0; }
+	tresult PLUGIN_API getParameterInfo (int32, ParameterInfo&) override { return kResultFalse; }
+	tresult PLUGIN_API getParamStringByValue (ParamID, ParamValue, String128) override
+	{
+		return kResultFalse;
+	}
+	tresult PLUGIN_API getParamValueByString (ParamID, TChar*, ParamValue&) override
+	{
+		return kResultFalse;
+	}
+	ParamValue PLUGIN_API normalizedParamToPlain (ParamID, ParamValue value) override
+	{
+		return value;
+	}
+	ParamValue PLUGIN_API plainParamToNormalized (ParamID, ParamValue value) override
+	{
+		return value;
+	}
+	ParamValue PLUGIN_API getParamNormalized (ParamID) override { return 0.; }
+	tresult PLUGIN_API setParamNormalized (ParamID, ParamValue) override { return kResultFalse; }
+	tresult PLUGIN_API setComponentHandler (IComponentHandler*) override { return kResultOk; }
+	IPlugView* PLUGIN_API createView (FIDString) override { return nullptr; }
+
+	//--- IConnectionPoint
+	tresult PLUGIN_API connect (IConnectionPoint*) override
+	{
+		log.add ("controller connect");
+		return kResultTrue;
+	}
+	tresult PLUGIN_API disconnect (IConnectionPoint*) override { return kResultTrue; }
+	tresult PLUGIN_API notify (IMessage*) override { return kResultTrue; }
+
+	CallLog& log;
+	int32 componentValue {-1};
+	int32 value {0};
+};
+
+//------------------------------------------------------------------------
+/** Creates the test classes and checks that createInstance is never called concurrently */
+class TestFactory : public U::Implements<U::Directly<IPluginFactory>>
+{
+public:
+	tresult PLUGIN_API getFactoryInfo (PFactoryInfo*) override { return kNotImplemented; }
+	int32 PLUGIN_API countClasses () override { return 0; }
+	tresult PLUGIN_API getClassInfo (int32, PClassInfo*) override { return kInvalidArgument; }
+	tresult PLUGIN_API createInstance (FIDString cid, FIDString _iid, void** obj) override
+	{
+		if (++numConcurrentCalls > 1)
+			concurrentCalls = true;
+		// give other threads a chance to run into this function
+		std::this_thread::sleep_for (std::chrono::milliseconds (1));
+		*obj = nullptr;
+		if (componentUID == VST3::UID::fromTUID (cid) &&
+		    FUnknownPrivate::iidEqual (_iid, IComponent::iid))
+			*obj = static_cast<IComponent*> (new TestComponent (log));
+		else if (controllerUID == VST3::UID::fromTUID (cid) &&
+		         FUnknownPrivate::iidEqual (_iid, IEditController::iid))
+			*obj = static_cast<IEditController*> (new TestController (log));
+		--numConcurrentCalls;
+		return *obj ? kResultTrue : kNoInterface;
+	}
+
+	CallLog log;
+	std::atomic<int32> numConcurrentCalls {0};
+	std::atomic<bool> concurrentCalls {false};
+};
+
+//------------------------------------------------------------------------
+struct TestSetup
+{
+	TestSetup () : factory (owned (new TestFactory)), pluginFactory (factory) {}
+
+	PlugProvider::ClassInfo classInfo (const VST3::UID& uid = componentUID) const
+	{
+		PlugProvider::ClassInfo info;
+		info.get ().classID = uid;
+		info.get ().name = "Test";
+		return info;
+	}
+	IPtr<PlugProvider> makeProvider (const VST3::UID& uid = componentUID) const
+	{
+		return owned (new PlugProvider (pluginFactory, classInfo (uid)));
+	}
+	TestComponent* getComponent (PlugProvider& provider) const
+	{
+		return static_cast<TestComponent*> (provider.getComponentPtr ().get ());
+	}
+	TestController* getController (PlugProvider& provider) const
+	{
+		return static_cast<TestController*> (provider.getControllerPtr ().get ());
+	}
+
+	IPtr<TestFactory> factory;
+	PlugProvider::PluginFactory pluginFactory;
+	ThreadPool threadPool {4};
+};
+
+//------------------------------------------------------------------------
+PlugProvider::AsyncOptions workerOptions ()
+{
+	PlugProvider::AsyncOptions options;
+	options.canInitializeOnWorker = [] (const PlugProvider::ClassInfo&) { return true; };
+	options.warmUpBlockSize = 64;
+	options.warmUpProcessCalls = 2;
+	return options;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer PlugProviderTests ([] () {
+	constexpr auto TestSuiteName = "PlugProvider";
+	registerTest (TestSuiteName, STR ("Initialize on a worker thread"), [] (ITestResult* testResult) {
+		TestSetup setup;
+		auto provider = setup.makeProvider ();
+		EXPECT_TRUE (provider->initializeAsync (setup.threadPool, workerOptions ()));
+		EXPECT_FALSE (provider->initializeAsync (setup.threadPool, workerOptions ()));
+		EXPECT_TRUE (provider->waitForInitialize ());
+		EXPECT_TRUE (provider->getComponentPtr ());
+		EXPECT_TRUE (provider->getControllerPtr ());
+
+		// warming up starts when component and controller are connected and in sync
+		auto& log = setup.factory->log;
+		EXPECT_TRUE (log.indexOf ("component initialize") >= 0);
+		EXPECT_TRUE (log.indexOf ("controller initialize") >= 0);
+		auto setupProcessing = log.indexOf ("setupProcessing");
+		EXPECT_TRUE (setupProcessing > log.indexOf ("component connect"));
+		EXPECT_TRUE (setupProcessing > log.indexOf ("controller connect"));
+		EXPECT_TRUE (setupProcessing > log.indexOf ("setComponentState"));
+		EXPECT_TRUE (log.indexOf ("component connect") >= 0);
+		EXPECT_TRUE (log.indexOf ("setComponentState") >= 0);
+		EXPECT_EQ (log.count ("process"), 2);
+		EXPECT_TRUE (log.indexOf ("setInactive") > log.indexOf ("process"));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Initialize on the calling thread"),
+	              [] (ITestResult* testResult) {
+		              TestSetup setup;
+		              auto provider = setup.makeProvider ();
+		              PlugProvider::AsyncOptions options;
+		              options.warmUp = false;
+		              EXPECT_TRUE (provider->initializeAsync (setup.threadPool, options));
+		              // created before initializeAsync returns
+		              EXPECT_TRUE (setup.factory->log.indexOf ("component initialize") >= 0);
+		              EXPECT_EQ (setup.factory->log.indexOf ("component connect"), -1);
+		              EXPECT_TRUE (provider->waitForInitialize ());
+		              EXPECT_TRUE (setup.factory->log.indexOf ("component connect") >= 0);
+		              EXPECT_EQ (setup.factory->log.indexOf ("setupProcessing"), -1);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Initialize many plug-ins in parallel"),
+	              [] (ITestResult* testResult) {
+		              TestSetup setup;
+		              std::ostringstream errors;
+		              PlugProvider::setErrorStream (&errors);
+		              std::vector<IPtr<PlugProvider>> providers;
+		              for (auto i = 0; i < 16; ++i)
+		              {
+			              // every second class does not exist and prints an error
+			              providers.push_back (
+			                  setup.makeProvider (i % 2 ? missingUID : componentUID));
+			              providers.back ()->initializeAsync (setup.threadPool, workerOptions ());
+		              }
+		              for (auto i = 0; i < 16; ++i)
+			              EXPECT_EQ (providers[i]->waitForInitialize (), (i % 2 == 0));
+		              PlugProvider::setErrorStream (&std::cout);
+
+		              EXPECT_FALSE (setup.factory->concurrentCalls);
+		              std::string line;
+		              std::istringstream lines (errors.str ());
+		              int32 numErrors = 0;
+		              while (std::getline (lines, line))
+			              numErrors += line == "Failed to create component instance of Test!";
+		              EXPECT_EQ (numErrors, 8);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Clone the state"), [] (ITestResult* testResult) {
+		TestSetup setup;
+		auto provider = setup.makeProvider ();
+		EXPECT_TRUE (provider->initializeAsync (setup.threadPool, workerOptions ()));
+		EXPECT_TRUE (provider->waitForInitialize ());
+		setup.getComponent (*provider)->value = 42;
+		setup.getController (*provider)->value = 7;
+
+		auto clone = provider->clone (setup.threadPool, workerOptions ());
+		EXPECT_TRUE (clone);
+		EXPECT_TRUE (clone->waitForInitialize ());
+		EXPECT_EQ (setup.getComponent (*clone)->value, 42);
+		EXPECT_EQ (setup.getController (*clone)->componentValue, 42);
+		EXPECT_EQ (setup.getController (*clone)->value, 7);
+
+		// the state buffers are reused for the next clone
+		setup.getComponent (*provider)->value = 43;
+		auto secondClone = provider->clone (setup.threadPool, workerOptions ());
+		EXPECT_TRUE (secondClone->waitForInitialize ());
+		EXPECT_EQ (setup.getComponent (*secondClone)->value, 43);
+		EXPECT_EQ (setup.getController (*secondClone)->componentValue, 43);
+		EXPECT_EQ (setup.getComponent (*clone)->value, 42);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Take spare instances from the pool"),
+	              [] (ITestResult* testResult) {
+		              TestSetup setup;
+		              auto& log = setup.factory->log;
+		              {
+			              PlugProviderPool pool (setup.threadPool, workerOptions ());
+			              pool.setNumSpares (setup.pluginFactory, setup.classInfo (), 2);
+			              EXPECT_FALSE (pool.take (missingUID));
+
+			              auto spare = pool.take (componentUID);
+			              EXPECT_TRUE (spare);
+			              EXPECT_TRUE (spare->getComponentPtr ());
+			              EXPECT_TRUE (spare->getControllerPtr ());
+			              EXPECT_TRUE (log.indexOf ("component connect") >= 0);
+			              EXPECT_TRUE (log.indexOf ("setupProcessing") >= 0);
+
+			              pool.setNumSpares (setup.pluginFactory, setup.classInfo (), 0);
+			              EXPECT_FALSE (pool.take (componentUID));
+		              }
+		              // two spares and one replacement for the taken one
+		              EXPECT_EQ (log.count ("component initialize"), 3);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Clone into a spare instance"), [] (ITestResult* testResult) {
+		TestSetup setup;
+		auto& log = setup.factory->log;
+		auto provider = setup.makeProvider ();
+		EXPECT_TRUE (provider->initializeAsync (setup.threadPool, workerOptions ()));
+		EXPECT_TRUE (provider->waitForInitialize ());
+		setup.getComponent (*provider)->value = 42;
+		setup.getController (*provider)->value = 7;
+
+		IPtr<PlugProvider> clone;
+		{
+			PlugProviderPool pool (setup.threadPool, workerOptions ());
+			pool.setNumSpares (setup.pluginFactory, setup.classInfo (), 1);
+			clone = provider->clone (setup.threadPool, workerOptions (), &pool);
+			EXPECT_TRUE (clone);
+			auto numProcessCalls = log.count ("process");
+			EXPECT_TRUE (clone->waitForInitialize ());
+			// the spare was warmed up by the pool already
+			EXPECT_EQ (log.count ("process"), numProcessCalls);
+		}
+		EXPECT_EQ (setup.getComponent (*clone)->value, 42);
+		EXPECT_EQ (setup.getController (*clone)->componentValue, 42);
+		EXPECT_EQ (setup.getController (*clone)->value, 7);
+		// the original, the spare and its replacement
+		EXPECT_EQ (log.count ("component initialize"), 3);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,301 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/test/presetfiletest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test compressed preset state chunks
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/memoryibstream.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/vstpresetfile.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+const FUID testClassID (0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+
+//------------------------------------------------------------------------
+struct PresetFileReader : PresetFile
+{
+	using PresetFile::PresetFile;
+	using PresetFile::openStateStream;
+};
+
+//------------------------------------------------------------------------
+struct NullCodec : PresetCodec
+{
+	const ChunkID& getID () const override { return codecID; }
+	uint32 compress (const void*, uint32, void*, uint32) const override { return 0; }
+	bool decompress (const void*, uint32, void*, uint32) const override { return false; }
+
+	static constexpr ChunkID codecID = {'N', 'u', 'l', 'l'};
+};
+constexpr ChunkID NullCodec::codecID;
+
+//------------------------------------------------------------------------
+std::vector<uint8> makeState (size_t size)
+{
+	// text-like data: repeating words with some noise
+	static const char* words[] = {"Cutoff ", "Resonance ", "Attack ", "Release ", "Gain "};
+	std::vector<uint8> state;
+	state.reserve (size);
+	uint32 seed = 1;
+	while (state.size () < size)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		auto word = words[(seed >> 16) % 5];
+		while (*word && state.size () < size)
+			state.push_back (static_cast<uint8> (*word++));
+		if (state.size () < size)
+			state.push_back (static_cast<uint8> (seed >> 24));
+	}
+	return state;
+}
+
+//------------------------------------------------------------------------
+IPtr<ResizableMemoryIBStream> makeStream (const std::vector<uint8>& data)
+{
+	auto stream = owned (new ResizableMemoryIBStream);
+	stream->write (const_cast<uint8*> (data.data ()), static_cast<int32> (data.size ()), nullptr);
+	stream->rewind ();
+	return stream;
+}
+
+//------------------------------------------------------------------------
+std::vector<uint8> readAll (IBStream* stream)
+{
+	std::vector<uint8> result;
+	uint8 buffer[1000];
+	int32 numRead = 0;
+	while (stream->read (buffer, sizeof (buffer), &numRead), numRead > 0)
+		result.insert (result.end (), buffer, buffer + numRead);
+	return result;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer PresetFileTests ([] () {
+	constexpr auto TestSuiteName = "PresetFile";
+	registerTest (TestSuiteName, STR ("Default codec round trip"), [] (ITestResult* testResult) {
+		const auto& codec = PresetCodec::getDefault ();
+		for (auto size : {0u, 5u, 13u, 100u, 5000u, 65536u})
+		{
+			auto input = makeState (size);
+			std::vector<uint8> packed (size + size / 255 + 16);
+			auto packedSize = codec.compress (input.data (), size, packed.data (),
+			                                  static_cast<uint32> (packed.size ()));
+			EXPECT_TRUE (packedSize > 0);
+			std::vector<uint8> output (size);
+			EXPECT_TRUE (codec.decompress (packed.data (), packedSize, output.data (), size));
+			EXPECT_TRUE (output == input);
+			if (size == 65536u)
+			{
+				EXPECT_TRUE (packedSize < size / 2);
+				// corrupt data must be detected
+				EXPECT_FALSE (
+				    codec.decompress (packed.data (), packedSize - 1, output.data (), size));
+				EXPECT_FALSE (
+				    codec.decompress (packed.data (), packedSize, output.data (), size - 1));
+			}
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Default codec reports overflow"), [] (ITestResult* testResult) {
+		std::vector<uint8> input (1000);
+		uint32 seed = 7;
+		for (auto& value : input)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			value = static_cast<uint8> (seed >> 24);
+		}
+		std::vector<uint8> packed (input.size ());
+		EXPECT_EQ (PresetCodec::getDefault ().compress (input.data (), 1000, packed.data (), 999),
+		           0u);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Compressed state round trip"), [] (ITestResult* testResult) {
+		auto componentState = makeState (200000);
+		auto controllerState = makeState (300);
+		auto presetStream = owned (new ResizableMemoryIBStream);
+		EXPECT_TRUE (PresetFile::savePreset (presetStream, testClassID,
+		                                     makeStream (componentState),
+		                                     makeStream (controllerState), nullptr, -1,
+		                                     &PresetCodec::getDefault ()));
+		EXPECT_TRUE (presetStream->getSize () < componentState.size () / 2);
+
+		PresetFileReader presetFile (presetStream);
+		EXPECT_TRUE (presetFile.readChunkList ());
+		EXPECT_FALSE (presetFile.contains (kComponentState));
+		EXPECT_FALSE (presetFile.contains (kControllerState));
+		EXPECT_TRUE (presetFile.contains (kCompressedComponentState));
+		EXPECT_TRUE (presetFile.contains (kCompressedControllerState));
+
+		TSize stateSize = 0;
+		auto stream = presetFile.openStateStream (kComponentState, kCompressedComponentState,
+		                                          &stateSize);
+		EXPECT_TRUE (stream);
+		EXPECT_EQ (stateSize, static_cast<TSize> (componentState.size ()));
+		EXPECT_TRUE (readAll (stream) == componentState);
+		stream = presetFile.openStateStream (kControllerState, kCompressedControllerState);
+		EXPECT_TRUE (stream);
+		EXPECT_TRUE (readAll (stream) == controllerState);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Read states of both chunk variants"),
+	              [] (ITestResult* testResult) {
+		              auto componentState = makeState (100000);
+		              auto controllerState = makeState (500);
+		              for (auto codec : {static_cast<const PresetCodec*> (nullptr),
+		                                 &PresetCodec::getDefault ()})
+		              {
+			              auto presetStream = owned (new ResizableMemoryIBStream);
+			              EXPECT_TRUE (PresetFile::savePreset (
+			                  presetStream, testClassID, makeStream (componentState),
+			                  makeStream (controllerState), nullptr, -1, codec));
+
+			              PresetFile presetFile (presetStream);
+			              EXPECT_TRUE (presetFile.readChunkList ());
+			              TSize stateSize = 0;
+			              auto stream = presetFile.getComponentStateStream (&stateSize);
+			              EXPECT_TRUE (stream);
+			              EXPECT_EQ (stateSize, static_cast<TSize> (componentState.size ()));
+			              EXPECT_TRUE (readAll (stream) == componentState);
+			              stream = presetFile.getControllerStateStream (&stateSize);
+			              EXPECT_TRUE (stream);
+			              EXPECT_EQ (stateSize, static_cast<TSize> (controllerState.size ()));
+			              EXPECT_TRUE (readAll (stream) == controllerState);
+
+			              // only uncompressed states can be read from the preset stream directly
+			              bool uncompressed = codec == nullptr;
+			              EXPECT_EQ (presetFile.seekToComponentState (), uncompressed);
+			              EXPECT_EQ (presetFile.seekToControllerState (), uncompressed);
+			              if (uncompressed)
+			              {
+				              std::vector<uint8> buffer (controllerState.size ());
+				              int32 numRead = 0;
+				              presetStream->read (buffer.data (),
+				                                  static_cast<int32> (buffer.size ()), &numRead);
+				              EXPECT_TRUE (buffer == controllerState);
+			              }
+		              }
+
+		              auto presetStream = owned (new ResizableMemoryIBStream);
+		              EXPECT_TRUE (PresetFile::savePreset (presetStream, testClassID,
+		                                                   makeStream (componentState)));
+		              PresetFile presetFile (presetStream);
+		              EXPECT_TRUE (presetFile.readChunkList ());
+		              EXPECT_FALSE (presetFile.getControllerStateStream ());
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Seek in compressed state"), [] (ITestResult* testResult) {
+		auto state = makeState (150000);
+		auto presetStream = owned (new ResizableMemoryIBStream);
+		EXPECT_TRUE (PresetFile::savePreset (presetStream, testClassID, makeStream (state),
+		                                     nullptr, nullptr, -1, &PresetCodec::getDefault ()));
+		PresetFileReader presetFile (presetStream);
+		EXPECT_TRUE (presetFile.readChunkList ());
+		auto stream = presetFile.openStateStream (kComponentState, kCompressedComponentState);
+		EXPECT_TRUE (stream);
+
+		int64 pos = 0;
+		uint8 value = 0;
+		EXPECT_EQ (stream->seek (0, IBStream::kIBSeekEnd, &pos), kResultOk);
+		EXPECT_EQ (pos, static_cast<int64> (state.size ()));
+		for (int64 target : {140000, 70000, 65536, 65535, 3, 0})
+		{
+			EXPECT_EQ (stream->seek (target, IBStream::kIBSeekSet, &pos), kResultOk);
+			EXPECT_EQ (pos, target);
+			EXPECT_EQ (stream->read (&value, 1, nullptr), kResultOk);
+			EXPECT_EQ (value, state[static_cast<size_t> (target)]);
+		}
+		EXPECT_EQ (stream->seek (1000, IBStream::kIBSeekCur, &pos), kResultOk);
+		EXPECT_EQ (pos, 1001);
+		EXPECT_EQ (stream->tell (&pos), kResultOk);
+		EXPECT_EQ (pos, 1001);
+
+		// short read at the end
+		std::vector<uint8> buffer (100);
+		int32 numRead = -1;
+		EXPECT_EQ (stream->seek (-10, IBStream::kIBSeekEnd, &pos), kResultOk);
+		EXPECT_EQ (stream->read (buffer.data (), 100, &numRead), kResultOk);
+		EXPECT_EQ (numRead, 10);
+		EXPECT_EQ (buffer[9], state.back ());
+		EXPECT_EQ (stream->read (buffer.data (), 100, &numRead), kResultOk);
+		EXPECT_EQ (numRead, 0);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Uncompressed state is preferred"), [] (ITestResult* testResult) {
+		auto state = makeState (1000);
+		auto presetStream = owned (new ResizableMemoryIBStream);
+		EXPECT_TRUE (PresetFile::savePreset (presetStream, testClassID, makeStream (state)));
+		PresetFileReader presetFile (presetStream);
+		EXPECT_TRUE (presetFile.readChunkList ());
+		EXPECT_TRUE (presetFile.contains (kComponentState));
+		EXPECT_FALSE (presetFile.contains (kCompressedComponentState));
+		auto stream = presetFile.openStateStream (kComponentState, kCompressedComponentState);
+		EXPECT_TRUE (stream);
+		EXPECT_TRUE (readAll (stream) == state);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Registered codec"), [] (ITestResult* testResult) {
+		static NullCodec nullCodec;
+		auto state = makeState (1000);
+		auto presetStream = owned (new ResizableMemoryIBStream);
+		// the null codec never compresses, so all blocks are stored
+		EXPECT_TRUE (PresetFile::savePreset (presetStream, testClassID, makeStream (state),
+		                                     nullptr, nullptr, -1, &nullCodec));
+		PresetFileReader presetFile (presetStream);
+		EXPECT_TRUE (presetFile.readChunkList ());
+		EXPECT_FALSE (
+		    presetFile.openStateStream (kComponentState, kCompressedComponentState));
+
+		EXPECT_EQ (PresetCodec::find (NullCodec::codecID), nullptr);
+		PresetCodec::registerCodec (&nullCodec);
+		EXPECT_EQ (PresetCodec::find (NullCodec::codecID), &nullCodec);
+		auto stream = presetFile.openStateStream (kComponentState, kCompressedComponentState);
+		EXPECT_TRUE (stream);
+		PresetCodec::unregisterCodec (&nullCodec);
+		EXPECT_TRUE (readAll (stream) == state);
+		EXPECT_EQ (PresetCodec::find (NullCodec::codecID), nullptr);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
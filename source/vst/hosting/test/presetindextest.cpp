@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/test/presetindextest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test preset library index
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/presetindex.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/vstpresetfile.h"
+#include "pluginterfaces/base/fstrdefs.h"
+
+#include <filesystem>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+const FUID testClassID (0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+const FUID otherClassID (0x11111111, 0x22222222, 0x33333333, 0x44444444);
+
+//------------------------------------------------------------------------
+bool writeTestPreset (const std::filesystem::path& path, const FUID& classID, const char* xml)
+{
+	auto stream = owned (FileStream::open (path.generic_string ().data (), "wb"));
+	if (!stream)
+		return false;
+	PresetFile presetFile (stream);
+	presetFile.setClassID (classID);
+	int32 state[4] = {1, 2, 3, 4};
+	return presetFile.writeHeader () &&
+	       presetFile.writeChunk (state, sizeof (state), kComponentState) &&
+	       (xml == nullptr || presetFile.writeMetaInfo (xml)) && presetFile.writeChunkList ();
+}
+
+//------------------------------------------------------------------------
+struct TestDirectory
+{
+	TestDirectory ()
+	{
+		path = std::filesystem::temp_directory_path () / "vst3presetindextest";
+		std::filesystem::remove_all (path);
+		std::filesystem::create_directories (path / "sub");
+	}
+	~TestDirectory () noexcept
+	{
+		std::error_code ec;
+		std::filesystem::remove_all (path, ec);
+	}
+	std::filesystem::path path;
+};
+
+//------------------------------------------------------------------------
+constexpr auto testMetaInfo = R"(<?xml version="1.0" encoding="utf-8"?>
+<MetaInfo>
+	<Attr id="MediaType" value="VstPreset" type="string" flags="writeProtected"></Attr>
+	<Attr id="Name" value="Warm &amp; Soft" type="string"></Attr>
+	<Attr id="MusicalInstrument" value="Synth|Pad" type="string"></Attr>
+	<Attr id="MusicalCharacter" value="Warm|Soft" type="string"></Attr>
+</MetaInfo>)";
+
+//------------------------------------------------------------------------
+ModuleInitializer PresetIndexTests ([] () {
+	constexpr auto TestSuiteName = "PresetIndex";
+	registerTest (TestSuiteName, STR ("Read entry"), [] (ITestResult* testResult) {
+		TestDirectory dir;
+		auto path = dir.path / "test.vstpreset";
+		EXPECT_TRUE (writeTestPreset (path, testClassID, testMetaInfo));
+		PresetIndex::Entry entry;
+		EXPECT_TRUE (PresetIndex::readEntry (path.generic_string (), entry));
+		EXPECT_EQ (entry.classID, testClassID);
+		EXPECT_EQ (entry.name, "Warm & Soft");
+		EXPECT_EQ (entry.category, "Synth|Pad");
+		EXPECT_TRUE (entry.hasTag ("Warm"));
+		EXPECT_TRUE (entry.hasTag ("Soft"));
+		EXPECT_FALSE (entry.hasTag ("Pad"));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Read entry without meta info"), [] (ITestResult* testResult) {
+		TestDirectory dir;
+		auto path = dir.path / "NoInfo.vstpreset";
+		EXPECT_TRUE (writeTestPreset (path, testClassID, nullptr));
+		PresetIndex::Entry entry;
+		EXPECT_TRUE (PresetIndex::readEntry (path.generic_string (), entry));
+		EXPECT_EQ (entry.name, "NoInfo");
+		EXPECT_TRUE (entry.tags.empty ());
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Scan and find"), [] (ITestResult* testResult) {
+		TestDirectory dir;
+		EXPECT_TRUE (writeTestPreset (dir.path / "a.vstpreset", testClassID, testMetaInfo));
+		EXPECT_TRUE (writeTestPreset (dir.path / "sub" / "b.vstpreset", testClassID, nullptr));
+		EXPECT_TRUE (writeTestPreset (dir.path / "c.vstpreset", otherClassID, testMetaInfo));
+
+		PresetIndex index;
+		auto result = index.scan ({dir.path.generic_string ()}, 2);
+		EXPECT_EQ (result.numFiles, 3u);
+		EXPECT_EQ (result.numParsed, 3u);
+		EXPECT_EQ (result.numFailed, 0u);
+		EXPECT_EQ (index.find (testClassID).size (), 2u);
+		EXPECT_EQ (index.find (testClassID, "Warm").size (), 1u);
+		EXPECT_EQ (index.find (otherClassID, "Soft").size (), 1u);
+		EXPECT_TRUE (index.find (otherClassID, "Cold").empty ());
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Save, load and rescan"), [] (ITestResult* testResult) {
+		TestDirectory dir;
+		EXPECT_TRUE (writeTestPreset (dir.path / "a.vstpreset", testClassID, testMetaInfo));
+		EXPECT_TRUE (writeTestPreset (dir.path / "b.vstpreset", otherClassID, nullptr));
+		auto indexPath = (dir.path / "index.txt").generic_string ();
+
+		PresetIndex index;
+		index.scan ({dir.path.generic_string ()});
+		EXPECT_TRUE (index.save (indexPath));
+
+		PresetIndex loadedIndex;
+		EXPECT_TRUE (loadedIndex.load (indexPath));
+		EXPECT_EQ (loadedIndex.getEntries ().size (), 2u);
+		auto entries = loadedIndex.find (testClassID, "Soft");
+		EXPECT_EQ (entries.size (), 1u);
+		EXPECT_EQ (entries[0].name, "Warm & Soft");
+
+		std::filesystem::remove (dir.path / "b.vstpreset");
+		auto result = loadedIndex.scan ({dir.path.generic_string ()});
+		EXPECT_EQ (result.numFiles, 1u);
+		EXPECT_EQ (result.numCached, 1u);
+		EXPECT_EQ (result.numParsed, 0u);
+		EXPECT_EQ (loadedIndex.getEntries ().size (), 1u);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/test/statesnapshottest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test state snapshot store
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/statesnapshot.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/fstrdefs.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<uint8> makeState (size_t size, uint8 seed)
+{
+	std::vector<uint8> state (size);
+	uint32 value = seed;
+	for (auto& byte : state)
+	{
+		value = value * 1664525u + 1013904223u;
+		byte = static_cast<uint8> (value >> 24);
+	}
+	return state;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer StateSnapshotStoreTests ([] () {
+	constexpr auto TestSuiteName = "StateSnapshotStore";
+	registerTest (TestSuiteName, STR ("Add and get snapshot"), [] (ITestResult* testResult) {
+		StateSnapshotStore store (1024);
+		auto componentState = makeState (5000, 1);
+		auto controllerState = makeState (100, 2);
+		auto id = store.addSnapshot (componentState.data (), componentState.size (),
+		                             controllerState.data (), controllerState.size ());
+		EXPECT_NE (id, StateSnapshotStore::kInvalidSnapshotID);
+
+		std::vector<uint8> component;
+		std::vector<uint8> controller;
+		EXPECT_TRUE (store.getSnapshotData (id, component, controller));
+		EXPECT_TRUE (component == componentState);
+		EXPECT_TRUE (controller == controllerState);
+		EXPECT_FALSE (store.getSnapshotData (id + 1, component, controller));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Unchanged blocks are shared"), [] (ITestResult* testResult) {
+		StateSnapshotStore store (1024);
+		auto state = makeState (8 * 1024, 3);
+		store.addSnapshot (state.data (), state.size ());
+		auto statistics = store.getStatistics ();
+		EXPECT_EQ (statistics.lastNewBlocks, 8u);
+
+		// same state again: nothing new to store
+		store.addSnapshot (state.data (), state.size ());
+		statistics = store.getStatistics ();
+		EXPECT_EQ (statistics.lastNewBlocks, 0u);
+		EXPECT_EQ (statistics.lastReusedBlocks, 8u);
+		EXPECT_EQ (statistics.storedBytes, state.size ());
+
+		// change one byte: only one block is new
+		state[3000] ^= 0xFF;
+		auto id = store.addSnapshot (state.data (), state.size ());
+		statistics = store.getStatistics ();
+		EXPECT_EQ (statistics.lastNewBlocks, 1u);
+		EXPECT_EQ (statistics.numBlocks, 9u);
+		EXPECT_EQ (statistics.numSnapshots, 3u);
+
+		std::vector<uint8> component;
+		std::vector<uint8> controller;
+		EXPECT_TRUE (store.getSnapshotData (id, component, controller));
+		EXPECT_TRUE (component == state);
+		EXPECT_TRUE (controller.empty ());
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Remove snapshot frees blocks"), [] (ITestResult* testResult) {
+		StateSnapshotStore store (1024);
+		auto state1 = makeState (4096, 4);
+		auto state2 = state1;
+		state2[0] ^= 0xFF;
+		auto id1 = store.addSnapshot (state1.data (), state1.size ());
+		auto id2 = store.addSnapshot (state2.data (), state2.size ());
+		EXPECT_EQ (store.getStatistics ().numBlocks, 5u);
+		EXPECT_TRUE (store.removeSnapshot (id1));
+		EXPECT_FALSE (store.removeSnapshot (id1));
+		EXPECT_EQ (store.getStatistics ().numBlocks, 4u);
+		EXPECT_TRUE (store.removeSnapshot (id2));
+		auto statistics = store.getStatistics ();
+		EXPECT_EQ (statistics.numBlocks, 0u);
+		EXPECT_EQ (statistics.storedBytes, 0u);
+		EXPECT_EQ (statistics.numSnapshots, 0u);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,213 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/test/umpeventbridgetest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test UMP event bridge
+// Flags       : clang-format SMTGSequencer
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/umpeventbridge.h"
+#include "public.sdk/source/vst/testsuite/testbase.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/funknownimpl.h"
+
+#include <chrono>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+struct MidiMapping : U::ImplementsNonDestroyable<U::Directly<IMidiMapping>>
+{
+	tresult PLUGIN_API getMidiControllerAssignment (int32 busIndex, int16 channel,
+	                                                CtrlNumber midiControllerNumber,
+	                                                ParamID& id) override
+	{
+		if (busIndex != 0 || channel != 0)
+			return kResultFalse;
+		switch (midiControllerNumber)
+		{
+			case kCtrlModWheel: id = 100; return kResultTrue;
+			case kPitchBend: id = 101; return kResultTrue;
+		}
+		return kResultFalse;
+	}
+};
+
+//------------------------------------------------------------------------
+constexpr uint32_t midi2NoteOn (uint32_t channel, uint32_t note)
+{
+	return 0x40900000 | (channel << 16) | (note << 8);
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer UMPEventBridgeTests ([] () {
+	constexpr auto TestSuiteName = "UMPEventBridge";
+	registerTest (TestSuiteName, STR ("MIDI 2.0 note on and off"), [] (ITestResult* testResult) {
+		EventList events;
+		ParameterChanges changes;
+		UMPEventBridge<> bridge;
+		const uint32_t words[] = {midi2NoteOn (2, 60), 0xffff0000, 0x40823c00, 0x80000000};
+		bridge.beginBlock (events, changes);
+		EXPECT_EQ (bridge.process (4, words, 16), 4u);
+		EXPECT_EQ (events.getEventCount (), 2);
+		Event e;
+		EXPECT_EQ (events.getEvent (0, e), kResultTrue);
+		EXPECT_EQ (e.type, Event::kNoteOnEvent);
+		EXPECT_EQ (e.sampleOffset, 16);
+		EXPECT_EQ (e.noteOn.channel, 2);
+		EXPECT_EQ (e.noteOn.pitch, 60);
+		EXPECT_EQ (e.noteOn.velocity, 1.f);
+		EXPECT_EQ (e.noteOn.noteId, 2 * 128 + 60);
+		EXPECT_EQ (events.getEvent (1, e), kResultTrue);
+		EXPECT_EQ (e.type, Event::kNoteOffEvent);
+		EXPECT_EQ (e.noteOff.noteId, 2 * 128 + 60);
+		EXPECT (Test::maxDiff (e.noteOff.velocity, 0.5f, 0.0001f));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("MIDI 1.0 note on with velocity zero"),
+	              [] (ITestResult* testResult) {
+		              EventList events;
+		              ParameterChanges changes;
+		              UMPEventBridge<> bridge;
+		              const uint32_t words[] = {0x20903c00};
+		              bridge.beginBlock (events, changes);
+		              EXPECT_EQ (bridge.process (1, words, 0), 1u);
+		              Event e;
+		              EXPECT_EQ (events.getEvent (0, e), kResultTrue);
+		              EXPECT_EQ (e.type, Event::kNoteOffEvent);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Per-note pitch bend"), [] (ITestResult* testResult) {
+		EventList events;
+		ParameterChanges changes;
+		UMPEventBridge<> bridge;
+		bridge.setPerNotePitchBendRange (24.);
+		const uint32_t words[] = {0x40603c00, 0xffffffff};
+		bridge.beginBlock (events, changes);
+		EXPECT_EQ (bridge.process (2, words, 0), 2u);
+		Event e;
+		EXPECT_EQ (events.getEvent (0, e), kResultTrue);
+		EXPECT_EQ (e.type, Event::kNoteExpressionValueEvent);
+		EXPECT_EQ (e.noteExpressionValue.typeId, static_cast<NoteExpressionTypeID> (kTuningTypeID));
+		EXPECT (Test::maxDiff (e.noteExpressionValue.value, 0.6, 0.0001));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Mapped controllers"), [] (ITestResult* testResult) {
+		EventList events;
+		ParameterChanges changes (4);
+		MidiMapping mapping;
+		UMPEventBridge<> bridge;
+		bridge.updateMapping (&mapping);
+		// mod wheel twice, an unmapped controller and pitch bend
+		const uint32_t words[] = {0x20b0017f, 0x20b00100, 0x20b0027f, 0x20e00040};
+		bridge.beginBlock (events, changes);
+		EXPECT_EQ (bridge.process (1, words, 0), 1u);
+		EXPECT_EQ (bridge.process (2, words + 1, 4), 2u);
+		EXPECT_EQ (bridge.process (1, words + 3, 8), 1u);
+		EXPECT_EQ (changes.getParameterCount (), 2);
+		auto queue = changes.getParameterData (0);
+		EXPECT_EQ (queue->getParameterId (), 100u);
+		EXPECT_EQ (queue->getPointCount (), 2);
+		int32 offset;
+		ParamValue value;
+		EXPECT_EQ (queue->getPoint (0, offset, value), kResultTrue);
+		EXPECT_EQ (value, 1.);
+		EXPECT_EQ (queue->getPoint (1, offset, value), kResultTrue);
+		EXPECT_EQ (offset, 4);
+		EXPECT_EQ (value, 0.);
+		queue = changes.getParameterData (1);
+		EXPECT_EQ (queue->getParameterId (), 101u);
+		EXPECT_EQ (queue->getPoint (0, offset, value), kResultTrue);
+		EXPECT_EQ (offset, 8);
+		EXPECT (Test::maxDiff (value, 0.5, 0.001));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Group filter"), [] (ITestResult* testResult) {
+		EventList events;
+		ParameterChanges changes;
+		UMPEventBridge<> bridge;
+		bridge.setGroup (1);
+		const uint32_t words[] = {0x20903c7f, 0x21903c7f};
+		bridge.beginBlock (events, changes);
+		EXPECT_EQ (bridge.process (2, words, 0), 2u);
+		EXPECT_EQ (events.getEventCount (), 1);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+// only run by the validator selftest with extensive tests
+ModuleInitializer UMPEventBridgeBenchmarks ([] () {
+	constexpr auto TestSuiteName = "UMPEventBridgeBenchmark";
+	registerTest (TestSuiteName, STR ("Throughput"), [] (ITestResult* testResult) {
+		constexpr auto numNotes = 4096u;
+		constexpr auto numBlocks = 256u;
+		std::vector<uint32_t> words;
+		words.reserve (numNotes * 6);
+		for (auto i = 0u; i < numNotes; ++i)
+		{
+			// note on, a system message to skip and a per-note pitch bend
+			words.push_back (midi2NoteOn (i % 16, i % 128));
+			words.push_back (0xffff0000);
+			words.push_back (0x10f80000);
+			words.push_back (0x40600000 | ((i % 16) << 16) | ((i % 128) << 8));
+			words.push_back (0x90000000 + i);
+		}
+		EventList events (numNotes * 2);
+		ParameterChanges changes;
+		UMPEventBridge<> bridge;
+		size_t numPackets = 0;
+		auto start = std::chrono::steady_clock::now ();
+		for (auto block = 0u; block < numBlocks; ++block)
+		{
+			events.clear ();
+			bridge.beginBlock (events, changes);
+			EXPECT_EQ (bridge.process (words.size (), words.data (), 0), words.size ());
+			numPackets += numNotes * 3;
+		}
+		auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () - start);
+		EXPECT_EQ (events.getEventCount (), static_cast<int32> (numNotes * 2));
+		addMessage (testResult, printf ("   %.1f million packets per second",
+		                                numPackets / duration.count () / 1000000.));
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
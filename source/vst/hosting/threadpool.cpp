@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/threadpool.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Simple thread pool for hosting tasks
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "threadpool.h"
+
+#include <algorithm>
+
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+ThreadPool::ThreadPool (uint32 numThreads)
+{
+	if (numThreads == 0)
+		numThreads = std::max<uint32> (1u, std::thread::hardware_concurrency ());
+	threads.reserve (numThreads);
+	for (uint32 i = 0; i < numThreads; ++i)
+		threads.emplace_back ([this] () { run (); });
+}
+
+//------------------------------------------------------------------------
+ThreadPool::~ThreadPool () noexcept
+{
+	waitAll ();
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		stopThreads = true;
+	}
+	taskAvailable.notify_all ();
+	for (auto& thread : threads)
+		thread.join ();
+}
+
+//------------------------------------------------------------------------
+void ThreadPool::addTask (Task&& task)
+{
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		tasks.emplace_back (std::move (task));
+		++pendingTasks;
+	}
+	taskAvailable.notify_one ();
+}
+
+//------------------------------------------------------------------------
+void ThreadPool::waitAll ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	tasksDone.wait (lock, [this] () { return pendingTasks == 0; });
+}
+
+//------------------------------------------------------------------------
+void ThreadPool::run ()
+{
+	while (true)
+	{
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock (mutex);
+			taskAvailable.wait (lock, [this] () { return stopThreads || !tasks.empty (); });
+			if (tasks.empty ())
+				return;
+			task = std::move (tasks.front ());
+			tasks.pop_front ();
+		}
+		task ();
+		{
+			std::lock_guard<std::mutex> lock (mutex);
+			--pendingTasks;
+			if (pendingTasks != 0)
+				continue;
+		}
+		tasksDone.notify_all ();
+	}
+}
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
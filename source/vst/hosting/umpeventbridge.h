@@ -0,0 +1,379 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/hosting/umpeventbridge.h
+// Created by  : Steinberg, 10/2026
+// Description : Universal MIDI Packet to VST 3 event and parameter change bridge
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "public.sdk/source/vst/hosting/eventlist.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include "public.sdk/source/vst/utility/ump.h"
+#include "pluginterfaces/vst/ivsteditcontroller.h"
+#include "pluginterfaces/vst/ivstevents.h"
+#include "pluginterfaces/vst/ivstmidicontrollers.h"
+#include "pluginterfaces/vst/ivstnoteexpression.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+#include <array>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** Converts Universal MIDI Packets to VST 3 events and parameter changes.
+\ingroup hostingBase
+
+The bridge writes directly into the event list and parameter changes of the next process call. It
+does not allocate or lock, so it can be used on the audio thread. The parser calls the bridge
+without virtual dispatch and only decodes MIDI 1.0 and MIDI 2.0 channel voice messages.
+
+- note on/off and poly pressure become events. The note ID is channel * 128 + pitch, so per-note
+  messages address the same note.
+- registered and assignable per-note controllers and per-note pitch bend become note expression
+  value events.
+- control changes, channel pressure, pitch bend and program change become parameter changes for
+  the parameters the plug-in assigned via IMidiMapping.
+
+\code{.cpp}
+// once after the plug-in is initialized
+bridge.updateMapping (midiMapping);
+// on the audio thread
+bridge.beginBlock (inputEvents, inputParameterChanges);
+for (auto& packets : incomingPackets)
+	bridge.process (packets.numWords, packets.words, packets.sampleOffset);
+\endcode
+*/
+template <typename EventListT = EventList, typename ParameterChangesT = ParameterChanges>
+class UMPEventBridge
+{
+public:
+	static constexpr auto kSections =
+	    static_cast<UMP::ParseSections> (UMP::ChannelVoice1 | UMP::ChannelVoice2);
+	static constexpr int32 kNumChannels = 16;
+	static constexpr int32 kNumControllers = kCtrlProgramChange + 1;
+
+	UMPEventBridge () { paramIDs.fill (kNoParamId); }
+	// the handler points back to the bridge
+	UMPEventBridge (const UMPEventBridge&) = delete;
+	UMPEventBridge& operator= (const UMPEventBridge&) = delete;
+	UMPEventBridge (UMPEventBridge&&) = delete;
+	UMPEventBridge& operator= (UMPEventBridge&&) = delete;
+
+	/** reads the MIDI controller assignments of the plug-in (not realtime safe) */
+	void updateMapping (IMidiMapping* midiMapping, int32 busIndex = 0)
+	{
+		paramIDs.fill (kNoParamId);
+		if (!midiMapping)
+			return;
+		for (int16 channel = 0; channel < kNumChannels; ++channel)
+		{
+			for (int32 ctrl = 0; ctrl < kNumControllers; ++ctrl)
+			{
+				ParamID id;
+				if (midiMapping->getMidiControllerAssignment (
+				        busIndex, channel, static_cast<CtrlNumber> (ctrl), id) == kResultTrue)
+					paramIDs[slot (channel, ctrl)] = id;
+			}
+		}
+	}
+
+	/** range in semitones of MIDI 2.0 per-note pitch bend (default 48 like MPE) */
+	void setPerNotePitchBendRange (double semitones) { perNotePitchBendRange = semitones; }
+	/** only convert packets of this group, -1 converts all groups */
+	void setGroup (int32 group) { groupFilter = group; }
+	/** the event bus index of the generated events */
+	void setBusIndex (int32 index) { busIndex = index; }
+
+	/** sets the lists to write to for the next process call */
+	void beginBlock (EventListT& events, ParameterChangesT& parameterChanges)
+	{
+		eventList = &events;
+		changes = &parameterChanges;
+		for (uint32 i = 0; i < numUsedQueues; ++i)
+			queues[usedQueues[i]] = nullptr;
+		numUsedQueues = 0;
+	}
+
+	/** converts the packets with the sample offset
+	 *	@return number of processed words
+	 */
+	size_t process (size_t numWords, const uint32_t* words, int32 sampleOffset)
+	{
+		if (!eventList || !changes)
+			return 0;
+		currentSampleOffset = sampleOffset;
+		return UMP::parsePackets<kSections> (numWords, words, handler);
+	}
+
+//------------------------------------------------------------------------
+private:
+	static constexpr double kMaxData32 = 4294967295.;
+	static constexpr double kTuningRange = 240.;
+	static constexpr uint8_t kPitchAttribute = 3;
+
+	struct Handler : UMP::UniversalMidiPacketStaticHandlerAdapter
+	{
+		UMPEventBridge* bridge {nullptr};
+
+		void onMidi1NoteOff (Group group, Channel channel, NoteNumber note,
+		                     Velocity8 velocity) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addNoteOff (channel, note, velocity / 127.f, 0.f);
+		}
+		void onMidi1NoteOn (Group group, Channel channel, NoteNumber note,
+		                    Velocity8 velocity) const
+		{
+			if (!bridge->acceptGroup (group))
+				return;
+			if (velocity == 0)
+				bridge->addNoteOff (channel, note, 64.f / 127.f, 0.f);
+			else
+				bridge->addNoteOn (channel, note, velocity / 127.f, 0.f);
+		}
+		void onMidi1PolyPressure (Group group, Channel channel, NoteNumber note, Data8 data) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addPolyPressure (channel, note, data / 127.f);
+		}
+		void onMidi1ControlChange (Group group, Channel channel, ControllerNumber controller,
+		                           Data8 value) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, controller, value / 127.);
+		}
+		void onMidi1ProgramChange (Group group, Channel channel, Program program) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, kCtrlProgramChange, program / 127.);
+		}
+		void onMidi1ChannelPressure (Group group, Channel channel, Data8 pressure) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, kAfterTouch, pressure / 127.);
+		}
+		void onMidi1PitchBend (Group group, Channel channel, Data8 valueLSB, Data8 valueMSB) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, kPitchBend,
+				                            ((valueMSB << 7) | valueLSB) / 16383.);
+		}
+
+		void onRegisteredPerNoteController (Group group, Channel channel, NoteNumber note,
+		                                    ControllerNumber controller, Data32 data) const
+		{
+			if (!bridge->acceptGroup (group))
+				return;
+			auto typeID = registeredPerNoteExpression (controller);
+			if (typeID != static_cast<NoteExpressionTypeID> (kInvalidTypeID))
+				bridge->addNoteExpression (channel, note, typeID, data / kMaxData32);
+		}
+		void onAssignablePerNoteController (Group group, Channel channel, NoteNumber note,
+		                                    ControllerNumber controller, Data32 data) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addNoteExpression (channel, note, kCustomStart + controller,
+				                           data / kMaxData32);
+		}
+		void onPerNotePitchBend (Group group, Channel channel, NoteNumber note, Data32 data) const
+		{
+			if (!bridge->acceptGroup (group))
+				return;
+			auto bend = (static_cast<double> (data) - 2147483648.) / 2147483648.;
+			auto value = 0.5 + bend * bridge->perNotePitchBendRange / kTuningRange;
+			value = value < 0. ? 0. : (value > 1. ? 1. : value);
+			bridge->addNoteExpression (channel, note, kTuningTypeID, value);
+		}
+		void onNoteOff (Group group, Channel channel, NoteNumber note, Velocity16 velocity,
+		                AttributeType attr, AttributeValue attrValue) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addNoteOff (channel, note, velocity / 65535.f,
+				                    tuning (note, attr, attrValue));
+		}
+		void onNoteOn (Group group, Channel channel, NoteNumber note, Velocity16 velocity,
+		               AttributeType attr, AttributeValue attrValue) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addNoteOn (channel, note, velocity / 65535.f,
+				                   tuning (note, attr, attrValue));
+		}
+		void onPolyPressure (Group group, Channel channel, NoteNumber note, Data32 data) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addPolyPressure (channel, note, static_cast<float> (data / kMaxData32));
+		}
+		void onControlChange (Group group, Channel channel, ControllerNumber controller,
+		                      Data32 data) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, controller, data / kMaxData32);
+		}
+		void onProgramChange (Group group, Channel channel, OptionFlags options, Program program,
+		                      BankMSB bankMSB, BankLSB bankLSB) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, kCtrlProgramChange, program / 127.);
+		}
+		void onChannelPressure (Group group, Channel channel, Data32 data) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, kAfterTouch, data / kMaxData32);
+		}
+		void onPitchBend (Group group, Channel channel, Data32 data) const
+		{
+			if (bridge->acceptGroup (group))
+				bridge->addParameterChange (channel, kPitchBend, data / kMaxData32);
+		}
+
+		/** tuning in cents from the pitch 7.9 attribute */
+		static float tuning (NoteNumber note, AttributeType attr, AttributeValue attrValue)
+		{
+			if (attr != kPitchAttribute)
+				return 0.f;
+			return (attrValue / 512.f - note) * 100.f;
+		}
+
+		static NoteExpressionTypeID registeredPerNoteExpression (ControllerNumber controller)
+		{
+			switch (controller)
+			{
+				case 7: return kVolumeTypeID;
+				case 10: return kPanTypeID;
+				case 11: return kExpressionTypeID;
+				case 74: return kBrightnessTypeID;
+			}
+			return static_cast<NoteExpressionTypeID> (kInvalidTypeID);
+		}
+	};
+
+	static constexpr int32 slot (int32 channel, int32 controller)
+	{
+		return channel * kNumControllers + controller;
+	}
+	static constexpr int32 noteID (int32 channel, int32 note) { return channel * 128 + note; }
+
+	bool acceptGroup (uint8_t group) const { return groupFilter < 0 || groupFilter == group; }
+
+	Event makeEvent (uint16 type) const
+	{
+		Event e {};
+		e.busIndex = busIndex;
+		e.sampleOffset = currentSampleOffset;
+		e.flags = Event::kIsLive;
+		e.type = type;
+		return e;
+	}
+
+	void addNoteOn (int32 channel, int32 note, float velocity, float tuning)
+	{
+		auto e = makeEvent (Event::kNoteOnEvent);
+		e.noteOn.channel = static_cast<int16> (channel);
+		e.noteOn.pitch = static_cast<int16> (note);
+		e.noteOn.tuning = tuning;
+		e.noteOn.velocity = velocity;
+		e.noteOn.noteId = noteID (channel, note);
+		eventList->addEvent (e);
+	}
+
+	void addNoteOff (int32 channel, int32 note, float velocity, float tuning)
+	{
+		auto e = makeEvent (Event::kNoteOffEvent);
+		e.noteOff.channel = static_cast<int16> (channel);
+		e.noteOff.pitch = static_cast<int16> (note);
+		e.noteOff.tuning = tuning;
+		e.noteOff.velocity = velocity;
+		e.noteOff.noteId = noteID (channel, note);
+		eventList->addEvent (e);
+	}
+
+	void addPolyPressure (int32 channel, int32 note, float pressure)
+	{
+		auto e = makeEvent (Event::kPolyPressureEvent);
+		e.polyPressure.channel = static_cast<int16> (channel);
+		e.polyPressure.pitch = static_cast<int16> (note);
+		e.polyPressure.pressure = pressure;
+		e.polyPressure.noteId = noteID (channel, note);
+		eventList->addEvent (e);
+	}
+
+	void addNoteExpression (int32 channel, int32 note, NoteExpressionTypeID typeID,
+	                        NoteExpressionValue value)
+	{
+		auto e = makeEvent (Event::kNoteExpressionValueEvent);
+		e.noteExpressionValue.typeId = typeID;
+		e.noteExpressionValue.noteId = noteID (channel, note);
+		e.noteExpressionValue.value = value;
+		eventList->addEvent (e);
+	}
+
+	void addParameterChange (int32 channel, int32 controller, ParamValue value)
+	{
+		auto index = slot (channel, controller);
+		auto id = paramIDs[index];
+		if (id == kNoParamId)
+			return;
+		auto queue = queues[index];
+		if (!queue)
+		{
+			int32 queueIndex;
+			queue = changes->addParameterData (id, queueIndex);
+			if (!queue)
+				return;
+			queues[index] = queue;
+			usedQueues[numUsedQueues++] = static_cast<uint16> (index);
+		}
+		int32 pointIndex;
+		queue->addPoint (currentSampleOffset, value, pointIndex);
+	}
+
+	static constexpr size_t kNumSlots = kNumChannels * kNumControllers;
+
+	Handler handler {{}, this};
+	EventListT* eventList {nullptr};
+	ParameterChangesT* changes {nullptr};
+	std::array<ParamID, kNumSlots> paramIDs;
+	std::array<IParamValueQueue*, kNumSlots> queues {};
+	std::array<uint16, kNumSlots> usedQueues {};
+	uint32 numUsedQueues {0};
+	double perNotePitchBendRange {48.};
+	int32 groupFilter {-1};
+	int32 busIndex {0};
+	int32 currentSampleOffset {0};
+};
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
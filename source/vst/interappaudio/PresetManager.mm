@@ -249,28 +249,26 @@ tresult PresetManager::loadPreset (const char* path)
 					return kResultFalse;
 				if (pf.getClassID () != cid)
 					return kResultFalse;
-				const PresetFile::Entry* e = pf.getEntry (kComponentState);
-				if (e == nullptr)
+				// the state streams handle compressed and uncompressed state chunks
+				TSize stateSize = 0;
+				auto stateStream = pf.getComponentStateStream (&stateSize);
+				if (!stateStream)
 					return kResultFalse;
 				auto filename = strrchr (path, '/');
 				if (filename)
 					filename++;
 				IPtr<PresetStream> readOnlyBStream =
-				    owned (new PresetStream (stream, e->offset, e->size, filename));
+				    owned (new PresetStream (stateStream, 0, stateSize, filename));
 				tresult result = component->setState (readOnlyBStream);
 				if ((result == kResultTrue || result == kNotImplemented) && controller)
 				{
 					readOnlyBStream->seek (0, IBStream::kIBSeekSet);
 					controller->setComponentState (readOnlyBStream);
-					if (pf.contains (kControllerState))
+					if (auto controllerStream = pf.getControllerStateStream (&stateSize))
 					{
-						e = pf.getEntry (kControllerState);
-						if (e)
-						{
-							readOnlyBStream =
-							    owned (new PresetStream (stream, e->offset, e->size, filename));
-							controller->setState (readOnlyBStream);
-						}
+						readOnlyBStream =
+						    owned (new PresetStream (controllerStream, 0, stateSize, filename));
+						controller->setState (readOnlyBStream);
 					}
 				}
 				return result;
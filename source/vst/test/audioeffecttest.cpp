@@ -0,0 +1,213 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/test/audioeffecttest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test audio effect
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/eventlist.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/vstaudioeffect.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+class SilenceEffect : public AudioEffect
+{
+public:
+	uint32 PLUGIN_API getTailSamples () SMTG_OVERRIDE { return tailSamples; }
+	tresult PLUGIN_API process (ProcessData& data) SMTG_OVERRIDE
+	{
+		skipped = skipSilentBlock (data);
+		return kResultOk;
+	}
+
+	using AudioEffect::setSilenceThreshold;
+
+	uint32 tailSamples {kNoTail};
+	bool skipped {false};
+};
+
+//------------------------------------------------------------------------
+/** One block with a stereo output and an optional stereo input */
+struct TestBlock
+{
+	TestBlock (int32 numSamples, bool withInput = true)
+	: input (2, std::vector<float> (numSamples)), output (2, std::vector<float> (numSamples, 1.f))
+	{
+		for (int32 channel = 0; channel < 2; channel++)
+		{
+			inputPointers[channel] = input[channel].data ();
+			outputPointers[channel] = output[channel].data ();
+		}
+		inBus.numChannels = outBus.numChannels = 2;
+		inBus.channelBuffers32 = inputPointers;
+		outBus.channelBuffers32 = outputPointers;
+		data.numSamples = numSamples;
+		data.symbolicSampleSize = kSample32;
+		data.numInputs = withInput ? 1 : 0;
+		data.numOutputs = 1;
+		data.inputs = withInput ? &inBus : nullptr;
+		data.outputs = &outBus;
+	}
+
+	std::vector<std::vector<float>> input;
+	std::vector<std::vector<float>> output;
+	float* inputPointers[2];
+	float* outputPointers[2];
+	AudioBusBuffers inBus;
+	AudioBusBuffers outBus;
+	ProcessData data;
+};
+
+//------------------------------------------------------------------------
+/** processes silent blocks until the effect skips one, returns the number of processed blocks */
+int32 blocksUntilSkipped (SilenceEffect& effect, TestBlock& block, int32 maxBlocks = 16)
+{
+	for (int32 i = 0; i < maxBlocks; i++)
+	{
+		effect.process (block.data);
+		if (effect.skipped)
+			return i;
+	}
+	return maxBlocks;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer AudioEffectTests ([] () {
+	constexpr auto TestSuiteName = "AudioEffect";
+	registerTest (TestSuiteName, STR ("Skip silent block"), [] (ITestResult* testResult) {
+		SilenceEffect effect;
+		TestBlock block (4);
+		effect.process (block.data);
+		EXPECT_TRUE (effect.skipped);
+		EXPECT_EQ (block.output[0][0], 0.f);
+		EXPECT_EQ (block.output[1][3], 0.f);
+		EXPECT_EQ (block.outBus.silenceFlags, 3u);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Skip after the tail"), [] (ITestResult* testResult) {
+		SilenceEffect effect;
+		effect.tailSamples = 8;
+		TestBlock block (4);
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 2);
+		EXPECT_EQ (block.outBus.silenceFlags, 3u);
+		// the tail starts again with the next signal
+		block.input[1][2] = 0.5f;
+		effect.process (block.data);
+		EXPECT_FALSE (effect.skipped);
+		block.input[1][2] = 0.f;
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 2);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Silence flags and threshold"), [] (ITestResult* testResult) {
+		SilenceEffect effect;
+		TestBlock block (4);
+		for (auto& channel : block.input)
+			channel[1] = 0.25f;
+		effect.process (block.data);
+		EXPECT_FALSE (effect.skipped);
+		block.inBus.silenceFlags = 3;
+		effect.process (block.data);
+		EXPECT_TRUE (effect.skipped);
+		block.inBus.silenceFlags = 0;
+		effect.setSilenceThreshold (0.5);
+		effect.process (block.data);
+		EXPECT_TRUE (effect.skipped);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Input events"), [] (ITestResult* testResult) {
+		SilenceEffect effect;
+		TestBlock block (4);
+		EventList eventList;
+		Event event = {};
+		event.type = Event::kNoteOnEvent;
+		eventList.addEvent (event);
+		block.data.inputEvents = &eventList;
+		effect.process (block.data);
+		EXPECT_FALSE (effect.skipped);
+		eventList.clear ();
+		effect.process (block.data);
+		EXPECT_TRUE (effect.skipped);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Infinite tail"), [] (ITestResult* testResult) {
+		SilenceEffect effect;
+		effect.tailSamples = kInfiniteTail;
+		TestBlock block (4);
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 16);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Instrument"), [] (ITestResult* testResult) {
+		// a note sounds on after its note-on, so blocks without audio inputs are never skipped
+		SilenceEffect effect;
+		TestBlock block (4, false);
+		EventList eventList;
+		Event event = {};
+		event.type = Event::kNoteOnEvent;
+		eventList.addEvent (event);
+		block.data.inputEvents = &eventList;
+		effect.process (block.data);
+		EXPECT_FALSE (effect.skipped);
+		eventList.clear ();
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 16);
+		EXPECT_EQ (block.output[0][0], 1.f);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Restart the tail on state changes"), [] (ITestResult* testResult) {
+		SilenceEffect effect;
+		effect.tailSamples = 8;
+		TestBlock block (4);
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 2);
+		effect.setProcessing (false);
+		effect.setProcessing (true);
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 2);
+		effect.setActive (false);
+		effect.setActive (true);
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 2);
+		ProcessSetup setup {kRealtime, kSample32, 4, 48000.};
+		effect.setupProcessing (setup);
+		EXPECT_EQ (blocksUntilSkipped (effect, block), 2);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
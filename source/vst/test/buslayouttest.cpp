@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/test/buslayouttest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test bus layout
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/vstaudioeffect.h"
+#include "public.sdk/source/vst/vstbus.h"
+
+#include <memory>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+class TestTransfer : public BusLayoutTransfer
+{
+public:
+	size_t getRetiredCount () const { return retired.size (); }
+};
+
+//------------------------------------------------------------------------
+class TestEffect : public AudioEffect
+{
+public:
+	using AudioEffect::getProcessBusLayout;
+};
+
+//------------------------------------------------------------------------
+std::unique_ptr<BusLayout> makeLayout (int32 numAudioInputs)
+{
+	auto layout = std::unique_ptr<BusLayout> (new BusLayout);
+	for (int32 i = 0; i < numAudioInputs; i++)
+	{
+		layout->audioInputs.active.push_back (i == 0 ? 1 : 0);
+		layout->audioInputs.channelCount.push_back (2);
+		layout->audioInputs.arrangement.push_back (SpeakerArr::kStereo);
+	}
+	return layout;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer BusLayoutTests ([] () {
+	constexpr auto TestSuiteName = "BusLayout";
+	registerTest (TestSuiteName, STR ("Initial layout"), [] (ITestResult* testResult) {
+		BusLayoutTransfer transfer;
+		auto layout = transfer.access_rt ();
+		EXPECT_TRUE (layout != nullptr);
+		EXPECT_EQ (layout->audioInputs.getCount (), 0);
+		EXPECT_EQ (layout->eventOutputs.getCount (), 0);
+		EXPECT_FALSE (layout->audioInputs.isActive (0));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Publish and access"), [] (ITestResult* testResult) {
+		BusLayoutTransfer transfer;
+		transfer.publish_ui (makeLayout (2));
+		auto layout = transfer.access_rt ();
+		EXPECT_EQ (layout->audioInputs.getCount (), 2);
+		EXPECT_TRUE (layout->audioInputs.isActive (0));
+		EXPECT_FALSE (layout->audioInputs.isActive (1));
+		EXPECT_FALSE (layout->audioInputs.isActive (2));
+		EXPECT_FALSE (layout->audioInputs.isActive (-1));
+		EXPECT_EQ (layout->getBusStates (kAudio, kInput), &layout->audioInputs);
+		EXPECT_EQ (layout->getBusStates (kEvent, kOutput), &layout->eventOutputs);
+		transfer.publish_ui (makeLayout (3));
+		EXPECT_EQ (transfer.access_rt ()->audioInputs.getCount (), 3);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Delete retired layouts"), [] (ITestResult* testResult) {
+		TestTransfer transfer;
+		// the layout in use by the realtime thread is kept
+		transfer.access_rt ();
+		transfer.publish_ui (makeLayout (1));
+		EXPECT_EQ (transfer.getRetiredCount (), 1u);
+		transfer.clearRetired_ui ();
+		EXPECT_EQ (transfer.getRetiredCount (), 1u);
+		// and deleted once the realtime thread moved on
+		transfer.access_rt ();
+		transfer.clearRetired_ui ();
+		EXPECT_EQ (transfer.getRetiredCount (), 0u);
+		// layouts which the realtime thread never used are deleted right away
+		transfer.publish_ui (makeLayout (2));
+		transfer.publish_ui (makeLayout (3));
+		EXPECT_EQ (transfer.getRetiredCount (), 1u);
+		EXPECT_EQ (transfer.access_rt ()->audioInputs.getCount (), 3);
+		transfer.publish_ui (makeLayout (4));
+		EXPECT_EQ (transfer.getRetiredCount (), 1u);
+		EXPECT_EQ (transfer.access_rt ()->audioInputs.getCount (), 4);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Component publishes bus changes"),
+	              [] (ITestResult* testResult) {
+		              TestEffect effect;
+		              effect.addAudioInput (STR16 ("Input"), SpeakerArr::kStereo);
+		              effect.addAudioOutput (STR16 ("Output"), SpeakerArr::kStereo);
+		              effect.addEventInput (STR16 ("Events"), 16);
+		              effect.addEventOutput (STR16 ("Events Out"), 1, kMain, 0);
+		              auto* layout = &effect.getProcessBusLayout ();
+		              EXPECT_EQ (layout->audioInputs.getCount (), 1);
+		              EXPECT_EQ (layout->audioOutputs.getCount (), 1);
+		              EXPECT_EQ (layout->audioInputs.channelCount[0], 2);
+		              EXPECT_EQ (layout->audioInputs.arrangement[0], SpeakerArr::kStereo);
+		              EXPECT_EQ (layout->eventInputs.getCount (), 1);
+		              EXPECT_EQ (layout->eventInputs.channelCount[0], 16);
+		              EXPECT_EQ (layout->eventOutputs.getCount (), 1);
+		              EXPECT_TRUE (layout->eventOutputs.arrangement.empty ());
+
+		              EXPECT_EQ (effect.activateBus (kAudio, kInput, 0, true), kResultTrue);
+		              EXPECT_TRUE (effect.getProcessBusLayout ().audioInputs.isActive (0));
+		              SpeakerArrangement mono = SpeakerArr::kMono;
+		              EXPECT_EQ (effect.setBusArrangements (&mono, 1, &mono, 1), kResultTrue);
+		              layout = &effect.getProcessBusLayout ();
+		              EXPECT_EQ (layout->audioOutputs.arrangement[0], SpeakerArr::kMono);
+		              EXPECT_EQ (layout->audioOutputs.channelCount[0], 1);
+		              EXPECT_TRUE (layout->audioInputs.isActive (0));
+		              return true;
+	              });
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
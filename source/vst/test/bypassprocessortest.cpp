@@ -0,0 +1,305 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/test/bypassprocessortest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test bypass processor
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/vstbypassprocessor.h"
+#include "pluginterfaces/base/funknownimpl.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+class StereoProcessor : public U::ImplementsNonDestroyable<U::Directly<IAudioProcessor>>
+{
+public:
+	tresult PLUGIN_API setBusArrangements (SpeakerArrangement*, int32, SpeakerArrangement*,
+	                                       int32) override
+	{
+		return kResultFalse;
+	}
+	tresult PLUGIN_API getBusArrangement (BusDirection, int32 index,
+	                                      SpeakerArrangement& arr) override
+	{
+		if (index != 0)
+			return kInvalidArgument;
+		arr = SpeakerArr::kStereo;
+		return kResultOk;
+	}
+	tresult PLUGIN_API canProcessSampleSize (int32) override { return kResultTrue; }
+	uint32 PLUGIN_API getLatencySamples () override { return 0; }
+	tresult PLUGIN_API setupProcessing (ProcessSetup&) override { return kResultOk; }
+	tresult PLUGIN_API setProcessing (TBool) override { return kResultOk; }
+	tresult PLUGIN_API process (ProcessData&) override { return kResultOk; }
+	uint32 PLUGIN_API getTailSamples () override { return 0; }
+};
+
+//------------------------------------------------------------------------
+/** One stereo block, the output buffers are the input buffers for in-place processing */
+struct TestBlock
+{
+	TestBlock (int32 numSamples, bool inPlace = false)
+	: input (2, std::vector<float> (numSamples)), output (2, std::vector<float> (numSamples))
+	{
+		for (int32 channel = 0; channel < 2; channel++)
+		{
+			inputPointers[channel] = input[channel].data ();
+			outputPointers[channel] = inPlace ? input[channel].data () : output[channel].data ();
+		}
+		inBus.numChannels = outBus.numChannels = 2;
+		inBus.channelBuffers32 = inputPointers;
+		outBus.channelBuffers32 = outputPointers;
+		data.numSamples = numSamples;
+		data.symbolicSampleSize = kSample32;
+		data.numInputs = data.numOutputs = 1;
+		data.inputs = &inBus;
+		data.outputs = &outBus;
+	}
+
+	/** fills both channels with start, start + 1, ... (the second channel negated) */
+	void fillRamp (int32 start)
+	{
+		for (size_t i = 0; i < input[0].size (); i++)
+		{
+			input[0][i] = static_cast<float> (start + i);
+			input[1][i] = -static_cast<float> (start + i);
+		}
+		inBus.silenceFlags = 0;
+	}
+	/** marks the input as silent, the buffers contain garbage */
+	void fillSilence ()
+	{
+		for (auto& channel : input)
+			for (auto& sample : channel)
+				sample = 1000.f;
+		inBus.silenceFlags = 3;
+	}
+	float* out (int32 channel) { return outputPointers[channel]; }
+
+	std::vector<std::vector<float>> input;
+	std::vector<std::vector<float>> output;
+	float* inputPointers[2];
+	float* outputPointers[2];
+	AudioBusBuffers inBus;
+	AudioBusBuffers outBus;
+	ProcessData data;
+};
+
+//------------------------------------------------------------------------
+void setup (BypassProcessor<float>& bypass, int32 maxSamplesPerBlock, int32 delaySamples,
+            int32 crossfadeSamples = 0)
+{
+	StereoProcessor processor;
+	ProcessSetup processSetup {kRealtime, kSample32, maxSamplesPerBlock, 48000.};
+	bypass.setup (processor, processSetup, delaySamples, crossfadeSamples);
+	bypass.setActive (true);
+}
+
+//------------------------------------------------------------------------
+/** true if the output of the block is the ramp starting at start (zeros before 0) */
+bool isDelayedRamp (TestBlock& block, int32 start)
+{
+	for (int32 i = 0; i < block.data.numSamples; i++)
+	{
+		auto expected = start + i < 0 ? 0.f : static_cast<float> (start + i);
+		if (block.out (0)[i] != expected || block.out (1)[i] != -expected)
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer BypassProcessorTests ([] () {
+	constexpr auto TestSuiteName = "BypassProcessor";
+	registerTest (TestSuiteName, STR ("Delay"), [] (ITestResult* testResult) {
+		BypassProcessor<float> bypass;
+		setup (bypass, 8, 3);
+		TestBlock block (8);
+		for (int32 blockIndex = 0; blockIndex < 4; blockIndex++)
+		{
+			block.fillRamp (blockIndex * 8);
+			bypass.process (block.data);
+			EXPECT_TRUE (isDelayedRamp (block, blockIndex * 8 - 3));
+			EXPECT_EQ (block.outBus.silenceFlags, 0u);
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Delay longer than a block"), [] (ITestResult* testResult) {
+		BypassProcessor<float> bypass;
+		setup (bypass, 4, 10);
+		TestBlock block (4);
+		for (int32 blockIndex = 0; blockIndex < 8; blockIndex++)
+		{
+			block.fillRamp (blockIndex * 4);
+			bypass.process (block.data);
+			EXPECT_TRUE (isDelayedRamp (block, blockIndex * 4 - 10));
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("In-place processing"), [] (ITestResult* testResult) {
+		BypassProcessor<float> bypass;
+		setup (bypass, 16, 5);
+		// smaller blocks than announced, the write and read positions wrap inside of a block
+		TestBlock block (7, true);
+		for (int32 blockIndex = 0; blockIndex < 6; blockIndex++)
+		{
+			block.fillRamp (blockIndex * 7);
+			bypass.process (block.data);
+			EXPECT_TRUE (isDelayedRamp (block, blockIndex * 7 - 5));
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Silent input"), [] (ITestResult* testResult) {
+		BypassProcessor<float> bypass;
+		setup (bypass, 4, 6);
+		TestBlock block (4);
+		int32 position = 0;
+		for (int32 blockIndex = 0; blockIndex < 4; blockIndex++, position += 4)
+		{
+			block.fillRamp (position);
+			bypass.process (block.data);
+		}
+
+		// the delayed signal ends before the output is reported silent
+		block.fillSilence ();
+		bypass.process (block.data);
+		EXPECT_TRUE (isDelayedRamp (block, position - 6));
+		EXPECT_EQ (block.outBus.silenceFlags, 0u);
+		bypass.process (block.data);
+		EXPECT_EQ (block.out (0)[1], static_cast<float> (position - 1));
+		EXPECT_EQ (block.out (0)[2], 0.f);
+		EXPECT_EQ (block.outBus.silenceFlags, 0u);
+		bypass.process (block.data);
+		EXPECT_EQ (block.outBus.silenceFlags, 3u);
+		for (int32 blockIndex = 0; blockIndex < 10; blockIndex++)
+		{
+			bypass.process (block.data);
+			EXPECT_EQ (block.outBus.silenceFlags, 3u);
+			EXPECT_EQ (block.out (0)[3], 0.f);
+		}
+
+		// no old audio comes back when the input is not silent anymore
+		for (int32 blockIndex = 0; blockIndex < 4; blockIndex++)
+		{
+			block.fillRamp (blockIndex * 4);
+			bypass.process (block.data);
+			EXPECT_TRUE (isDelayedRamp (block, blockIndex * 4 - 6));
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Short silence"), [] (ITestResult* testResult) {
+		BypassProcessor<float> bypass;
+		setup (bypass, 4, 6);
+		TestBlock block (4);
+		block.fillRamp (100);
+		bypass.process (block.data);
+		bypass.process (block.data);
+		// silent long enough for a silent output, but shorter than the delay line
+		for (int32 blockIndex = 0; blockIndex < 3; blockIndex++)
+		{
+			block.fillSilence ();
+			bypass.process (block.data);
+		}
+		EXPECT_EQ (block.outBus.silenceFlags, 3u);
+		block.fillRamp (0);
+		bypass.process (block.data);
+		EXPECT_TRUE (isDelayedRamp (block, -6));
+		block.fillRamp (4);
+		bypass.process (block.data);
+		EXPECT_TRUE (isDelayedRamp (block, -2));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Crossfade"), [] (ITestResult* testResult) {
+		BypassProcessor<float> bypass;
+		StereoProcessor processor;
+		ProcessSetup processSetup {kRealtime, kSample32, 4, 48000.};
+		bypass.setup (processor, processSetup, 2, 6);
+		TestBlock block (4, true);
+
+		// the processed signal is 100, the dry signal is a ramp delayed by 2 samples
+		auto processBlock = [&] (int32 start) {
+			block.fillRamp (start);
+			bypass.processDry (block.data);
+			if (bypass.isActive () && !bypass.isCrossfading ())
+			{
+				bypass.process (block.data);
+				return;
+			}
+			for (auto& channel : block.input)
+				for (auto& sample : channel)
+					sample = 100.f;
+			if (bypass.isCrossfading ())
+				bypass.crossfade (block.data);
+		};
+		processBlock (0);
+		EXPECT_FALSE (bypass.isCrossfading ());
+		EXPECT_EQ (block.out (0)[3], 100.f);
+
+		bypass.setActive (true);
+		EXPECT_TRUE (bypass.isCrossfading ());
+		processBlock (4);
+		// sample 4 is the first of the fade: dry is 2, the gain is 1 / 6
+		EXPECT_TRUE (Test::maxDiff (block.out (0)[0], 100.f + (2.f - 100.f) / 6.f, 0.0001f));
+		EXPECT_TRUE (bypass.isCrossfading ());
+		processBlock (8);
+		// the fade ends after 6 samples, the rest of the block is dry
+		EXPECT_FALSE (bypass.isCrossfading ());
+		EXPECT_EQ (block.out (0)[2], 8.f);
+		EXPECT_EQ (block.out (1)[3], -9.f);
+		processBlock (12);
+		EXPECT_TRUE (isDelayedRamp (block, 10));
+
+		// and back to the processed signal
+		bypass.setActive (false);
+		EXPECT_TRUE (bypass.isCrossfading ());
+		processBlock (16);
+		EXPECT_TRUE (Test::maxDiff (block.out (0)[0], 100.f + (14.f - 100.f) * 5.f / 6.f,
+		                            0.0001f));
+		processBlock (20);
+		EXPECT_FALSE (bypass.isCrossfading ());
+		EXPECT_EQ (block.out (0)[3], 100.f);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,185 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/test/typedaudioeffecttest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test typed audio effect
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/audiobuffers.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/vsttypedaudioeffect.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+class GainEffect : public TypedAudioEffect<GainEffect, 1, 2>
+{
+public:
+	GainEffect ()
+	{
+		addAudioInput (STR16 ("Input"), SpeakerArr::kStereo);
+		addAudioOutput (STR16 ("Output"), SpeakerArr::kStereo);
+	}
+
+	/** halves the input and records the specialisation it was called for */
+	template <typename SampleT, int32 NumChannels>
+	void processT (ProcessData& data)
+	{
+		sampleSize = sizeof (SampleT);
+		channelCount = NumChannels;
+		auto in = getChannelBuffers<SampleT> (data.inputs[0]);
+		auto out = getChannelBuffers<SampleT> (data.outputs[0]);
+		auto numChannels = NumChannels ? NumChannels : data.outputs[0].numChannels;
+		for (int32 channel = 0; channel < numChannels; channel++)
+		{
+			for (int32 i = 0; i < data.numSamples; i++)
+				out[channel][i] = in[channel][i] * static_cast<SampleT> (0.5);
+		}
+	}
+
+	using TypedAudioEffect::getProcessChannelCount;
+
+	size_t sampleSize {0};
+	int32 channelCount {-1};
+};
+
+//------------------------------------------------------------------------
+/** One block with an input and an output bus of numChannels */
+template <typename SampleT>
+struct TestBlock
+{
+	TestBlock (int32 numChannels, int32 numSamples)
+	: input (numChannels, std::vector<SampleT> (numSamples, static_cast<SampleT> (1)))
+	, output (numChannels, std::vector<SampleT> (numSamples))
+	, inputPointers (numChannels)
+	, outputPointers (numChannels)
+	{
+		for (int32 channel = 0; channel < numChannels; channel++)
+		{
+			inputPointers[channel] = input[channel].data ();
+			outputPointers[channel] = output[channel].data ();
+		}
+		inBus.numChannels = outBus.numChannels = numChannels;
+		if constexpr (std::is_same<SampleT, Sample32>::value)
+		{
+			inBus.channelBuffers32 = inputPointers.data ();
+			outBus.channelBuffers32 = outputPointers.data ();
+			data.symbolicSampleSize = kSample32;
+		}
+		else
+		{
+			inBus.channelBuffers64 = inputPointers.data ();
+			outBus.channelBuffers64 = outputPointers.data ();
+			data.symbolicSampleSize = kSample64;
+		}
+		data.numSamples = numSamples;
+		data.numInputs = data.numOutputs = 1;
+		data.inputs = &inBus;
+		data.outputs = &outBus;
+	}
+
+	std::vector<std::vector<SampleT>> input;
+	std::vector<std::vector<SampleT>> output;
+	std::vector<SampleT*> inputPointers;
+	std::vector<SampleT*> outputPointers;
+	AudioBusBuffers inBus;
+	AudioBusBuffers outBus;
+	ProcessData data;
+};
+
+//------------------------------------------------------------------------
+/** processes one block with the arrangement and returns false if the wrong specialisation ran */
+template <typename SampleT>
+bool processOnce (ITestResult* testResult, SpeakerArrangement arrangement,
+                  int32 expectedChannelCount)
+{
+	GainEffect effect;
+	auto numChannels = SpeakerArr::getChannelCount (arrangement);
+	TestBlock<SampleT> block (numChannels, 8);
+
+	EXPECT_EQ (effect.setBusArrangements (&arrangement, 1, &arrangement, 1), kResultTrue);
+	ProcessSetup setup {kRealtime, block.data.symbolicSampleSize, 8, 48000.};
+	EXPECT_EQ (effect.setupProcessing (setup), kResultTrue);
+	EXPECT_EQ (effect.getProcessChannelCount (), expectedChannelCount);
+	EXPECT_EQ (effect.process (block.data), kResultOk);
+
+	EXPECT_EQ (effect.sampleSize, sizeof (SampleT));
+	EXPECT_EQ (effect.channelCount, expectedChannelCount);
+	for (int32 channel = 0; channel < numChannels; channel++)
+	{
+		EXPECT_EQ (block.output[channel][0], static_cast<SampleT> (0.5));
+		EXPECT_EQ (block.output[channel][7], static_cast<SampleT> (0.5));
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer TypedAudioEffectTests ([] () {
+	constexpr auto TestSuiteName = "TypedAudioEffect";
+	registerTest (TestSuiteName, STR ("Mono 32 bit"), [] (ITestResult* testResult) {
+		return processOnce<Sample32> (testResult, SpeakerArr::kMono, 1);
+	});
+	registerTest (TestSuiteName, STR ("Mono 64 bit"), [] (ITestResult* testResult) {
+		return processOnce<Sample64> (testResult, SpeakerArr::kMono, 1);
+	});
+	registerTest (TestSuiteName, STR ("Stereo 32 bit"), [] (ITestResult* testResult) {
+		return processOnce<Sample32> (testResult, SpeakerArr::kStereo, 2);
+	});
+	registerTest (TestSuiteName, STR ("Stereo 64 bit"), [] (ITestResult* testResult) {
+		return processOnce<Sample64> (testResult, SpeakerArr::kStereo, 2);
+	});
+	registerTest (TestSuiteName, STR ("Unsupported channel count 32 bit"),
+	              [] (ITestResult* testResult) {
+		              return processOnce<Sample32> (testResult, SpeakerArr::k51, 0);
+	              });
+	registerTest (TestSuiteName, STR ("Unsupported channel count 64 bit"),
+	              [] (ITestResult* testResult) {
+		              return processOnce<Sample64> (testResult, SpeakerArr::k51, 0);
+	              });
+	registerTest (TestSuiteName, STR ("Sample size"), [] (ITestResult* testResult) {
+		GainEffect effect;
+		EXPECT_EQ (effect.canProcessSampleSize (kSample32), kResultTrue);
+		EXPECT_EQ (effect.canProcessSampleSize (kSample64), kResultTrue);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
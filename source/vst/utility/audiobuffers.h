@@ -62,6 +62,19 @@ inline Sample64** getChannelBuffers (AudioBusBuffers& buffer)
 	return buffer.channelBuffers64;
 }
 
+//------------------------------------------------------------------------
+/** get channel buffers from audio bus buffers for the sample type (Sample32 or Sample64) */
+template <typename SampleT>
+inline SampleT** getChannelBuffers (AudioBusBuffers& buffer)
+{
+	static_assert (std::is_same<SampleT, Sample32>::value || std::is_same<SampleT, Sample64>::value,
+	               "SampleT must be Sample32 or Sample64");
+	if constexpr (std::is_same<SampleT, Sample32>::value)
+		return buffer.channelBuffers32;
+	else
+		return buffer.channelBuffers64;
+}
+
 //------------------------------------------------------------------------
 } // Vst
 } // Steinberg
@@ -38,16 +38,24 @@
 
 #include "pluginterfaces/base/funknownimpl.h"
 #include "pluginterfaces/base/ibstream.h"
+#include <algorithm>
 #include <vector>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
 
 //------------------------------------------------------------------------
+/** IBStream implementation based on a std::vector.
+ *
+ *	The buffer grows geometrically. To reuse the memory for repeated state saves either call
+ *	clear () on the same stream or take () the buffer and give it back to a new stream.
+ */
 class ResizableMemoryIBStream : public U::Implements<U::Directly<IBStream>>
 {
 public:
 	inline ResizableMemoryIBStream (size_t reserve = 0);
+	/** reuse the memory of the buffer, its content is discarded */
+	inline ResizableMemoryIBStream (std::vector<uint8>&& buffer);
 
 	inline tresult PLUGIN_API read (void* buffer, int32 numBytes, int32* numBytesRead) override;
 	inline tresult PLUGIN_API write (void* buffer, int32 numBytes, int32* numBytesWritten) override;
@@ -56,7 +64,12 @@ public:
 
 	inline size_t getCursor () const;
 	inline const void* getData () const;
+	inline size_t getSize () const;
 	inline void rewind ();
+	/** discard the content but keep the memory */
+	inline void clear ();
+	/** make sure that capacity bytes can be written without reallocation */
+	inline void reserve (size_t capacity);
 	inline std::vector<uint8>&& take ();
 
 private:
@@ -71,6 +84,13 @@ inline ResizableMemoryIBStream::ResizableMemoryIBStream (size_t reserve)
 		data.reserve (reserve);
 }
 
+//------------------------------------------------------------------------
+inline ResizableMemoryIBStream::ResizableMemoryIBStream (std::vector<uint8>&& buffer)
+: data (std::move (buffer))
+{
+	data.clear ();
+}
+
 //------------------------------------------------------------------------
 inline tresult PLUGIN_API ResizableMemoryIBStream::read (void* buffer, int32 numBytes,
                                                          int32* numBytesRead)
@@ -95,15 +115,8 @@ inline tresult PLUGIN_API ResizableMemoryIBStream::write (void* buffer, int32 nu
 	if (numBytes < 0 || buffer == nullptr)
 		return kInvalidArgument;
 	auto requiredSize = cursor + numBytes;
-	if (requiredSize >= data.capacity ())
-	{
-		auto mod = (requiredSize % 1024);
-		if (mod)
-		{
-			auto reserve = requiredSize + (1024 - mod);
-			data.reserve (reserve);
-		}
-	}
+	if (requiredSize > data.capacity ())
+		reserve (std::max (requiredSize, data.capacity () + data.capacity () / 2));
 	if (data.size () < requiredSize)
 		data.resize (requiredSize);
 	memcpy (data.data () + cursor, buffer, numBytes);
@@ -156,6 +169,30 @@ inline const void* ResizableMemoryIBStream::getData () const
 	return data.data ();
 }
 
+//------------------------------------------------------------------------
+inline size_t ResizableMemoryIBStream::getSize () const
+{
+	return data.size ();
+}
+
+//------------------------------------------------------------------------
+inline void ResizableMemoryIBStream::clear ()
+{
+	data.clear ();
+	cursor = 0;
+}
+
+//------------------------------------------------------------------------
+inline void ResizableMemoryIBStream::reserve (size_t capacity)
+{
+	if (capacity <= data.capacity ())
+		return;
+	auto mod = (capacity % 1024);
+	if (mod)
+		capacity += (1024 - mod);
+	data.reserve (capacity);
+}
+
 //------------------------------------------------------------------------
 inline std::vector<uint8>&& ResizableMemoryIBStream::take ()
 {
@@ -44,42 +44,129 @@ namespace Steinberg {
 namespace Vst {
 namespace MPE {
 
+static constexpr auto NumMIDIChannels = 16u;
+static constexpr auto NumControllers = static_cast<size_t> (Controller::None);
+static constexpr auto NumInputMIDIMessages = static_cast<size_t> (Aftertouch) + 1;
+
 //------------------------------------------------------------------------
-struct Note
+/** size of a MIDI message in bytes, system exclusive messages excluded */
+static constexpr size_t messageSize (uint8_t status)
 {
-	NoteID noteID;
-	Pitch pitch;
-};
+	switch (status & 0xF0)
+	{
+		case 0xc0:
+		case 0xd0: return 2;
+		case 0xf0:
+		{
+			switch (status)
+			{
+				case 0xf1:
+				case 0xf3: return 2;
+				case 0xf2: return 3;
+			}
+			return 1;
+		}
+	}
+	return 3;
+}
 
 //------------------------------------------------------------------------
-struct ChannelData
+/** Note table with a fixed capacity per channel
+ *
+ *	The note IDs and pitches of all channels are stored in two contiguous arrays allocated once.
+ *	The notes of a channel occupy the slots [channel * capacity, channel * capacity + count) in
+ *	the order of their note on.
+ */
+struct NoteTable
 {
-	using NoteList = std::vector<Note>;
+	void init (size_t capacityPerChannel)
+	{
+		capacity = capacityPerChannel;
+		noteIDs.assign (capacity * NumMIDIChannels, 0);
+		pitches.assign (capacity * NumMIDIChannels, 0);
+		counts.fill (0);
+	}
+
+	size_t count (Channel channel) const { return counts[channel]; }
+	bool full (Channel channel) const { return counts[channel] >= capacity; }
+
+	NoteID* noteIDsOf (Channel channel) { return noteIDs.data () + channel * capacity; }
+	uint8_t* pitchesOf (Channel channel) { return pitches.data () + channel * capacity; }
+
+	void add (Channel channel, NoteID noteID, Pitch pitch)
+	{
+		assert (!full (channel));
+		auto index = counts[channel]++;
+		noteIDsOf (channel)[index] = noteID;
+		pitchesOf (channel)[index] = static_cast<uint8_t> (pitch);
+	}
+
+	/** @return the index of the oldest note with the pitch or -1 */
+	int32_t find (Channel channel, Pitch pitch)
+	{
+		auto p = pitchesOf (channel);
+		for (size_t index = 0, end = counts[channel]; index < end; ++index)
+		{
+			if (p[index] == pitch)
+				return static_cast<int32_t> (index);
+		}
+		return -1;
+	}
+
+	void remove (Channel channel, size_t index)
+	{
+		auto ids = noteIDsOf (channel);
+		auto p = pitchesOf (channel);
+		auto end = --counts[channel];
+		for (; index < end; ++index)
+		{
+			ids[index] = ids[index + 1];
+			p[index] = p[index + 1];
+		}
+	}
+
+	void clear (Channel channel) { counts[channel] = 0; }
 
-	NoteList notes;
-	NormalizedValue pressure {0.};
-	NormalizedValue x {0.5};
-	NormalizedValue y {0.};
+	std::vector<NoteID> noteIDs;
+	std::vector<uint8_t> pitches;
+	std::array<uint32_t, NumMIDIChannels> counts {};
+	size_t capacity {0};
 };
 
 //------------------------------------------------------------------------
 struct Processor::Impl
 {
-	static constexpr auto NumMIDIChannels = 16u;
-	using ChannelDataList = std::array<ChannelData, NumMIDIChannels>;
+	using ControllerValues = std::array<NormalizedValue, NumMIDIChannels>;
 
 	Handler* delegate {nullptr};
 	Setup setup;
-	ChannelDataList channelData {};
-	size_t dataBufferUsed {0};
-	size_t maxNotesPerChannel {16};
+	NoteTable notes;
+	std::array<ControllerValues, NumControllers> controllerValues;
+	std::array<Controller, NumInputMIDIMessages> controllerMap;
+	std::array<uint8_t, 3> pending {};
+	size_t pendingSize {0};
+	uint8_t runningStatus {0};
 	bool inSysex {false};
 
-	Impl (Handler* delegate, size_t maxNotesPerChannel)
-	: delegate (delegate), maxNotesPerChannel (maxNotesPerChannel)
+	Impl (Handler* delegate, size_t maxNotesPerChannel) : delegate (delegate)
 	{
-		for (auto& cd : channelData)
-			cd.notes.reserve (maxNotesPerChannel);
+		notes.init (maxNotesPerChannel);
+		controllerValues[static_cast<size_t> (Controller::Pressure)].fill (0.);
+		controllerValues[static_cast<size_t> (Controller::X)].fill (0.5);
+		controllerValues[static_cast<size_t> (Controller::Y)].fill (0.);
+		updateControllerMap ();
+	}
+
+	void updateControllerMap ()
+	{
+		// the first match wins like in the setup order pressure, x, y
+		controllerMap.fill (Controller::None);
+		if (setup.y < NumInputMIDIMessages)
+			controllerMap[setup.y] = Controller::Y;
+		if (setup.x < NumInputMIDIMessages)
+			controllerMap[setup.x] = Controller::X;
+		if (setup.pressure < NumInputMIDIMessages)
+			controllerMap[setup.pressure] = Controller::Pressure;
 	}
 
 	bool inMPEZone (uint8_t channel) const
@@ -89,36 +176,40 @@ struct Processor::Impl
 
 	Controller getController (InputMIDIMessage input) const
 	{
-		if (setup.pressure == input)
-			return Controller::Pressure;
-		if (setup.x == input)
-			return Controller::X;
-		if (setup.y == input)
-			return Controller::Y;
-		return Controller::None;
+		return input < NumInputMIDIMessages ? controllerMap[input] : Controller::None;
 	}
 
-	NormalizedValue getControllerValue (Controller controller, const ChannelData& data) const
+	NormalizedValue getControllerValue (Controller controller, Channel channel) const
 	{
-		switch (controller)
-		{
-			case Controller::Pressure: return data.pressure;
-			case Controller::X: return data.x;
-			case Controller::Y: return data.y;
-			case Controller::None: assert (false); break;
-		}
-		return 0.;
+		assert (controller != Controller::None);
+		return controllerValues[static_cast<size_t> (controller)][channel];
 	}
 
-	void setControllerValue (Controller controller, ChannelData& data, NormalizedValue value)
+	void changeController (Controller controller, Channel channel, NormalizedValue value)
 	{
-		switch (controller)
+		assert (controller != Controller::None);
+		controllerValues[static_cast<size_t> (controller)][channel] = value;
+		auto ids = notes.noteIDsOf (channel);
+		for (size_t index = 0, end = notes.count (channel); index < end; ++index)
+			delegate->onMPEControllerChange (ids[index], controller, value);
+	}
+
+	/** @return number of bytes consumed */
+	size_t processSysex (const uint8_t* data, size_t dataSize)
+	{
+		for (size_t index = 0; index < dataSize; ++index)
 		{
-			case Controller::Pressure: data.pressure = value; break;
-			case Controller::X: data.x = value; break;
-			case Controller::Y: data.y = value; break;
-			case Controller::None: assert (false); break;
+			if (data[index] == 0xf7)
+			{
+				++index;
+				delegate->onSysexInput (data, index);
+				inSysex = false;
+				return index;
+			}
 		}
+		inSysex = true;
+		delegate->onSysexInput (data, dataSize);
+		return dataSize;
 	}
 };
 
@@ -141,20 +232,26 @@ const Setup& Processor::getSetup () const
 void Processor::changeSetup (const Setup& setup)
 {
 	impl->setup = setup;
+	impl->updateControllerMap ();
 }
 
 //------------------------------------------------------------------------
 void Processor::reset ()
 {
-	for (auto& cd : impl->channelData)
+	auto& notes = impl->notes;
+	for (auto channel = 0u; channel < NumMIDIChannels; ++channel)
 	{
-		for (auto& note : cd.notes)
+		auto ids = notes.noteIDsOf (channel);
+		auto pitches = notes.pitchesOf (channel);
+		for (size_t index = 0, end = notes.count (channel); index < end; ++index)
 		{
-			impl->delegate->onMPENoteOff (note.noteID, note.pitch, 0.f);
-			impl->delegate->releaseNoteID (note.noteID);
+			impl->delegate->onMPENoteOff (ids[index], pitches[index], 0.f);
+			impl->delegate->releaseNoteID (ids[index]);
 		}
-		cd.notes.clear ();
+		notes.clear (channel);
 	}
+	impl->pendingSize = 0;
+	impl->runningStatus = 0;
 }
 
 //------------------------------------------------------------------------
@@ -166,26 +263,27 @@ int32_t Processor::onNoteOn (const uint8_t* data, size_t dataSize)
 	auto channel = data[0] & 0x0F;
 	if (impl->inMPEZone (channel))
 	{
-		auto& channelData = impl->channelData[channel];
 		auto pitch = data[1];
-		if (channelData.notes.size () >= impl->maxNotesPerChannel)
+		if (impl->notes.full (channel))
 		{
 			// error note stack full
 			impl->delegate->errorNoteDroppedBecauseNoteStackFull (channel, pitch);
 		}
 		else
 		{
-			Note note;
-			if (impl->delegate->generateNewNoteID (note.noteID))
+			NoteID noteID;
+			if (impl->delegate->generateNewNoteID (noteID))
 			{
-				note.pitch = pitch;
-				channelData.notes.push_back (note);
+				impl->notes.add (channel, noteID, pitch);
 				auto velocity = static_cast<Velocity> (data[2]) / 127.f;
-				impl->delegate->onMPENoteOn (note.noteID, note.pitch, velocity);
-				impl->delegate->onMPEControllerChange (note.noteID, Controller::Pressure,
-				                                       channelData.pressure);
-				impl->delegate->onMPEControllerChange (note.noteID, Controller::X, channelData.x);
-				impl->delegate->onMPEControllerChange (note.noteID, Controller::Y, channelData.y);
+				impl->delegate->onMPENoteOn (noteID, pitch, velocity);
+				impl->delegate->onMPEControllerChange (
+				    noteID, Controller::Pressure,
+				    impl->getControllerValue (Controller::Pressure, channel));
+				impl->delegate->onMPEControllerChange (
+				    noteID, Controller::X, impl->getControllerValue (Controller::X, channel));
+				impl->delegate->onMPEControllerChange (
+				    noteID, Controller::Y, impl->getControllerValue (Controller::Y, channel));
 			}
 			else
 			{
@@ -208,21 +306,17 @@ int32_t Processor::onNoteOff (const uint8_t* data, size_t dataSize)
 	auto channel = data[0] & 0x0F;
 	if (impl->inMPEZone (channel))
 	{
-		bool noteFound = false;
-		auto& notes = impl->channelData[channel].notes;
-		for (auto it = notes.begin (); it != notes.end (); ++it)
+		auto& notes = impl->notes;
+		auto index = notes.find (channel, data[1]);
+		if (index >= 0)
 		{
-			if (it->pitch == data[1])
-			{
-				auto velocity = static_cast<Velocity> (data[2]) / 127.f;
-				impl->delegate->onMPENoteOff (it->noteID, it->pitch, velocity);
-				impl->delegate->releaseNoteID (it->noteID);
-				notes.erase (it);
-				noteFound = true;
-				break;
-			}
+			auto noteID = notes.noteIDsOf (channel)[index];
+			auto velocity = static_cast<Velocity> (data[2]) / 127.f;
+			impl->delegate->onMPENoteOff (noteID, data[1], velocity);
+			impl->delegate->releaseNoteID (noteID);
+			notes.remove (channel, index);
 		}
-		if (!noteFound)
+		else
 		{
 			// error: no note for note off found
 			impl->delegate->errorNoteForNoteOffNotFound (channel, data[1]);
@@ -245,13 +339,8 @@ int32_t Processor::onAftertouch (const uint8_t* data, size_t dataSize)
 		auto channel = data[0] & 0x0F;
 		if (impl->inMPEZone (channel))
 		{
-			auto& channelData = impl->channelData[channel];
 			auto value = static_cast<NormalizedValue> (data[2]) / 127.;
-			impl->setControllerValue (controller, channelData, value);
-			for (auto& note : channelData.notes)
-			{
-				impl->delegate->onMPEControllerChange (note.noteID, controller, value);
-			}
+			impl->changeController (controller, channel, value);
 			return 3;
 		}
 	}
@@ -270,13 +359,8 @@ int32_t Processor::onController (const uint8_t* data, size_t dataSize)
 		auto channel = data[0] & 0x0F;
 		if (impl->inMPEZone (channel))
 		{
-			auto& channelData = impl->channelData[channel];
 			auto value = static_cast<NormalizedValue> (data[2]) / 127.;
-			impl->setControllerValue (controller, channelData, value);
-			for (auto& note : channelData.notes)
-			{
-				impl->delegate->onMPEControllerChange (note.noteID, controller, value);
-			}
+			impl->changeController (controller, channel, value);
 			return 3;
 		}
 	}
@@ -311,13 +395,8 @@ int32_t Processor::onChannelPressure (const uint8_t* data, size_t dataSize)
 		auto channel = data[0] & 0x0F;
 		if (impl->inMPEZone (channel))
 		{
-			auto& channelData = impl->channelData[channel];
 			auto value = static_cast<NormalizedValue> (data[1]) / 127.;
-			impl->setControllerValue (controller, channelData, value);
-			for (auto& note : channelData.notes)
-			{
-				impl->delegate->onMPEControllerChange (note.noteID, controller, value);
-			}
+			impl->changeController (controller, channel, value);
 			return 2;
 		}
 	}
@@ -335,14 +414,9 @@ int32_t Processor::onPitchWheel (const uint8_t* data, size_t dataSize)
 		auto channel = data[0] & 0x0F;
 		if (impl->inMPEZone (channel))
 		{
-			auto& channelData = impl->channelData[channel];
 			auto value =
 			    static_cast<NormalizedValue> ((data[1] & 0x7F) + ((data[2] & 0x7F) << 7)) / 16383.;
-			impl->setControllerValue (controller, channelData, value);
-			for (auto& note : channelData.notes)
-			{
-				impl->delegate->onMPEControllerChange (note.noteID, controller, value);
-			}
+			impl->changeController (controller, channel, value);
 			return 3;
 		}
 	}
@@ -351,31 +425,11 @@ int32_t Processor::onPitchWheel (const uint8_t* data, size_t dataSize)
 }
 
 //------------------------------------------------------------------------
-void Processor::processMIDIInput (const uint8_t* data, size_t dataSize)
+size_t Processor::dispatchMessage (const uint8_t* data, size_t dataSize)
 {
-	assert (dataSize > 0);
-	if (impl->inSysex || data[0] == 0xf0)
-	{
-		for (size_t index = 0; index < dataSize; ++index)
-		{
-			if (data[index] == 0xf7)
-			{
-				++index;
-				impl->delegate->onSysexInput (data, index);
-				impl->inSysex = false;
-				auto dataLeft = dataSize - index;
-				if (dataLeft != 0)
-				{
-					processMIDIInput (data + index, dataSize - index);
-				}
-				return;
-			}
-		}
-		impl->inSysex = true;
-		impl->delegate->onSysexInput (data, dataSize);
-		return;
-	}
-
+	// incomplete messages are dropped
+	if (messageSize (data[0]) > dataSize)
+		return 0;
 	auto status = static_cast<uint8_t> (data[0] & 0xF0);
 	int32_t packetSize = 0;
 	switch (status)
@@ -415,21 +469,117 @@ void Processor::processMIDIInput (const uint8_t* data, size_t dataSize)
 			packetSize = onPitchWheel (data, dataSize);
 			break;
 		}
-		case 0xf0: // System Realtime Messages
+		case 0xf0: // System Common and System Realtime Messages
 		{
-			impl->delegate->onOtherInput (data, 1);
-			packetSize = 1;
+			packetSize = static_cast<int32_t> (messageSize (data[0]));
+			impl->delegate->onOtherInput (data, packetSize);
 			break;
 		}
 		default:
 		{
 			// Ehm...
 			assert (false);
+			return 0;
+		}
+	}
+	return static_cast<size_t> (packetSize);
+}
+
+//------------------------------------------------------------------------
+void Processor::processMIDIInput (const uint8_t* data, size_t dataSize)
+{
+	assert (dataSize > 0);
+	while (dataSize > 0)
+	{
+		size_t used;
+		if (impl->inSysex || data[0] == 0xf0)
+			used = impl->processSysex (data, dataSize);
+		else
+			used = dispatchMessage (data, dataSize);
+		if (used == 0)
 			return;
+		data += used;
+		dataSize -= used;
+	}
+}
+
+//------------------------------------------------------------------------
+void Processor::processMIDIInputBlock (const uint8_t* data, size_t dataSize)
+{
+	auto& pending = impl->pending;
+	size_t index = 0;
+	while (index < dataSize)
+	{
+		auto byte = data[index];
+		if (impl->inSysex || byte == 0xf0)
+		{
+			// system exclusive messages cancel the running status, too
+			impl->runningStatus = 0;
+			impl->pendingSize = 0;
+			index += impl->processSysex (data + index, dataSize - index);
+			continue;
+		}
+		if (byte >= 0xf8)
+		{
+			// realtime messages may appear anywhere, even inside of other messages
+			impl->delegate->onOtherInput (data + index, 1);
+			++index;
+			continue;
+		}
+		if (byte & 0x80)
+		{
+			// system common messages cancel the running status
+			impl->runningStatus = byte < 0xf0 ? byte : 0;
+			auto size = messageSize (byte);
+			if (size <= dataSize - index)
+			{
+				bool complete = true;
+				for (size_t i = 1; i < size; ++i)
+					complete &= data[index + i] < 0x80;
+				if (complete)
+				{
+					// fast path: the message is contiguous in the block
+					impl->pendingSize = 0;
+					dispatchMessage (data + index, size);
+					index += size;
+					continue;
+				}
+			}
+			pending[0] = byte;
+			impl->pendingSize = 1;
+		}
+		else
+		{
+			if (impl->pendingSize == 0)
+			{
+				if (impl->runningStatus == 0)
+				{
+					// data byte without status
+					++index;
+					continue;
+				}
+				auto size = messageSize (impl->runningStatus) - 1;
+				if (size <= dataSize - index && (size == 1 || data[index + 1] < 0x80))
+				{
+					// fast path: running status message contiguous in the block
+					const uint8_t message[3] = {impl->runningStatus, byte,
+					                            size == 2 ? data[index + 1] : uint8_t (0)};
+					dispatchMessage (message, size + 1);
+					index += size;
+					continue;
+				}
+				pending[0] = impl->runningStatus;
+				impl->pendingSize = 1;
+			}
+			pending[impl->pendingSize++] = byte;
+		}
+		++index;
+		if (impl->pendingSize == messageSize (pending[0]))
+		{
+			dispatchMessage (pending.data (), impl->pendingSize);
+			impl->pendingSize = 0;
 		}
 	}
-	if (dataSize > static_cast<size_t> (packetSize))
-		processMIDIInput (data + packetSize, dataSize - packetSize);
 }
 
 //------------------------------------------------------------------------
@@ -192,7 +192,19 @@ public:
 	 */
 	void processMIDIInput (const uint8_t* data, size_t dataSize);
 
+	/** feed a block of native MIDI data
+	 *
+	 *	The block may contain any number of messages including running status and realtime
+	 *	messages inside of other messages. A message which is incomplete at the end of the block
+	 *	is completed with the data of the next call.
+	 *
+	 *	@param data MIDI data buffer
+	 *	@param dataSize data buffer size in bytes
+	 */
+	void processMIDIInputBlock (const uint8_t* data, size_t dataSize);
+
 private:
+	size_t dispatchMessage (const uint8_t* data, size_t dataSize);
 	int32_t onNoteOn (const uint8_t* data, size_t dataSize);
 	int32_t onNoteOff (const uint8_t* data, size_t dataSize);
 	int32_t onAftertouch (const uint8_t* data, size_t dataSize);
@@ -0,0 +1,426 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/parameterstore.h
+// Created by  : Steinberg, 10/2026
+// Description : Lock-free parameter value store
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** Lock-free store of parameter values shared between processor and controller
+ *
+ *	Every parameter owns a slot holding its normalized value and the plain value derived from it.
+ *	The toPlain curve of each parameter is sampled once in setup, so the plain value can be
+ *	computed in the realtime context without calling into the parameter object.
+ *
+ *	Every change marks the parameter in a dirty bitset per consumer (processor and controller).
+ *	A consumer only has to scan its bitset to find out which parameters changed since it looked
+ *	the last time, instead of walking all parameters or parsing the IParameterChanges again.
+ *
+ *	setup must be called from a non realtime thread while no other thread uses the store. All other
+ *	methods are wait free and do not allocate, so the realtime thread and the UI thread can use the
+ *	store concurrently. A reader may briefly see a new normalized value together with the previous
+ *	plain value, but in this case the parameter is still marked dirty and the next scan delivers the
+ *	matching pair.
+ */
+class ParameterStore
+{
+public:
+	/** Consumers of changes, can be combined to notify several consumers at once */
+	enum Consumer : uint32
+	{
+		kProcessor = 1 << 0,
+		kController = 1 << 1
+	};
+
+	static constexpr uint32 kInvalidIndex = 0xFFFFFFFF;
+	/** Number of segments the toPlain curve of a continuous parameter is sampled with */
+	static constexpr int32 kCurveResolution = 256;
+	/** Discrete parameters with more steps are sampled like continuous ones */
+	static constexpr int32 kMaxTabulatedSteps = 4096;
+
+	/** Description of one parameter, only used during setup */
+	struct Definition
+	{
+		ParamID id {kNoParamId};
+		/** initial normalized value */
+		ParamValue normalized {0.};
+		int32 stepCount {0};
+		/** normalized to plain conversion, if empty the plain value equals the normalized one */
+		std::function<ParamValue (ParamValue)> toPlain;
+	};
+
+	/** Setup the store for the parameters
+	 *
+	 *	Not realtime safe. All parameters are marked as changed for the processor afterwards, so that
+	 *	its first scan delivers the initial values.
+	 *
+	 *	@param definitions the parameters
+	 */
+	void setup (const std::vector<Definition>& definitions);
+
+	/** Get the number of parameters */
+	uint32 getParameterCount () const noexcept;
+	/** Get the index of a parameter
+	 *
+	 *	@return the index or kInvalidIndex if the parameter is unknown
+	 */
+	uint32 getIndex (ParamID id) const noexcept;
+	/** Get the ID of the parameter at index */
+	ParamID getParamID (uint32 index) const noexcept;
+
+	/** Get the current normalized value of the parameter at index */
+	ParamValue getNormalized (uint32 index) const noexcept;
+	/** Get the current plain value of the parameter at index */
+	ParamValue getPlain (uint32 index) const noexcept;
+	/** Convert a normalized value with the sampled toPlain curve of the parameter at index */
+	ParamValue toPlain (uint32 index, ParamValue normalized) const noexcept;
+
+	/** Set the normalized value of the parameter at index
+	 *
+	 *	@param index index of the parameter
+	 *	@param normalized the new value
+	 *	@param notify combination of Consumer flags to mark the parameter as changed for
+	 *	@return true if the value has changed
+	 */
+	bool setNormalized (uint32 index, ParamValue normalized, uint32 notify) noexcept;
+
+	/** Apply the last value of each queue in the parameter changes
+	 *
+	 *	@param changes the input parameter changes of the process call, may be nullptr
+	 *	@param notify combination of Consumer flags to mark the changed parameters for
+	 *	@return number of parameters which have changed
+	 */
+	uint32 applyChanges (IParameterChanges* changes,
+	                     uint32 notify = kProcessor | kController) noexcept;
+
+	/** Mark all parameters as changed */
+	void markAllChanged (uint32 notify) noexcept;
+
+	/** Are there any parameters marked as changed for the consumer */
+	bool hasChanges (Consumer consumer) const noexcept;
+
+	/** Clear the changed marks of the consumer and call proc with the index of each parameter which
+	 *	was marked
+	 *
+	 *	@param consumer the consumer
+	 *	@param proc called as proc (uint32 index) in ascending index order
+	 *	@return number of changed parameters
+	 */
+	template <typename Proc>
+	uint32 consumeChanges (Consumer consumer, Proc proc);
+
+//------------------------------------------------------------------------
+private:
+	using DirtyWord = std::atomic<uint64>;
+	static constexpr uint32 kBitsPerWord = 64;
+
+	struct Slot
+	{
+		std::atomic<ParamValue> normalized {0.};
+		std::atomic<ParamValue> plain {0.};
+	};
+
+	struct Curve
+	{
+		/** number of tabulated steps, 0 for an interpolated curve */
+		int32 stepCount {0};
+		uint32 offset {0};
+	};
+
+	static uint32 countTrailingZeros (uint64 bits) noexcept;
+	DirtyWord* getDirtyWords (Consumer consumer) const noexcept;
+	void markChanged (uint32 index, uint32 notify) noexcept;
+
+	std::unique_ptr<Slot[]> slots;
+	std::unique_ptr<DirtyWord[]> dirtyWords;
+	std::vector<ParamID> paramIDs;
+	std::vector<Curve> curves;
+	std::vector<ParamValue> curvePoints;
+	std::unordered_map<ParamID, uint32> indexMap;
+	uint32 numParameters {0};
+	uint32 numDirtyWords {0};
+};
+
+//------------------------------------------------------------------------
+inline void ParameterStore::setup (const std::vector<Definition>& definitions)
+{
+	numParameters = static_cast<uint32> (definitions.size ());
+	numDirtyWords = (numParameters + kBitsPerWord - 1) / kBitsPerWord;
+	slots.reset (numParameters ? new Slot[numParameters] : nullptr);
+	dirtyWords.reset (numDirtyWords ? new DirtyWord[numDirtyWords * 2] : nullptr);
+	for (uint32 i = 0; i < numDirtyWords * 2; ++i)
+		dirtyWords[i].store (0);
+	paramIDs.clear ();
+	curves.clear ();
+	curvePoints.clear ();
+	indexMap.clear ();
+	paramIDs.reserve (numParameters);
+	curves.reserve (numParameters);
+	indexMap.reserve (numParameters);
+
+	for (uint32 index = 0; index < numParameters; ++index)
+	{
+		const auto& definition = definitions[index];
+		auto convert = [&] (ParamValue value) {
+			return definition.toPlain ? definition.toPlain (value) : value;
+		};
+		Curve curve;
+		curve.offset = static_cast<uint32> (curvePoints.size ());
+		if (definition.stepCount > 0 && definition.stepCount <= kMaxTabulatedSteps)
+		{
+			curve.stepCount = definition.stepCount;
+			for (int32 step = 0; step <= curve.stepCount; ++step)
+				curvePoints.push_back (
+				    convert (static_cast<ParamValue> (step) / static_cast<ParamValue> (curve.stepCount)));
+		}
+		else
+		{
+			for (int32 point = 0; point <= kCurveResolution; ++point)
+				curvePoints.push_back (
+				    convert (static_cast<ParamValue> (point) / static_cast<ParamValue> (kCurveResolution)));
+		}
+		curves.push_back (curve);
+		paramIDs.push_back (definition.id);
+		indexMap.emplace (definition.id, index);
+	}
+
+	for (uint32 index = 0; index < numParameters; ++index)
+	{
+		auto normalized = definitions[index].normalized;
+		slots[index].normalized.store (normalized);
+		slots[index].plain.store (toPlain (index, normalized));
+	}
+	markAllChanged (kProcessor);
+}
+
+//------------------------------------------------------------------------
+inline uint32 ParameterStore::getParameterCount () const noexcept
+{
+	return numParameters;
+}
+
+//------------------------------------------------------------------------
+inline uint32 ParameterStore::getIndex (ParamID id) const noexcept
+{
+	auto it = indexMap.find (id);
+	return it != indexMap.end () ? it->second : kInvalidIndex;
+}
+
+//------------------------------------------------------------------------
+inline ParamID ParameterStore::getParamID (uint32 index) const noexcept
+{
+	return index < numParameters ? paramIDs[index] : kNoParamId;
+}
+
+//------------------------------------------------------------------------
+inline ParamValue ParameterStore::getNormalized (uint32 index) const noexcept
+{
+	assert (index < numParameters);
+	return slots[index].normalized.load (std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------
+inline ParamValue ParameterStore::getPlain (uint32 index) const noexcept
+{
+	assert (index < numParameters);
+	return slots[index].plain.load (std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------
+inline ParamValue ParameterStore::toPlain (uint32 index, ParamValue normalized) const noexcept
+{
+	assert (index < numParameters);
+	const auto& curve = curves[index];
+	const auto* points = curvePoints.data () + curve.offset;
+	normalized = std::min (std::max (normalized, 0.), 1.);
+	if (curve.stepCount > 0)
+	{
+		auto step = static_cast<int32> (normalized * (curve.stepCount + 1));
+		return points[std::min (step, curve.stepCount)];
+	}
+	auto position = normalized * kCurveResolution;
+	auto segment = std::min (static_cast<int32> (position), kCurveResolution - 1);
+	auto fraction = position - segment;
+	return points[segment] + (points[segment + 1] - points[segment]) * fraction;
+}
+
+//------------------------------------------------------------------------
+inline bool ParameterStore::setNormalized (uint32 index, ParamValue normalized,
+                                           uint32 notify) noexcept
+{
+	if (index >= numParameters)
+		return false;
+	auto& slot = slots[index];
+	if (slot.normalized.load (std::memory_order_relaxed) == normalized)
+		return false;
+	slot.normalized.store (normalized, std::memory_order_relaxed);
+	slot.plain.store (toPlain (index, normalized), std::memory_order_relaxed);
+	markChanged (index, notify);
+	return true;
+}
+
+//------------------------------------------------------------------------
+inline uint32 ParameterStore::applyChanges (IParameterChanges* changes, uint32 notify) noexcept
+{
+	if (!changes)
+		return 0;
+	uint32 numChanged = 0;
+	auto numQueues = changes->getParameterCount ();
+	for (int32 i = 0; i < numQueues; ++i)
+	{
+		auto* queue = changes->getParameterData (i);
+		if (!queue)
+			continue;
+		auto numPoints = queue->getPointCount ();
+		if (numPoints <= 0)
+			continue;
+		int32 sampleOffset;
+		ParamValue value;
+		if (queue->getPoint (numPoints - 1, sampleOffset, value) != kResultTrue)
+			continue;
+		if (setNormalized (getIndex (queue->getParameterId ()), value, notify))
+			++numChanged;
+	}
+	return numChanged;
+}
+
+//------------------------------------------------------------------------
+inline void ParameterStore::markAllChanged (uint32 notify) noexcept
+{
+	for (auto consumer : {kProcessor, kController})
+	{
+		if ((notify & consumer) == 0)
+			continue;
+		auto* words = getDirtyWords (consumer);
+		for (uint32 i = 0; i < numDirtyWords; ++i)
+		{
+			auto numBits = std::min (kBitsPerWord, numParameters - i * kBitsPerWord);
+			auto bits = numBits == kBitsPerWord ? ~uint64 (0) : (uint64 (1) << numBits) - 1;
+			words[i].fetch_or (bits, std::memory_order_release);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+inline bool ParameterStore::hasChanges (Consumer consumer) const noexcept
+{
+	auto* words = getDirtyWords (consumer);
+	for (uint32 i = 0; i < numDirtyWords; ++i)
+	{
+		if (words[i].load (std::memory_order_relaxed) != 0)
+			return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+inline uint32 ParameterStore::consumeChanges (Consumer consumer, Proc proc)
+{
+	uint32 numChanged = 0;
+	auto* words = getDirtyWords (consumer);
+	for (uint32 i = 0; i < numDirtyWords; ++i)
+	{
+		if (words[i].load (std::memory_order_relaxed) == 0)
+			continue;
+		auto bits = words[i].exchange (0, std::memory_order_acquire);
+		while (bits)
+		{
+			proc (i * kBitsPerWord + countTrailingZeros (bits));
+			bits &= bits - 1;
+			++numChanged;
+		}
+	}
+	return numChanged;
+}
+
+//------------------------------------------------------------------------
+inline uint32 ParameterStore::countTrailingZeros (uint64 bits) noexcept
+{
+	assert (bits != 0);
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long result;
+	_BitScanForward64 (&result, bits);
+	return static_cast<uint32> (result);
+#elif defined(__GNUC__) || defined(__clang__)
+	return static_cast<uint32> (__builtin_ctzll (bits));
+#else
+	uint32 result = 0;
+	while ((bits & 1) == 0)
+	{
+		bits >>= 1;
+		++result;
+	}
+	return result;
+#endif
+}
+
+//------------------------------------------------------------------------
+inline ParameterStore::DirtyWord* ParameterStore::getDirtyWords (Consumer consumer) const noexcept
+{
+	return dirtyWords.get () + (consumer == kProcessor ? 0 : numDirtyWords);
+}
+
+//------------------------------------------------------------------------
+inline void ParameterStore::markChanged (uint32 index, uint32 notify) noexcept
+{
+	auto bit = uint64 (1) << (index % kBitsPerWord);
+	auto word = index / kBitsPerWord;
+	if (notify & kProcessor)
+		getDirtyWords (kProcessor)[word].fetch_or (bit, std::memory_order_release);
+	if (notify & kController)
+		getDirtyWords (kController)[word].fetch_or (bit, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
@@ -0,0 +1,448 @@
+//-----------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/sampleconvert.h
+// Created by  : Steinberg, 10/2026
+// Description : Interleaved/planar sample format conversion
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this
+//     software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "pluginterfaces/vst/vstspeaker.h"
+#include "pluginterfaces/vst/vsttypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SMTG_SAMPLECONVERT_SSE2 1
+#include <emmintrin.h>
+#else
+#define SMTG_SAMPLECONVERT_SSE2 0
+#endif
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace SampleConvert {
+
+//------------------------------------------------------------------------
+/** Sample formats of interleaved buffers. All formats use the native (little endian) byte order,
+ *  Int24 is packed into three bytes. */
+enum class Format : uint32
+{
+	Int16,
+	Int24,
+	Int32,
+	Float32,
+	Float64
+};
+
+//------------------------------------------------------------------------
+/** number of bytes of one sample in the format */
+constexpr uint32 bytesPerSample (Format format)
+{
+	return format == Format::Int16 ? 2 :
+	       format == Format::Int24 ? 3 :
+	       format == Format::Int32 ? 4 :
+	       format == Format::Float32 ? 4 : 8;
+}
+
+//------------------------------------------------------------------------
+/** Triangular (TPDF) dither of +/- 1 LSB for conversions to Int16 and Int24.
+ *
+ *	Uses a xorshift generator, so it does not allocate and is deterministic for a given seed.
+ */
+class TriangularDither
+{
+public:
+	explicit TriangularDither (uint32 seed = 0x12345678u) : state (seed ? seed : 1u) {}
+
+	/** returns the next dither value in LSB units, in the range (-1, 1) */
+	double next ()
+	{
+		auto a = nextRandom ();
+		auto b = nextRandom ();
+		return (static_cast<double> (a) - static_cast<double> (b)) * (1. / 4294967296.);
+	}
+
+private:
+	uint32 nextRandom ()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	uint32 state;
+};
+
+//------------------------------------------------------------------------
+/** Fills channelMap with the source channel index of each channel of the destination arrangement.
+ *
+ *	Channels of the destination which are not part of the source are set to -1 and converted to
+ *	silence.
+ *
+ *	@param source       speaker arrangement of the source buffer
+ *	@param destination  speaker arrangement of the destination buffer
+ *	@param channelMap   receives one entry for each destination channel
+ *	@param maxChannels  number of entries which fit into channelMap
+ *
+ *	@return number of destination channels or -1 if channelMap is too small
+ */
+inline int32 makeChannelMap (SpeakerArrangement source, SpeakerArrangement destination,
+                             int32* channelMap, int32 maxChannels)
+{
+	auto numChannels = SpeakerArr::getChannelCount (destination);
+	if (numChannels > maxChannels)
+		return -1;
+	for (int32 channel = 0; channel < numChannels; ++channel)
+		channelMap[channel] =
+		    SpeakerArr::getSpeakerIndex (SpeakerArr::getSpeaker (destination, channel), source);
+	return numChannels;
+}
+
+//------------------------------------------------------------------------
+namespace Detail {
+
+constexpr double kInt16Scale = 32768.;
+constexpr double kInt24Scale = 8388608.;
+constexpr double kInt32Scale = 2147483648.;
+
+//------------------------------------------------------------------------
+inline int32 readInt24 (const uint8* data)
+{
+	auto value = static_cast<int32> (static_cast<uint32> (data[0]) |
+	                                 (static_cast<uint32> (data[1]) << 8) |
+	                                 (static_cast<uint32> (data[2]) << 16));
+	return (value ^ 0x800000) - 0x800000; // sign extend
+}
+
+//------------------------------------------------------------------------
+inline void writeInt24 (uint8* data, int32 value)
+{
+	data[0] = static_cast<uint8> (value);
+	data[1] = static_cast<uint8> (value >> 8);
+	data[2] = static_cast<uint8> (value >> 16);
+}
+
+//------------------------------------------------------------------------
+/** scales, rounds to nearest and clips a sample to the integer range [-scale, scale - 1] */
+inline int32 toInt (double value, double scale)
+{
+	return static_cast<int32> (
+	    std::max (-scale, std::min (scale - 1., std::nearbyint (value * scale))));
+}
+
+//------------------------------------------------------------------------
+template <typename SampleT, typename StoredT>
+inline void readIntChannel (const uint8* source, int32 stride, SampleT* dest, int32 numSamples,
+                           double scale)
+{
+	auto factor = static_cast<SampleT> (1. / scale);
+	for (int32 i = 0; i < numSamples; ++i, source += stride)
+	{
+		StoredT value;
+		memcpy (&value, source, sizeof (StoredT));
+		dest[i] = static_cast<SampleT> (value) * factor;
+	}
+}
+
+//------------------------------------------------------------------------
+template <typename SampleT, typename StoredT>
+inline void readFloatChannel (const uint8* source, int32 stride, SampleT* dest, int32 numSamples)
+{
+	for (int32 i = 0; i < numSamples; ++i, source += stride)
+	{
+		StoredT value;
+		memcpy (&value, source, sizeof (StoredT));
+		dest[i] = static_cast<SampleT> (value);
+	}
+}
+
+//------------------------------------------------------------------------
+template <typename SampleT>
+inline void readChannel (const uint8* source, Format format, int32 stride, SampleT* dest,
+                         int32 numSamples)
+{
+	switch (format)
+	{
+		case Format::Int16:
+			readIntChannel<SampleT, int16> (source, stride, dest, numSamples, kInt16Scale);
+			break;
+		case Format::Int24:
+		{
+			auto factor = static_cast<SampleT> (1. / kInt24Scale);
+			for (int32 i = 0; i < numSamples; ++i, source += stride)
+				dest[i] = static_cast<SampleT> (readInt24 (source)) * factor;
+			break;
+		}
+		case Format::Int32:
+		{
+			// int32 does not fit into the mantissa of a float, scale in double precision
+			for (int32 i = 0; i < numSamples; ++i, source += stride)
+			{
+				int32 value;
+				memcpy (&value, source, sizeof (int32));
+				dest[i] = static_cast<SampleT> (value * (1. / kInt32Scale));
+			}
+			break;
+		}
+		case Format::Float32:
+			readFloatChannel<SampleT, float> (source, stride, dest, numSamples);
+			break;
+		case Format::Float64:
+			readFloatChannel<SampleT, double> (source, stride, dest, numSamples);
+			break;
+	}
+}
+
+//------------------------------------------------------------------------
+template <typename SampleT>
+inline void writeChannel (const SampleT* source, Format format, uint8* dest, int32 stride,
+                          int32 numSamples, TriangularDither* dither)
+{
+	switch (format)
+	{
+		case Format::Int16:
+		{
+			for (int32 i = 0; i < numSamples; ++i, dest += stride)
+			{
+				double value = source[i];
+				if (dither)
+					value += dither->next () * (1. / kInt16Scale);
+				auto sample = static_cast<int16> (toInt (value, kInt16Scale));
+				memcpy (dest, &sample, sizeof (int16));
+			}
+			break;
+		}
+		case Format::Int24:
+		{
+			for (int32 i = 0; i < numSamples; ++i, dest += stride)
+			{
+				double value = source[i];
+				if (dither)
+					value += dither->next () * (1. / kInt24Scale);
+				writeInt24 (dest, toInt (value, kInt24Scale));
+			}
+			break;
+		}
+		case Format::Int32:
+		{
+			for (int32 i = 0; i < numSamples; ++i, dest += stride)
+			{
+				auto sample = toInt (source[i], kInt32Scale);
+				memcpy (dest, &sample, sizeof (int32));
+			}
+			break;
+		}
+		case Format::Float32:
+		{
+			for (int32 i = 0; i < numSamples; ++i, dest += stride)
+			{
+				auto sample = static_cast<float> (source[i]);
+				memcpy (dest, &sample, sizeof (float));
+			}
+			break;
+		}
+		case Format::Float64:
+		{
+			for (int32 i = 0; i < numSamples; ++i, dest += stride)
+			{
+				auto sample = static_cast<double> (source[i]);
+				memcpy (dest, &sample, sizeof (double));
+			}
+			break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+inline void clearChannel (Format format, uint8* dest, int32 stride, int32 numSamples)
+{
+	auto numBytes = bytesPerSample (format);
+	for (int32 i = 0; i < numSamples; ++i, dest += stride)
+		memset (dest, 0, numBytes);
+}
+
+//------------------------------------------------------------------------
+} // Detail
+
+//------------------------------------------------------------------------
+/** Deinterleaves samples of the same type.
+ *
+ *	@param interleaved  numChannels * numSamples interleaved samples
+ *	@param numChannels  number of channels in interleaved and planar
+ *	@param planar       one buffer of numSamples samples per channel
+ *	@param numSamples   number of samples per channel
+ */
+template <typename SampleT>
+inline void deinterleave (const SampleT* interleaved, int32 numChannels, SampleT* const* planar,
+                          int32 numSamples)
+{
+	int32 i = 0;
+#if SMTG_SAMPLECONVERT_SSE2
+	if (std::is_same<SampleT, float>::value && numChannels == 2)
+	{
+		auto src = reinterpret_cast<const float*> (interleaved);
+		auto left = reinterpret_cast<float*> (planar[0]);
+		auto right = reinterpret_cast<float*> (planar[1]);
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			auto a = _mm_loadu_ps (src + 2 * i);
+			auto b = _mm_loadu_ps (src + 2 * i + 4);
+			_mm_storeu_ps (left + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)));
+			_mm_storeu_ps (right + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)));
+		}
+	}
+#endif
+	for (int32 channel = 0; channel < numChannels; ++channel)
+	{
+		auto dest = planar[channel];
+		auto src = interleaved + channel;
+		for (int32 s = i; s < numSamples; ++s)
+			dest[s] = src[s * numChannels];
+	}
+}
+
+//------------------------------------------------------------------------
+/** Interleaves samples of the same type.
+ *
+ *	@param planar       one buffer of numSamples samples per channel
+ *	@param numChannels  number of channels in interleaved and planar
+ *	@param interleaved  receives numChannels * numSamples interleaved samples
+ *	@param numSamples   number of samples per channel
+ */
+template <typename SampleT>
+inline void interleave (const SampleT* const* planar, int32 numChannels, SampleT* interleaved,
+                        int32 numSamples)
+{
+	int32 i = 0;
+#if SMTG_SAMPLECONVERT_SSE2
+	if (std::is_same<SampleT, float>::value && numChannels == 2)
+	{
+		auto left = reinterpret_cast<const float*> (planar[0]);
+		auto right = reinterpret_cast<const float*> (planar[1]);
+		auto dest = reinterpret_cast<float*> (interleaved);
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			auto l = _mm_loadu_ps (left + i);
+			auto r = _mm_loadu_ps (right + i);
+			_mm_storeu_ps (dest + 2 * i, _mm_unpacklo_ps (l, r));
+			_mm_storeu_ps (dest + 2 * i + 4, _mm_unpackhi_ps (l, r));
+		}
+	}
+#endif
+	for (int32 channel = 0; channel < numChannels; ++channel)
+	{
+		auto src = planar[channel];
+		auto dest = interleaved + channel;
+		for (int32 s = i; s < numSamples; ++s)
+			dest[s * numChannels] = src[s];
+	}
+}
+
+//------------------------------------------------------------------------
+/** Converts an interleaved buffer of any format to planar Sample32 or Sample64 buffers.
+ *
+ *	@param interleaved      source buffer
+ *	@param format           sample format of interleaved
+ *	@param numSourceChannels number of channels in interleaved
+ *	@param planar           destination buffers, one per channel
+ *	@param numChannels      number of destination channels
+ *	@param numSamples       number of samples per channel
+ *	@param channelMap       optional source channel for each destination channel (see
+ *	                        makeChannelMap), -1 produces silence. Without a map destination
+ *	                        channel n reads source channel n.
+ */
+template <typename SampleT>
+inline void toPlanar (const void* interleaved, Format format, int32 numSourceChannels,
+                      SampleT* const* planar, int32 numChannels, int32 numSamples,
+                      const int32* channelMap = nullptr)
+{
+	auto stride = static_cast<int32> (bytesPerSample (format)) * numSourceChannels;
+	auto source = static_cast<const uint8*> (interleaved);
+	for (int32 channel = 0; channel < numChannels; ++channel)
+	{
+		auto sourceChannel = channelMap ? channelMap[channel] : channel;
+		if (sourceChannel < 0 || sourceChannel >= numSourceChannels)
+		{
+			std::fill (planar[channel], planar[channel] + numSamples, SampleT (0));
+			continue;
+		}
+		Detail::readChannel (source + sourceChannel * bytesPerSample (format), format, stride,
+		                     planar[channel], numSamples);
+	}
+}
+
+//------------------------------------------------------------------------
+/** Converts planar Sample32 or Sample64 buffers to an interleaved buffer of any format.
+ *
+ *	Samples are rounded to nearest and clipped to the integer range. Int32 and the float formats
+ *	are not dithered.
+ *
+ *	@param planar           source buffers, one per channel
+ *	@param numSourceChannels number of source channels
+ *	@param interleaved      destination buffer
+ *	@param format           sample format of interleaved
+ *	@param numChannels      number of channels in interleaved
+ *	@param numSamples       number of samples per channel
+ *	@param channelMap       optional source channel for each destination channel (see
+ *	                        makeChannelMap), -1 produces silence
+ *	@param dither           optional dither for Int16 and Int24
+ */
+template <typename SampleT>
+inline void fromPlanar (const SampleT* const* planar, int32 numSourceChannels, void* interleaved,
+                        Format format, int32 numChannels, int32 numSamples,
+                        const int32* channelMap = nullptr, TriangularDither* dither = nullptr)
+{
+	auto stride = static_cast<int32> (bytesPerSample (format)) * numChannels;
+	auto dest = static_cast<uint8*> (interleaved);
+	for (int32 channel = 0; channel < numChannels; ++channel)
+	{
+		auto sourceChannel = channelMap ? channelMap[channel] : channel;
+		auto channelDest = dest + channel * bytesPerSample (format);
+		if (sourceChannel < 0 || sourceChannel >= numSourceChannels)
+			Detail::clearChannel (format, channelDest, stride, numSamples);
+		else
+			Detail::writeChannel (planar[sourceChannel], format, channelDest, stride, numSamples,
+			                      dither);
+	}
+}
+
+//------------------------------------------------------------------------
+} // SampleConvert
+} // Vst
+} // Steinberg
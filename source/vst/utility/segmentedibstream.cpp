@@ -0,0 +1,267 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/segmentedibstream.cpp
+// Created by  : Steinberg, 10/2026
+// Description : IBStream implementation using a list of fixed-size memory segments
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "segmentedibstream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if SMTG_OS_WINDOWS
+#include <io.h>
+#else
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+
+//------------------------------------------------------------------------
+SegmentedMemoryIBStream::SegmentedMemoryIBStream (size_t segmentSize)
+: segmentSize (std::max<size_t> (segmentSize, 1))
+{
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API SegmentedMemoryIBStream::read (void* buffer, int32 numBytes, int32* numBytesRead)
+{
+	if (numBytes < 0 || buffer == nullptr)
+		return kInvalidArgument;
+
+	auto dst = static_cast<uint8*> (buffer);
+	auto remaining = std::min<size_t> (static_cast<size_t> (numBytes), size - cursor);
+	auto byteCount = remaining;
+	while (remaining > 0)
+	{
+		auto offset = cursor % segmentSize;
+		auto count = std::min (remaining, segmentSize - offset);
+		memcpy (dst, segments[cursor / segmentSize].get () + offset, count);
+		dst += count;
+		cursor += count;
+		remaining -= count;
+	}
+	if (numBytesRead)
+		*numBytesRead = static_cast<int32> (byteCount);
+	return kResultTrue;
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API SegmentedMemoryIBStream::write (void* buffer, int32 numBytes,
+                                                   int32* numBytesWritten)
+{
+	if (numBytes < 0 || buffer == nullptr)
+		return kInvalidArgument;
+
+	auto requiredSegments = (cursor + numBytes + segmentSize - 1) / segmentSize;
+	while (segments.size () < requiredSegments)
+	{
+		Segment segment (new (std::nothrow) uint8[segmentSize]);
+		if (!segment)
+			return kOutOfMemory;
+		segments.emplace_back (std::move (segment));
+	}
+
+	auto src = static_cast<const uint8*> (buffer);
+	auto remaining = static_cast<size_t> (numBytes);
+	while (remaining > 0)
+	{
+		auto offset = cursor % segmentSize;
+		auto count = std::min (remaining, segmentSize - offset);
+		memcpy (segments[cursor / segmentSize].get () + offset, src, count);
+		src += count;
+		cursor += count;
+		remaining -= count;
+	}
+	size = std::max (size, cursor);
+	if (numBytesWritten)
+		*numBytesWritten = numBytes;
+	return kResultTrue;
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API SegmentedMemoryIBStream::seek (int64 pos, int32 mode, int64* result)
+{
+	int64 newCursor = static_cast<int64> (cursor);
+	switch (mode)
+	{
+		case kIBSeekSet: newCursor = pos; break;
+		case kIBSeekCur: newCursor += pos; break;
+		case kIBSeekEnd: newCursor = static_cast<int64> (size) + pos; break;
+		default: return kInvalidArgument;
+	}
+	if (newCursor < 0 || newCursor > static_cast<int64> (size))
+		return kInvalidArgument;
+	if (result)
+		*result = newCursor;
+	cursor = static_cast<size_t> (newCursor);
+	return kResultTrue;
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API SegmentedMemoryIBStream::tell (int64* pos)
+{
+	if (pos == nullptr)
+		return kInvalidArgument;
+	*pos = static_cast<int64> (cursor);
+	return kResultTrue;
+}
+
+//------------------------------------------------------------------------
+size_t SegmentedMemoryIBStream::getSegmentCount () const
+{
+	return (size + segmentSize - 1) / segmentSize;
+}
+
+//------------------------------------------------------------------------
+const uint8* SegmentedMemoryIBStream::getSegment (size_t index, size_t& usedBytes) const
+{
+	if (index >= getSegmentCount ())
+	{
+		usedBytes = 0;
+		return nullptr;
+	}
+	usedBytes = std::min (segmentSize, size - index * segmentSize);
+	return segments[index].get ();
+}
+
+//------------------------------------------------------------------------
+void SegmentedMemoryIBStream::clear ()
+{
+	size = 0;
+	cursor = 0;
+}
+
+//------------------------------------------------------------------------
+void SegmentedMemoryIBStream::shrink ()
+{
+	segments.resize (getSegmentCount ());
+}
+
+//------------------------------------------------------------------------
+bool SegmentedMemoryIBStream::copyTo (IBStream* stream) const
+{
+	if (stream == nullptr)
+		return false;
+	for (size_t i = 0, count = getSegmentCount (); i < count; ++i)
+	{
+		size_t usedBytes = 0;
+		auto data = const_cast<uint8*> (getSegment (i, usedBytes));
+		int32 numBytesWritten = 0;
+		if (stream->write (data, static_cast<int32> (usedBytes), &numBytesWritten) != kResultTrue ||
+		    numBytesWritten != static_cast<int32> (usedBytes))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool SegmentedMemoryIBStream::writeToFile (int fileDescriptor) const
+{
+#if SMTG_OS_WINDOWS
+	for (size_t i = 0, count = getSegmentCount (); i < count; ++i)
+	{
+		size_t usedBytes = 0;
+		auto data = getSegment (i, usedBytes);
+		while (usedBytes > 0)
+		{
+			auto written = _write (fileDescriptor, data, static_cast<unsigned int> (usedBytes));
+			if (written <= 0)
+				return false;
+			data += written;
+			usedBytes -= static_cast<size_t> (written);
+		}
+	}
+	return true;
+#else
+#ifdef IOV_MAX
+	constexpr size_t kMaxIOVecs = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+	constexpr size_t kMaxIOVecs = 16;
+#endif
+	iovec vecs[kMaxIOVecs];
+	size_t segmentIndex = 0;
+	size_t segmentOffset = 0;
+	const auto segmentCount = getSegmentCount ();
+	while (segmentIndex < segmentCount)
+	{
+		// collect the next batch of segments
+		int numVecs = 0;
+		for (auto i = segmentIndex; i < segmentCount && numVecs < static_cast<int> (kMaxIOVecs);
+		     ++i, ++numVecs)
+		{
+			size_t usedBytes = 0;
+			auto data = getSegment (i, usedBytes);
+			auto offset = i == segmentIndex ? segmentOffset : 0;
+			vecs[numVecs].iov_base = const_cast<uint8*> (data + offset);
+			vecs[numVecs].iov_len = usedBytes - offset;
+		}
+
+		auto written = ::writev (fileDescriptor, vecs, numVecs);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		if (written == 0)
+			return false;
+
+		// advance over the written bytes, a partial write continues inside of a segment
+		auto remaining = static_cast<size_t> (written);
+		while (remaining > 0 && segmentIndex < segmentCount)
+		{
+			size_t usedBytes = 0;
+			getSegment (segmentIndex, usedBytes);
+			auto available = usedBytes - segmentOffset;
+			if (remaining < available)
+			{
+				segmentOffset += remaining;
+				break;
+			}
+			remaining -= available;
+			segmentOffset = 0;
+			++segmentIndex;
+		}
+	}
+	return true;
+#endif
+}
+
+//------------------------------------------------------------------------
+} // Steinberg
@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/segmentedibstream.h
+// Created by  : Steinberg, 10/2026
+// Description : IBStream implementation using a list of fixed-size memory segments
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "pluginterfaces/base/funknownimpl.h"
+#include "pluginterfaces/base/ibstream.h"
+
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+
+//------------------------------------------------------------------------
+/** IBStream implementation which stores its content in fixed-size memory segments.
+ *
+ *	In contrast to MemoryStream and ResizableMemoryIBStream the content does not need one
+ *	contiguous memory block, growing the stream never copies the already written data. Use it
+ *	for very big plug-in states (for example samplers embedding audio data) to avoid address
+ *	space fragmentation and big copies.
+ *
+ *	The stream can be written directly to a file descriptor (using writev on POSIX systems):
+ *	\code{.cpp}
+ *	auto stream = owned (new SegmentedMemoryIBStream);
+ *	PresetFile::savePreset (stream, classID, component, controller);
+ *	stream->writeToFile (fd);
+ *	\endcode
+ */
+class SegmentedMemoryIBStream : public U::Implements<U::Directly<IBStream>>
+{
+public:
+	static constexpr size_t kDefaultSegmentSize = 64 * 1024;
+
+	explicit SegmentedMemoryIBStream (size_t segmentSize = kDefaultSegmentSize);
+
+	//---IBStream---------------------------------------
+	tresult PLUGIN_API read (void* buffer, int32 numBytes, int32* numBytesRead) override;
+	tresult PLUGIN_API write (void* buffer, int32 numBytes, int32* numBytesWritten) override;
+	tresult PLUGIN_API seek (int64 pos, int32 mode, int64* result) override;
+	tresult PLUGIN_API tell (int64* pos) override;
+
+	size_t getSize () const { return size; }
+	size_t getCursor () const { return cursor; }
+	size_t getSegmentSize () const { return segmentSize; }
+	/** number of segments holding data */
+	size_t getSegmentCount () const;
+	/** returns the memory of a segment and the number of bytes used in it */
+	const uint8* getSegment (size_t index, size_t& usedBytes) const;
+
+	void rewind () { cursor = 0; }
+	/** discard the content but keep the segments for reuse */
+	void clear ();
+	/** free all segments which are not used by the content */
+	void shrink ();
+
+	/** write the whole content (independent of the cursor) into another stream */
+	bool copyTo (IBStream* stream) const;
+	/** write the whole content (independent of the cursor) to a file descriptor */
+	bool writeToFile (int fileDescriptor) const;
+
+//------------------------------------------------------------------------
+private:
+	using Segment = std::unique_ptr<uint8[]>;
+
+	std::vector<Segment> segments;
+	size_t segmentSize;
+	size_t size {0};
+	size_t cursor {0};
+};
+
+//------------------------------------------------------------------------
+} // Steinberg
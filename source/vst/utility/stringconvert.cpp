@@ -34,61 +34,15 @@
 // OF THE POSSIBILITY OF SUCH DAMAGE.
 //-----------------------------------------------------------------------------
 
-#include "pluginterfaces/base/fplatform.h"
-
-#if SMTG_OS_WINDOWS
-#ifndef _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING
-#define _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING
-#endif
-#endif // SMTG_OS_WINDOWS
-
 #include "public.sdk/source/vst/utility/stringconvert.h"
 #include "public.sdk/source/common/commonstringconvert.h"
 
-#include <codecvt>
-#include <istream>
-#include <locale>
+#include <limits>
 
 namespace Steinberg {
 namespace Vst {
 namespace StringConvert {
 
-//------------------------------------------------------------------------
-namespace {
-
-#if defined(_MSC_VER) && _MSC_VER >= 1900
-#define USE_WCHAR_AS_UTF16TYPE
-using UTF16Type = wchar_t;
-#else
-using UTF16Type = char16_t;
-#endif
-
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-#elif defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-
-using Converter = std::wstring_convert<std::codecvt_utf8_utf16<UTF16Type>, UTF16Type>;
-
-//------------------------------------------------------------------------
-Converter& converter ()
-{
-	static Converter conv;
-	return conv;
-}
-
-#ifdef __clang__
-#pragma clang diagnostic pop
-#elif defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-
-//------------------------------------------------------------------------
-} // anonymous
-
 //------------------------------------------------------------------------
 std::u16string convert (const std::string& utf8Str)
 {
@@ -104,20 +58,20 @@ bool convert (const std::string& utf8Str, Steinberg::Vst::String128 str)
 //------------------------------------------------------------------------
 bool convert (const std::string& utf8Str, Steinberg::Vst::TChar* str, uint32_t maxCharacters)
 {
-	auto ucs2 = convert (utf8Str);
-	if (ucs2.length () < maxCharacters)
-	{
-		ucs2.copy (reinterpret_cast<char16_t*> (str), ucs2.length ());
-		str[ucs2.length ()] = 0;
-		return true;
-	}
-	return false;
+	if (maxCharacters == 0)
+		return false;
+	size_t numUnits = 0;
+	auto result = Steinberg::StringConvert::utf8ToUtf16 (
+	    utf8Str.data (), utf8Str.size (), reinterpret_cast<char16_t*> (str), maxCharacters - 1,
+	    numUnits);
+	str[numUnits] = 0;
+	return result;
 }
 
 //------------------------------------------------------------------------
 std::string convert (const Steinberg::Vst::TChar* str)
 {
-	return converter ().to_bytes (reinterpret_cast<const UTF16Type*> (str));
+	return convert (str, std::numeric_limits<uint32_t>::max ());
 }
 
 //------------------------------------------------------------------------
@@ -126,14 +80,14 @@ std::string convert (const Steinberg::Vst::TChar* str, uint32_t max)
 	std::string result;
 	if (str)
 	{
-		Steinberg::Vst::TChar tmp[2] {};
-		for (uint32_t i = 0; i < max; ++i, ++str)
-		{
-			tmp[0] = *str;
-			if (tmp[0] == 0)
-				break;
-			result += convert (tmp);
-		}
+		uint32_t length = 0;
+		while (length < max && str[length] != 0)
+			++length;
+		result.resize (length * 3);
+		size_t numBytes = 0;
+		Steinberg::StringConvert::utf16ToUtf8 (reinterpret_cast<const char16_t*> (str), length,
+		                                       &result[0], result.size (), numBytes);
+		result.resize (numBytes);
 	}
 	return result;
 }
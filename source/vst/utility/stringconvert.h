@@ -76,9 +76,12 @@ bool convert (const std::string& utf8Str, Steinberg::Vst::String128 str);
 /**
  *  convert an UTF-8 string to an UTF-16 string buffer
  *
+ *  does not allocate memory. If the string does not fit, str contains the characters which fit and
+ *  is zero terminated.
+ *
  *  @param utf8Str       UTF-8 string
  *  @param str           UTF-16 string buffer
- *  @param maxCharacters max characters that fit into str
+ *  @param maxCharacters max characters that fit into str (including the terminating zero)
  *
  *  @return true on success
  */
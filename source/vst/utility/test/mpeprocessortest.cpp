@@ -0,0 +1,180 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/test/mpeprocessortest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test MPE processor
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/mpeprocessor.h"
+#include "public.sdk/source/vst/utility/testing.h"
+
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+struct RecordingHandler : MPE::Handler
+{
+	std::vector<std::string> log;
+	MPE::NoteID nextNoteID {0};
+
+	void add (const char* what, int32_t a, int32_t b = 0)
+	{
+		log.push_back (std::string (what) + " " + std::to_string (a) + " " + std::to_string (b));
+	}
+
+	bool generateNewNoteID (MPE::NoteID& outNoteID) override
+	{
+		outNoteID = nextNoteID++;
+		return true;
+	}
+	void releaseNoteID (MPE::NoteID noteID) override {}
+	void onMPENoteOn (MPE::NoteID noteID, MPE::Pitch pitch, MPE::Velocity velocity) override
+	{
+		add ("on", noteID, pitch);
+	}
+	void onMPENoteOff (MPE::NoteID noteID, MPE::Pitch pitch, MPE::Velocity velocity) override
+	{
+		add ("off", noteID, pitch);
+	}
+	void onMPEControllerChange (MPE::NoteID noteID, MPE::Controller cc,
+	                            MPE::NormalizedValue value) override
+	{
+		add ("cc", noteID, static_cast<int32_t> (value * 16383. + 0.5));
+	}
+	void onOtherInput (const uint8_t* data, size_t dataSize) override
+	{
+		add ("other", data[0], static_cast<int32_t> (dataSize));
+	}
+	void onSysexInput (const uint8_t* data, size_t dataSize) override
+	{
+		add ("sysex", data[0], static_cast<int32_t> (dataSize));
+	}
+	void errorNoteDroppedBecauseNoNoteID (MPE::Pitch pitch) override {}
+	void errorNoteDroppedBecauseNoteStackFull (MPE::Channel channel, MPE::Pitch pitch) override
+	{
+		add ("full", channel, pitch);
+	}
+	void errorNoteForNoteOffNotFound (MPE::Channel channel, MPE::Pitch pitch) override
+	{
+		add ("notfound", channel, pitch);
+	}
+	void errorProgramChangeReceivedInMPEZone () override {}
+};
+
+//------------------------------------------------------------------------
+ModuleInitializer MPEProcessorTests ([] () {
+	constexpr auto TestSuiteName = "MPEProcessor";
+	registerTest (TestSuiteName, STR ("Notes and controllers"), [] (ITestResult* testResult) {
+		RecordingHandler handler;
+		MPE::Processor processor (&handler, 2);
+		const uint8_t data[] = {0x91, 60, 100, 0x91, 64, 100, 0x91, 67, 100, 0xe1, 0x7f,
+		                        0x7f, 0x81, 60,  0,   0x81, 61, 0};
+		processor.processMIDIInput (data, sizeof (data));
+		const std::vector<std::string> expected {
+		    "on 0 60",   "cc 0 0",      "cc 0 8192",  "cc 0 0",      "on 1 64",
+		    "cc 1 0",    "cc 1 8192",   "cc 1 0",     "full 1 67",   "cc 0 16383",
+		    "cc 1 16383", "off 0 60",   "notfound 1 61"};
+		EXPECT (handler.log == expected);
+		handler.log.clear ();
+		processor.reset ();
+		EXPECT (handler.log == std::vector<std::string> ({"off 1 64"}));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Block with running status and split messages"),
+	              [] (ITestResult* testResult) {
+		              // note on, running status note on, timing clock inside of a controller
+		              // change, sysex and a pitch bend split across two blocks
+		              const uint8_t data[] = {0x92, 60,   100,  62,   90,  0xb2, 74,
+		                                      0xf8, 127,  0xf0, 0x01, 0xf7, 0xe2, 0x00};
+		              const uint8_t data2[] = {0x40, 0x00, 0x40};
+		              RecordingHandler handler;
+		              MPE::Processor processor (&handler);
+		              processor.processMIDIInputBlock (data, sizeof (data));
+		              processor.processMIDIInputBlock (data2, sizeof (data2));
+
+		              RecordingHandler reference;
+		              MPE::Processor referenceProcessor (&reference);
+		              const uint8_t messages[][3] = {{0x92, 60, 100}, {0x92, 62, 90},
+		                                             {0xf8, 0, 0},    {0xb2, 74, 127},
+		                                             {0xf0, 1, 0xf7}, {0xe2, 0x00, 0x40},
+		                                             {0xe2, 0x00, 0x40}};
+		              for (auto& message : messages)
+		              {
+			              size_t size = message[0] == 0xf8 ? 1 : 3;
+			              referenceProcessor.processMIDIInput (message, size);
+		              }
+		              EXPECT_EQ (handler.log.size (), reference.log.size ());
+		              EXPECT (handler.log == reference.log);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Notes outside of the zone"), [] (ITestResult* testResult) {
+		RecordingHandler handler;
+		MPE::Processor processor (&handler);
+		const uint8_t data[] = {0x90, 60, 100, 0xb0, 74, 10, 0xf2, 1, 2};
+		processor.processMIDIInputBlock (data, sizeof (data));
+		const std::vector<std::string> expected {"other 144 3", "other 176 3", "other 242 3"};
+		EXPECT (handler.log == expected);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("System exclusive cancels the running status"),
+	              [] (ITestResult* testResult) {
+		              RecordingHandler handler;
+		              MPE::Processor processor (&handler);
+		              const uint8_t data[] = {0x90, 60, 100, 0xf0, 0x01, 0xf7, 62, 90};
+		              processor.processMIDIInputBlock (data, sizeof (data));
+		              const std::vector<std::string> expected {"other 144 3", "sysex 240 3"};
+		              EXPECT (handler.log == expected);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Incomplete message"), [] (ITestResult* testResult) {
+		RecordingHandler handler;
+		MPE::Processor processor (&handler);
+		const uint8_t data[] = {0x90, 60};
+		processor.processMIDIInput (data, sizeof (data));
+		EXPECT (handler.log.empty ());
+		const uint8_t complete[] = {0x90, 60, 100};
+		processor.processMIDIInput (complete, sizeof (complete));
+		EXPECT (handler.log == std::vector<std::string> ({"other 144 3"}));
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,194 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/test/parameterstoretest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Tests for the lock-free parameter value store
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include "public.sdk/source/vst/utility/parameterstore.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/fstrdefs.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<ParameterStore::Definition> makeDefinitions (uint32 numParameters)
+{
+	std::vector<ParameterStore::Definition> definitions;
+	for (uint32 i = 0; i < numParameters; ++i)
+		definitions.push_back ({100 + i, 0., 0, nullptr});
+	return definitions;
+}
+
+//------------------------------------------------------------------------
+std::vector<uint32> consumeAll (ParameterStore& store, ParameterStore::Consumer consumer)
+{
+	std::vector<uint32> indices;
+	store.consumeChanges (consumer, [&] (uint32 index) { indices.push_back (index); });
+	return indices;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer ParameterStoreTests ([] () {
+	constexpr auto TestSuiteName = "ParameterStore";
+	registerTest (TestSuiteName, STR ("Sampled toPlain curves"), [] (ITestResult* testResult) {
+		ParameterStore store;
+		store.setup ({
+		    {1, 0.5, 0, [] (ParamValue v) { return 20. + v * 19980.; }},
+		    {2, 0., 0, [] (ParamValue v) { return 20. * std::pow (1000., v); }},
+		    {3, 0., 3, [] (ParamValue v) { return std::floor (v * 3. + 0.5) * 10.; }},
+		});
+
+		EXPECT_EQ (store.getParameterCount (), 3u);
+		EXPECT_EQ (store.getIndex (2), 1u);
+		EXPECT_EQ (store.getIndex (4), ParameterStore::kInvalidIndex);
+		EXPECT_EQ (store.getParamID (2), 3u);
+
+		EXPECT_FALSE (Test::notEqual (store.getPlain (0), 10010.));
+		EXPECT_FALSE (Test::notEqual (store.toPlain (0, 0.25), 5015.));
+		EXPECT_FALSE (Test::notEqual (store.toPlain (0, 1.), 20000.));
+		EXPECT_FALSE (Test::notEqual (store.toPlain (0, 2.), 20000.));
+
+		// exponential curve is interpolated between the sampled points
+		for (auto v : {0., 0.1, 0.33, 0.5, 0.9, 1.})
+		{
+			auto exact = 20. * std::pow (1000., v);
+			EXPECT_TRUE (std::abs (store.toPlain (1, v) - exact) < exact * 1e-3);
+		}
+
+		// discrete parameters use the same step mapping as FromNormalized
+		EXPECT_EQ (store.toPlain (2, 0.), 0.);
+		EXPECT_EQ (store.toPlain (2, 0.24), 0.);
+		EXPECT_EQ (store.toPlain (2, 0.26), 10.);
+		EXPECT_EQ (store.toPlain (2, 0.74), 20.);
+		EXPECT_EQ (store.toPlain (2, 1.), 30.);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Dirty marks per consumer"), [] (ITestResult* testResult) {
+		ParameterStore store;
+		store.setup (makeDefinitions (130));
+
+		// initial values are delivered to the processor only
+		EXPECT_EQ (consumeAll (store, ParameterStore::kProcessor).size (), 130u);
+		EXPECT_FALSE (store.hasChanges (ParameterStore::kProcessor));
+		EXPECT_FALSE (store.hasChanges (ParameterStore::kController));
+
+		EXPECT_TRUE (store.setNormalized (129, 0.5, ParameterStore::kProcessor));
+		EXPECT_TRUE (store.setNormalized (3, 0.5, ParameterStore::kProcessor));
+		EXPECT_TRUE (store.setNormalized (64, 0.5, ParameterStore::kController));
+		EXPECT_FALSE (store.setNormalized (3, 0.5, ParameterStore::kProcessor));
+		EXPECT_FALSE (store.setNormalized (130, 0.5, ParameterStore::kProcessor));
+
+		EXPECT_EQ (consumeAll (store, ParameterStore::kProcessor), (std::vector<uint32> {3, 129}));
+		EXPECT_EQ (consumeAll (store, ParameterStore::kController), (std::vector<uint32> {64}));
+		EXPECT_TRUE (consumeAll (store, ParameterStore::kProcessor).empty ());
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Apply parameter changes"), [] (ITestResult* testResult) {
+		ParameterStore store;
+		store.setup (makeDefinitions (4));
+		consumeAll (store, ParameterStore::kProcessor);
+
+		ParameterChanges changes (3);
+		int32 index;
+		auto* queue = changes.addParameterData (101, index);
+		queue->addPoint (0, 0.2, index);
+		queue->addPoint (10, 0.7, index);
+		queue = changes.addParameterData (103, index);
+		queue->addPoint (5, 1., index);
+		queue = changes.addParameterData (999, index);
+		queue->addPoint (5, 1., index);
+
+		EXPECT_EQ (store.applyChanges (&changes), 2u);
+		EXPECT_EQ (store.getNormalized (1), 0.7);
+		EXPECT_EQ (store.getPlain (3), 1.);
+		EXPECT_EQ (consumeAll (store, ParameterStore::kProcessor), (std::vector<uint32> {1, 3}));
+		EXPECT_EQ (consumeAll (store, ParameterStore::kController), (std::vector<uint32> {1, 3}));
+
+		// the same values again are no changes
+		EXPECT_EQ (store.applyChanges (&changes), 0u);
+		EXPECT_EQ (store.applyChanges (nullptr), 0u);
+		EXPECT_FALSE (store.hasChanges (ParameterStore::kProcessor));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Concurrent access"), [] (ITestResult* testResult) {
+		constexpr uint32 numParameters = 8;
+		constexpr int32 numWrites = 20000;
+		ParameterStore store;
+		store.setup (makeDefinitions (numParameters));
+
+		std::atomic<bool> done {false};
+		std::thread writer ([&] () {
+			for (int32 i = 1; i <= numWrites; ++i)
+				store.setNormalized (i % numParameters, static_cast<ParamValue> (i) / numWrites,
+				                     ParameterStore::kProcessor);
+			done = true;
+		});
+
+		std::vector<ParamValue> seen (numParameters, 0.);
+		bool ordered = true;
+		auto scan = [&] () {
+			store.consumeChanges (ParameterStore::kProcessor, [&] (uint32 index) {
+				auto value = store.getNormalized (index);
+				ordered &= value >= seen[index];
+				seen[index] = value;
+			});
+		};
+		while (!done)
+			scan ();
+		writer.join ();
+		scan ();
+
+		EXPECT_TRUE (ordered);
+		for (uint32 i = 0; i < numParameters; ++i)
+		{
+			EXPECT_EQ (seen[i], store.getNormalized (i));
+			EXPECT_EQ (store.getPlain (i), store.getNormalized (i));
+		}
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/test/sampleconverttest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Tests for the interleaved/planar sample format conversion
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/sampleconvert.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/fstrdefs.h"
+
+#include <cstdlib>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+using namespace SampleConvert;
+
+//------------------------------------------------------------------------
+ModuleInitializer SampleConvertTests ([] () {
+	constexpr auto TestSuiteName = "SampleConvert";
+	registerTest (TestSuiteName, STR ("Interleave and deinterleave"), [] (ITestResult* testResult) {
+		// odd lengths exercise the tail after the vectorized stereo loop
+		constexpr int32 numSamples = 11;
+		for (int32 numChannels = 1; numChannels <= 3; ++numChannels)
+		{
+			std::vector<float> interleaved (numChannels * numSamples);
+			for (size_t i = 0; i < interleaved.size (); ++i)
+				interleaved[i] = static_cast<float> (i);
+			std::vector<std::vector<float>> channels (numChannels, std::vector<float> (numSamples));
+			std::vector<float*> planar;
+			for (auto& channel : channels)
+				planar.push_back (channel.data ());
+
+			deinterleave (interleaved.data (), numChannels, planar.data (), numSamples);
+			for (int32 c = 0; c < numChannels; ++c)
+				for (int32 s = 0; s < numSamples; ++s)
+					EXPECT_EQ (channels[c][s], static_cast<float> (s * numChannels + c));
+
+			std::vector<float> result (interleaved.size ());
+			interleave (planar.data (), numChannels, result.data (), numSamples);
+			EXPECT_EQ (result, interleaved);
+		}
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Integer formats"), [] (ITestResult* testResult) {
+		const Sample32 input[] = {0.f, 0.5f, -0.5f, 1.f, -1.f, 2.f, -2.f};
+		const Sample32* planar[] = {input};
+
+		int16 int16Data[7];
+		fromPlanar (planar, 1, int16Data, Format::Int16, 1, 7);
+		const int16 expected16[] = {0, 16384, -16384, 32767, -32768, 32767, -32768};
+		for (int32 i = 0; i < 7; ++i)
+			EXPECT_EQ (int16Data[i], expected16[i]);
+
+		uint8 int24Data[7 * 3];
+		fromPlanar (planar, 1, int24Data, Format::Int24, 1, 7);
+		EXPECT_EQ (int24Data[3], 0x00);
+		EXPECT_EQ (int24Data[5], 0x40);
+		EXPECT_EQ (int24Data[9], 0xFF);
+		EXPECT_EQ (int24Data[11], 0x7F);
+		EXPECT_EQ (int24Data[14], 0x80);
+
+		int32 int32Data[7];
+		fromPlanar (planar, 1, int32Data, Format::Int32, 1, 7);
+		EXPECT_EQ (int32Data[1], 1 << 30);
+		EXPECT_EQ (int32Data[3], 0x7FFFFFFF);
+		EXPECT_EQ (int32Data[4], static_cast<int32> (0x80000000u));
+
+		// every integer sample survives a round trip through Sample32
+		std::vector<int16> all16 (65536);
+		for (int32 i = 0; i < 65536; ++i)
+			all16[i] = static_cast<int16> (i - 32768);
+		std::vector<Sample32> samples (65536);
+		Sample32* dest[] = {samples.data ()};
+		toPlanar (all16.data (), Format::Int16, 1, dest, 1, 65536);
+		EXPECT_EQ (samples[0], -1.f);
+		std::vector<int16> roundTrip (65536);
+		const Sample32* source[] = {samples.data ()};
+		fromPlanar (source, 1, roundTrip.data (), Format::Int16, 1, 65536);
+		EXPECT_EQ (roundTrip, all16);
+
+		Sample64 values[7];
+		Sample64* dest64[] = {values};
+		toPlanar (int24Data, Format::Int24, 1, dest64, 1, 7);
+		for (int32 i = 0; i < 5; ++i)
+			EXPECT_EQ (values[i], (i == 3 ? 8388607. / 8388608. : static_cast<double> (input[i])));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Channel map"), [] (ITestResult* testResult) {
+		int32 channelMap[8];
+		EXPECT_EQ (makeChannelMap (SpeakerArr::kStereo, SpeakerArr::k30Cine, channelMap, 8), 3);
+		EXPECT_EQ (channelMap[0], 0);
+		EXPECT_EQ (channelMap[1], 1);
+		EXPECT_EQ (channelMap[2], -1);
+		EXPECT_EQ (makeChannelMap (SpeakerArr::kStereo, SpeakerArr::k30Cine, channelMap, 2), -1);
+
+		// interleaved stereo float into a L R C bus, center is silent
+		const float interleaved[] = {0.25f, -0.25f, 0.5f, -0.5f};
+		double left[2], right[2], center[2] = {1., 1.};
+		double* planar[] = {left, right, center};
+		makeChannelMap (SpeakerArr::kStereo, SpeakerArr::k30Cine, channelMap, 8);
+		toPlanar (interleaved, Format::Float32, 2, planar, 3, 2, channelMap);
+		EXPECT_EQ (left[1], 0.5);
+		EXPECT_EQ (right[0], -0.25);
+		EXPECT_EQ (center[0], 0.);
+		EXPECT_EQ (center[1], 0.);
+
+		// and back, swapping left and right
+		const int32 swap[] = {1, 0};
+		double output[4];
+		const double* source[] = {left, right, center};
+		fromPlanar (source, 3, output, Format::Float64, 2, 2, swap);
+		EXPECT_EQ (output[0], -0.25);
+		EXPECT_EQ (output[1], 0.25);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Dither"), [] (ITestResult* testResult) {
+		constexpr int32 numSamples = 1000;
+		std::vector<Sample32> input (numSamples, 0.1f);
+		const Sample32* planar[] = {input.data ()};
+		std::vector<int16> plain (numSamples);
+		std::vector<int16> dithered (numSamples);
+		fromPlanar (planar, 1, plain.data (), Format::Int16, 1, numSamples);
+		TriangularDither dither;
+		fromPlanar (planar, 1, dithered.data (), Format::Int16, 1, numSamples, nullptr, &dither);
+
+		bool differs = false;
+		for (int32 i = 0; i < numSamples; ++i)
+		{
+			EXPECT (std::abs (dithered[i] - plain[i]) <= 1);
+			differs |= dithered[i] != plain[i];
+		}
+		EXPECT_TRUE (differs);
+
+		// the same seed produces the same output
+		std::vector<int16> again (numSamples);
+		TriangularDither dither2;
+		fromPlanar (planar, 1, again.data (), Format::Int16, 1, numSamples, nullptr, &dither2);
+		EXPECT_EQ (again, dithered);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
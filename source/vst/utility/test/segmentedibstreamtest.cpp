@@ -0,0 +1,145 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/test/segmentedibstreamtest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test segmented memory stream
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/segmentedibstream.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/vstpresetfile.h"
+#include "pluginterfaces/base/fstrdefs.h"
+
+#include <cstdio>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<uint8> makeTestData (size_t size)
+{
+	std::vector<uint8> data (size);
+	for (size_t i = 0; i < size; ++i)
+		data[i] = static_cast<uint8> (i * 7);
+	return data;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer SegmentedMemoryIBStreamTests ([] () {
+	constexpr auto TestSuiteName = "SegmentedMemoryIBStream";
+	registerTest (TestSuiteName, STR ("Write and read across segments"), [] (ITestResult* testResult) {
+		SegmentedMemoryIBStream stream (16);
+		auto data = makeTestData (100);
+		int32 numBytes = 0;
+		EXPECT_EQ (stream.write (data.data (), 100, &numBytes), kResultTrue);
+		EXPECT_EQ (numBytes, 100);
+		EXPECT_EQ (stream.getSize (), 100u);
+		EXPECT_EQ (stream.getSegmentCount (), 7u);
+
+		int64 pos = 0;
+		EXPECT_EQ (stream.seek (10, IBStream::kIBSeekSet, &pos), kResultTrue);
+		std::vector<uint8> readData (100);
+		EXPECT_EQ (stream.read (readData.data (), 100, &numBytes), kResultTrue);
+		EXPECT_EQ (numBytes, 90);
+		EXPECT_EQ (memcmp (readData.data (), data.data () + 10, 90), 0);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Overwrite and seek"), [] (ITestResult* testResult) {
+		SegmentedMemoryIBStream stream (8);
+		auto data = makeTestData (40);
+		stream.write (data.data (), 40, nullptr);
+		EXPECT_NE (stream.seek (41, IBStream::kIBSeekSet, nullptr), kResultTrue);
+		EXPECT_EQ (stream.seek (-20, IBStream::kIBSeekEnd, nullptr), kResultTrue);
+		uint8 patch[10] = {};
+		stream.write (patch, 10, nullptr);
+		EXPECT_EQ (stream.getSize (), 40u);
+		stream.rewind ();
+		std::vector<uint8> readData (40);
+		stream.read (readData.data (), 40, nullptr);
+		EXPECT_EQ (memcmp (readData.data (), data.data (), 20), 0);
+		EXPECT_EQ (memcmp (readData.data () + 20, patch, 10), 0);
+		EXPECT_EQ (memcmp (readData.data () + 30, data.data () + 30, 10), 0);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Clear keeps segments"), [] (ITestResult* testResult) {
+		SegmentedMemoryIBStream stream (8);
+		auto data = makeTestData (40);
+		stream.write (data.data (), 40, nullptr);
+		size_t usedBytes = 0;
+		auto firstSegment = stream.getSegment (0, usedBytes);
+		stream.clear ();
+		EXPECT_EQ (stream.getSize (), 0u);
+		stream.write (data.data (), 4, nullptr);
+		EXPECT_EQ (stream.getSegment (0, usedBytes), firstSegment);
+		EXPECT_EQ (usedBytes, 4u);
+		EXPECT_EQ (stream.getSegment (1, usedBytes), nullptr);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Save preset and write to file"), [] (ITestResult* testResult) {
+		auto componentState = makeTestData (300000);
+		SegmentedMemoryIBStream componentStream;
+		componentStream.write (componentState.data (), static_cast<int32> (componentState.size ()),
+		                       nullptr);
+		componentStream.rewind ();
+
+		const FUID classID (0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321);
+		SegmentedMemoryIBStream presetStream (4096);
+		EXPECT_TRUE (PresetFile::savePreset (&presetStream, classID, &componentStream));
+
+		auto file = tmpfile ();
+		EXPECT_NE (file, nullptr);
+		fflush (file);
+		bool written = presetStream.writeToFile (fileno (file));
+		fseek (file, 0, SEEK_END);
+		auto fileSize = ftell (file);
+		fclose (file);
+		EXPECT_TRUE (written);
+		EXPECT_EQ (static_cast<size_t> (fileSize), presetStream.getSize ());
+
+		PresetFile presetFile (&presetStream);
+		EXPECT_TRUE (presetFile.readChunkList ());
+		EXPECT_EQ (presetFile.getClassID (), classID);
+		auto entry = presetFile.getEntry (kComponentState);
+		EXPECT_NE (entry, nullptr);
+		EXPECT_EQ (entry->size, static_cast<TSize> (componentState.size ()));
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/test/stringconverttest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Tests for the UTF-8/UTF-16 string conversion
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/common/commonstringconvert.h"
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/stringconvert.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "pluginterfaces/base/fstrdefs.h"
+
+#include <string>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+ModuleInitializer StringConvertTests ([] () {
+	constexpr auto TestSuiteName = "StringConvert";
+	registerTest (TestSuiteName, STR ("ASCII round trip"), [] (ITestResult* testResult) {
+		const std::string text = "The quick brown fox jumps over the lazy dog 0123456789";
+		auto utf16 = StringConvert::convert (text);
+		EXPECT_EQ (utf16.size (), text.size ());
+		for (size_t i = 0; i < text.size (); ++i)
+			EXPECT_EQ (static_cast<char> (utf16[i]), text[i]);
+		EXPECT_EQ (StringConvert::convert (utf16), text);
+		EXPECT_EQ (StringConvert::convert (std::string ()).empty (), true);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Multi byte characters"), [] (ITestResult* testResult) {
+		// a, e-acute, euro sign, G clef (outside the BMP)
+		const std::string text = "a\xC3\xA9\xE2\x82\xAC\xF0\x9D\x84\x9E";
+		auto utf16 = StringConvert::convert (text);
+		EXPECT_EQ (utf16.size (), 5u);
+		EXPECT_EQ (utf16[0], u'a');
+		EXPECT_EQ (utf16[1], static_cast<char16_t> (0x00E9));
+		EXPECT_EQ (utf16[2], static_cast<char16_t> (0x20AC));
+		EXPECT_EQ (utf16[3], static_cast<char16_t> (0xD834));
+		EXPECT_EQ (utf16[4], static_cast<char16_t> (0xDD1E));
+		EXPECT_EQ (StringConvert::convert (utf16), text);
+
+		String128 str;
+		EXPECT_EQ (StringConvert::convert (text, str), true);
+		EXPECT_EQ (StringConvert::convert (str), text);
+		EXPECT_EQ (StringConvert::convert (str, 3), std::string ("a\xC3\xA9\xE2\x82\xAC"));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Invalid input"), [] (ITestResult* testResult) {
+		// stray continuation byte, overlong '/', encoded surrogate, truncated sequence; every
+		// byte of an invalid sequence is replaced with U+FFFD
+		const std::string text = "\x80" "a\xC0\xAF" "b\xED\xA0\x80" "c\xE2\x82";
+		auto utf16 = StringConvert::convert (text);
+		EXPECT_EQ (utf16.size (), 11u);
+		EXPECT_EQ (utf16[0], static_cast<char16_t> (0xFFFD));
+		EXPECT_EQ (utf16[1], u'a');
+		EXPECT_EQ (utf16[4], u'b');
+		EXPECT_EQ (utf16[8], u'c');
+
+		const std::u16string unpaired = {u'x', static_cast<char16_t> (0xDC00), u'y',
+		                                 static_cast<char16_t> (0xD800)};
+		EXPECT_EQ (StringConvert::convert (unpaired),
+		           std::string ("x\xEF\xBF\xBDy\xEF\xBF\xBD"));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Fixed buffer overflow"), [] (ITestResult* testResult) {
+		std::string text (200, 'x');
+		String128 str;
+		EXPECT_EQ (StringConvert::convert (text, str), false);
+		EXPECT_EQ (tstrlen (str), 127);
+
+		// a surrogate pair is never split
+		TChar small[4];
+		EXPECT_EQ (StringConvert::convert ("ab\xF0\x9D\x84\x9E", small, 4), false);
+		EXPECT_EQ (small[2], 0);
+
+		char utf8[4];
+		size_t numBytes = 0;
+		const std::u16string euros = u"\u20AC\u20AC";
+		EXPECT_EQ (Steinberg::StringConvert::utf16ToUtf8 (euros.data (), euros.size (), utf8, 4,
+		                                                  numBytes),
+		           false);
+		EXPECT_EQ (numBytes, 3u);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,322 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/test/umpencodertest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test UMP encoder
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/hosting/eventlist.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include "public.sdk/source/vst/hosting/umpeventbridge.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/utility/umpencoder.h"
+#include "pluginterfaces/base/funknownimpl.h"
+
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+static_assert (UMP::scaleUp (0, 7, 32) == 0u, "");
+static_assert (UMP::scaleUp (64, 7, 32) == 0x80000000u, "");
+static_assert (UMP::scaleUp (127, 7, 32) == 0xffffffffu, "");
+static_assert (UMP::scaleUp (8192, 14, 32) == 0x80000000u, "");
+static_assert (UMP::scaleUp (16383, 14, 32) == 0xffffffffu, "");
+static_assert (UMP::makeNoteOn (1, 2, 60, 0xffff)[0] == 0x41923c00u, "");
+
+//------------------------------------------------------------------------
+struct MidiMapping : U::ImplementsNonDestroyable<U::Directly<IMidiMapping>>
+{
+	tresult PLUGIN_API getMidiControllerAssignment (int32 busIndex, int16 channel,
+	                                                CtrlNumber midiControllerNumber,
+	                                                ParamID& id) override
+	{
+		if (busIndex != 0)
+			return kResultFalse;
+		if (midiControllerNumber == kCtrlModWheel && channel < 2)
+		{
+			id = 100;
+			return kResultTrue;
+		}
+		if (midiControllerNumber == kPitchBend && channel == 0)
+		{
+			id = 101;
+			return kResultTrue;
+		}
+		return kResultFalse;
+	}
+};
+
+//------------------------------------------------------------------------
+struct SysExCollector : UMP::UniversalMidiPacketStaticHandlerAdapter
+{
+	std::vector<uint8_t>* bytes {nullptr};
+	std::vector<uint8_t>* statuses {nullptr};
+
+	void add (uint8_t status, const uint8_t* data, size_t numBytes) const
+	{
+		statuses->push_back (status);
+		bytes->insert (bytes->end (), data, data + numBytes);
+	}
+	void onSysExPacket (Group, SysEx6ByteData data) const { add (0, data.data (), 6); }
+	void onSysExStart (Group, SysEx6ByteData data) const { add (1, data.data (), 6); }
+	void onSysExContinue (Group, SysEx6ByteData data) const { add (2, data.data (), 6); }
+	void onSysExEnd (Group, SysEx6ByteData data) const { add (3, data.data (), 6); }
+	void onSysEx8Packet (Group, Data8 numBytes, Index, SysEx13ByteData data) const
+	{
+		add (0, data.data (), numBytes - 1);
+	}
+	void onSysEx8Start (Group, Data8 numBytes, Index, SysEx13ByteData data) const
+	{
+		add (1, data.data (), numBytes - 1);
+	}
+	void onSysEx8Continue (Group, Data8 numBytes, Index, SysEx13ByteData data) const
+	{
+		add (2, data.data (), numBytes - 1);
+	}
+	void onSysEx8End (Group, Data8 numBytes, Index, SysEx13ByteData data) const
+	{
+		add (3, data.data (), numBytes - 1);
+	}
+};
+
+//------------------------------------------------------------------------
+Event makeNoteOn (int16 channel, int16 pitch, float velocity, float tuning, int32 noteId)
+{
+	Event e {};
+	e.type = Event::kNoteOnEvent;
+	e.noteOn.channel = channel;
+	e.noteOn.pitch = pitch;
+	e.noteOn.velocity = velocity;
+	e.noteOn.tuning = tuning;
+	e.noteOn.noteId = noteId;
+	return e;
+}
+
+//------------------------------------------------------------------------
+Event makeNoteExpression (NoteExpressionTypeID typeID, int32 noteId, NoteExpressionValue value)
+{
+	Event e {};
+	e.type = Event::kNoteExpressionValueEvent;
+	e.noteExpressionValue.typeId = typeID;
+	e.noteExpressionValue.noteId = noteId;
+	e.noteExpressionValue.value = value;
+	return e;
+}
+
+//------------------------------------------------------------------------
+Event makeMIDICCOut (uint8 controlNumber, int8 channel, int8 value, int8 value2 = 0)
+{
+	Event e {};
+	e.type = Event::kLegacyMIDICCOutEvent;
+	e.midiCCOut.controlNumber = controlNumber;
+	e.midiCCOut.channel = channel;
+	e.midiCCOut.value = value;
+	e.midiCCOut.value2 = value2;
+	return e;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer UMPEncoderTests ([] () {
+	constexpr auto TestSuiteName = "UMPEncoder";
+	registerTest (TestSuiteName, STR ("Notes round trip"), [] (ITestResult* testResult) {
+		UMP::EventEncoder encoder;
+		uint32_t words[16];
+		size_t numWords = 0;
+		numWords += encoder.encode (makeNoteOn (3, 64, 1.f, 25.f, 1000), words, 16);
+		numWords += encoder.encode (makeNoteExpression (kTuningTypeID, 1000, 0.6),
+		                            words + numWords, 16 - numWords);
+		numWords += encoder.encode (makeNoteExpression (kBrightnessTypeID, 1000, 1.),
+		                            words + numWords, 16 - numWords);
+		numWords += encoder.encode (makeNoteExpression (kCustomStart + 5, 1000, 0.),
+		                            words + numWords, 16 - numWords);
+		// an unknown note ID is not encodable
+		EXPECT_EQ (encoder.encode (makeNoteExpression (kVolumeTypeID, 7, 0.), words + numWords,
+		                           16 - numWords),
+		           0u);
+		Event noteOff {};
+		noteOff.type = Event::kNoteOffEvent;
+		noteOff.noteOff.channel = 3;
+		noteOff.noteOff.pitch = 64;
+		noteOff.noteOff.noteId = 1000;
+		numWords += encoder.encode (noteOff, words + numWords, 16 - numWords);
+		EXPECT_EQ (numWords, 10u);
+		// the note ID is released with the note off
+		EXPECT_EQ (encoder.encode (makeNoteExpression (kTuningTypeID, 1000, 0.5), words, 16),
+		           0u);
+
+		EventList events;
+		ParameterChanges changes;
+		UMPEventBridge<> bridge;
+		bridge.beginBlock (events, changes);
+		EXPECT_EQ (bridge.process (numWords, words, 0), numWords);
+		EXPECT_EQ (events.getEventCount (), 5);
+		Event e;
+		EXPECT_EQ (events.getEvent (0, e), kResultTrue);
+		EXPECT_EQ (e.type, Event::kNoteOnEvent);
+		EXPECT_EQ (e.noteOn.channel, 3);
+		EXPECT_EQ (e.noteOn.pitch, 64);
+		EXPECT_EQ (e.noteOn.velocity, 1.f);
+		EXPECT (Test::maxDiff (e.noteOn.tuning, 25.f, 0.2f));
+		EXPECT_EQ (events.getEvent (1, e), kResultTrue);
+		EXPECT_EQ (e.noteExpressionValue.typeId, static_cast<NoteExpressionTypeID> (kTuningTypeID));
+		EXPECT (Test::maxDiff (e.noteExpressionValue.value, 0.6, 0.0001));
+		EXPECT_EQ (events.getEvent (2, e), kResultTrue);
+		EXPECT_EQ (e.noteExpressionValue.typeId,
+		           static_cast<NoteExpressionTypeID> (kBrightnessTypeID));
+		EXPECT_EQ (e.noteExpressionValue.value, 1.);
+		EXPECT_EQ (events.getEvent (3, e), kResultTrue);
+		EXPECT_EQ (e.noteExpressionValue.typeId,
+		           static_cast<NoteExpressionTypeID> (kCustomStart + 5));
+		EXPECT_EQ (events.getEvent (4, e), kResultTrue);
+		EXPECT_EQ (e.type, Event::kNoteOffEvent);
+		EXPECT_EQ (e.noteOff.pitch, 64);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Legacy MIDI CC out"), [] (ITestResult* testResult) {
+		UMP::EventEncoder encoder;
+		encoder.setGroup (2);
+		uint32_t words[2];
+		EXPECT_EQ (encoder.encode (makeMIDICCOut (kCtrlModWheel, 1, 127), words, 2), 2u);
+		EXPECT_EQ (words[0], 0x42b10100u);
+		EXPECT_EQ (words[1], 0xffffffffu);
+		EXPECT_EQ (encoder.encode (makeMIDICCOut (kPitchBend, 0, 0, 64), words, 2), 2u);
+		EXPECT_EQ (words[0], 0x42e00000u);
+		EXPECT_EQ (words[1], 0x80000000u);
+		EXPECT_EQ (encoder.encode (makeMIDICCOut (kAfterTouch, 0, 64), words, 2), 2u);
+		EXPECT_EQ (words[0], 0x42d00000u);
+		EXPECT_EQ (words[1], 0x80000000u);
+		EXPECT_EQ (encoder.encode (makeMIDICCOut (kCtrlProgramChange, 4, 42), words, 2), 2u);
+		EXPECT_EQ (words[0], 0x42c40000u);
+		EXPECT_EQ (words[1], 0x2a000000u);
+		EXPECT_EQ (encoder.encode (makeMIDICCOut (kCtrlPolyPressure, 0, 60, 127), words, 2), 2u);
+		EXPECT_EQ (words[0], 0x42a03c00u);
+		EXPECT_EQ (words[1], 0xffffffffu);
+		// not enough space
+		EXPECT_EQ (encoder.encode (makeMIDICCOut (kCtrlModWheel, 1, 127), words, 1), 0u);
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("SysEx chunking"), [] (ITestResult* testResult) {
+		std::vector<uint8_t> message {0xf0};
+		for (uint8_t i = 0; i < 20; ++i)
+			message.push_back (i);
+		message.push_back (0xf7);
+		Event e {};
+		e.type = Event::kDataEvent;
+		e.data.type = DataEvent::kMidiSysEx;
+		e.data.size = static_cast<uint32> (message.size ());
+		e.data.bytes = message.data ();
+
+		UMP::EventEncoder encoder;
+		std::vector<uint32_t> words (encoder.wordCount (e));
+		EXPECT_EQ (words.size (), 8u);
+		EXPECT_EQ (encoder.encode (e, words.data (), words.size () - 1), 0u);
+		EXPECT_EQ (encoder.encode (e, words.data (), words.size ()), 8u);
+		std::vector<uint8_t> bytes;
+		std::vector<uint8_t> statuses;
+		SysExCollector collector;
+		collector.bytes = &bytes;
+		collector.statuses = &statuses;
+		EXPECT_EQ (UMP::parsePackets<UMP::SysEx> (words.size (), words.data (), collector), 8u);
+		EXPECT (statuses == std::vector<uint8_t> ({1, 2, 2, 3}));
+		EXPECT (std::equal (message.begin () + 1, message.end () - 1, bytes.begin ()));
+
+		encoder.setSysExFormat (UMP::EventEncoder::SysExFormat::EightBit, 7);
+		words.resize (encoder.wordCount (e));
+		EXPECT_EQ (words.size (), 8u);
+		EXPECT_EQ (encoder.encode (e, words.data (), words.size ()), 8u);
+		EXPECT_EQ (((words[0] >> 8) & 0xff), 7u);
+		bytes.clear ();
+		statuses.clear ();
+		EXPECT_EQ (UMP::parsePackets<UMP::Data128> (words.size (), words.data (), collector), 8u);
+		EXPECT (statuses == std::vector<uint8_t> ({1, 3}));
+		EXPECT_EQ (bytes.size (), 20u);
+		EXPECT (std::equal (message.begin () + 1, message.end () - 1, bytes.begin ()));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Event list into a small buffer"),
+	              [] (ITestResult* testResult) {
+		              EventList events;
+		              for (int16 i = 0; i < 5; ++i)
+		              {
+			              auto e = makeNoteOn (0, 60 + i, 0.5f, 0.f, i);
+			              events.addEvent (e);
+		              }
+		              UMP::EventEncoder encoder;
+		              uint32_t words[4];
+		              auto result = encoder.encode (events, 0, words, 4);
+		              EXPECT_EQ (result.numWords, 4u);
+		              EXPECT_EQ (result.numEvents, 2);
+		              result = encoder.encode (events, 2, words, 4);
+		              EXPECT_EQ (result.numEvents, 2);
+		              result = encoder.encode (events, 4, words, 4);
+		              EXPECT_EQ (result.numWords, 2u);
+		              EXPECT_EQ (result.numEvents, 1);
+		              return true;
+	              });
+	registerTest (TestSuiteName, STR ("Controller changes"), [] (ITestResult* testResult) {
+		MidiMapping mapping;
+		UMP::ControllerEncoder encoder;
+		encoder.updateMapping (&mapping);
+		EXPECT_EQ (encoder.wordCount (100), 4u);
+		EXPECT_EQ (encoder.wordCount (101), 2u);
+		EXPECT_EQ (encoder.wordCount (102), 0u);
+
+		ParameterChanges changes (4);
+		int32 index;
+		auto queue = changes.addParameterData (100, index);
+		queue->addPoint (0, 1., index);
+		queue = changes.addParameterData (102, index);
+		queue->addPoint (0, 1., index);
+		queue = changes.addParameterData (101, index);
+		queue->addPoint (8, 0.5, index);
+
+		uint32_t words[8] {};
+		EXPECT_EQ (encoder.encode (changes, words, 8), 6u);
+		EXPECT_EQ (words[0], 0x40b00100u);
+		EXPECT_EQ (words[1], 0xffffffffu);
+		EXPECT_EQ (words[2], 0x40b10100u);
+		EXPECT_EQ (words[4], 0x40e00000u);
+		EXPECT_EQ (words[5], 0x80000000u);
+		// a change is not split
+		EXPECT_EQ (encoder.encode (changes, words, 3), 0u);
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
@@ -0,0 +1,179 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/test/unitinfocachetest.cpp
+// Created by  : Steinberg, 10/2026
+// Description : Test unit info cache
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include "public.sdk/source/main/moduleinit.h"
+#include "public.sdk/source/vst/utility/testing.h"
+#include "public.sdk/source/vst/utility/unitinfocache.h"
+#include "pluginterfaces/base/funknownimpl.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace {
+
+//------------------------------------------------------------------------
+class TestUnitInfo : public U::ImplementsNonDestroyable<U::Directly<IUnitInfo>>
+{
+public:
+	void addUnit (UnitID id, UnitID parentUnitId, const std::u16string& name,
+	              ProgramListID programListId = kNoProgramListId)
+	{
+		UnitInfo info = {};
+		info.id = id;
+		info.parentUnitId = parentUnitId;
+		memcpy (info.name, name.data (), (name.size () + 1) * sizeof (TChar));
+		info.programListId = programListId;
+		units.push_back (info);
+	}
+
+	int32 PLUGIN_API getUnitCount () override { return static_cast<int32> (units.size ()); }
+	tresult PLUGIN_API getUnitInfo (int32 unitIndex, UnitInfo& info) override
+	{
+		if (unitIndex < 0 || unitIndex >= getUnitCount ())
+			return kInvalidArgument;
+		info = units[unitIndex];
+		return kResultTrue;
+	}
+	int32 PLUGIN_API getProgramListCount () override { return 0; }
+	tresult PLUGIN_API getProgramListInfo (int32, ProgramListInfo&) override
+	{
+		return kInvalidArgument;
+	}
+	tresult PLUGIN_API getProgramName (ProgramListID, int32, String128) override
+	{
+		return kInvalidArgument;
+	}
+	tresult PLUGIN_API getProgramInfo (ProgramListID, int32, CString, String128) override
+	{
+		return kInvalidArgument;
+	}
+	tresult PLUGIN_API hasProgramPitchNames (ProgramListID, int32) override
+	{
+		return kResultFalse;
+	}
+	tresult PLUGIN_API getProgramPitchName (ProgramListID, int32, int16, String128) override
+	{
+		return kResultFalse;
+	}
+	UnitID PLUGIN_API getSelectedUnit () override { return kRootUnitId; }
+	tresult PLUGIN_API selectUnit (UnitID) override { return kResultFalse; }
+	tresult PLUGIN_API getUnitByBus (MediaType, BusDirection, int32, int32, UnitID&) override
+	{
+		return kResultFalse;
+	}
+	tresult PLUGIN_API setUnitProgramData (int32, int32, IBStream*) override
+	{
+		return kResultFalse;
+	}
+
+	std::vector<UnitInfo> units;
+};
+
+//------------------------------------------------------------------------
+bool hasPath (const UnitInfoCache& cache, UnitID unitID, const std::u16string& expected)
+{
+	auto path = cache.getPath (unitID);
+	return path && std::u16string (reinterpret_cast<const char16_t*> (path->data ())) == expected;
+}
+
+//------------------------------------------------------------------------
+ModuleInitializer UnitInfoCacheTests ([] () {
+	constexpr auto TestSuiteName = "UnitInfoCache";
+	registerTest (TestSuiteName, STR ("Unit paths"), [] (ITestResult* testResult) {
+		TestUnitInfo unitInfo;
+		// children before their parents
+		unitInfo.addUnit (3, 2, u"LFO 1", 7);
+		unitInfo.addUnit (kRootUnitId, kNoParentUnitId, u"Root");
+		unitInfo.addUnit (2, kRootUnitId, u"Modulators");
+		unitInfo.addUnit (4, 2, u"LFO 2");
+
+		UnitInfoCache cache;
+		cache.update (&unitInfo);
+		EXPECT_EQ (cache.size (), 4u);
+		EXPECT_TRUE (hasPath (cache, 2, u"Modulators."));
+		EXPECT_TRUE (hasPath (cache, 3, u"Modulators.LFO 1."));
+		EXPECT_TRUE (hasPath (cache, 4, u"Modulators.LFO 2."));
+		EXPECT_FALSE (cache.getPath (5));
+
+		auto unit = cache.find (3);
+		EXPECT_TRUE (unit);
+		EXPECT_EQ (unit->programListId, 7);
+		EXPECT_FALSE (cache.find (5));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Update after changes"), [] (ITestResult* testResult) {
+		TestUnitInfo unitInfo;
+		unitInfo.addUnit (2, kRootUnitId, u"Modulators");
+		unitInfo.addUnit (3, 2, u"LFO 1");
+		UnitInfoCache cache;
+		cache.update (&unitInfo);
+		EXPECT_TRUE (hasPath (cache, 3, u"Modulators.LFO 1."));
+
+		// renamed and moved units are only seen after the next update
+		unitInfo.units.clear ();
+		unitInfo.addUnit (2, kRootUnitId, u"Mod");
+		unitInfo.addUnit (5, kRootUnitId, u"Envelopes");
+		unitInfo.addUnit (3, 5, u"Env 1");
+		EXPECT_TRUE (hasPath (cache, 3, u"Modulators.LFO 1."));
+		cache.update (&unitInfo);
+		EXPECT_TRUE (hasPath (cache, 2, u"Mod."));
+		EXPECT_TRUE (hasPath (cache, 3, u"Envelopes.Env 1."));
+
+		cache.update (nullptr);
+		EXPECT_EQ (cache.size (), 0u);
+		EXPECT_FALSE (cache.getPath (3));
+		return true;
+	});
+	registerTest (TestSuiteName, STR ("Parent cycle"), [] (ITestResult* testResult) {
+		TestUnitInfo unitInfo;
+		unitInfo.addUnit (2, 3, u"A");
+		unitInfo.addUnit (3, 2, u"B");
+		UnitInfoCache cache;
+		cache.update (&unitInfo);
+		EXPECT_TRUE (cache.getPath (2));
+		EXPECT_TRUE (cache.getPath (3));
+		return true;
+	});
+});
+
+//------------------------------------------------------------------------
+} // anonymous
+} // Vst
+} // Steinberg
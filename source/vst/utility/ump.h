@@ -47,6 +47,7 @@
 
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 
 //------------------------------------------------------------------------
@@ -66,23 +67,29 @@ enum ParseSections : uint8_t
 	System = 1 << 1,
 	ChannelVoice1 = 1 << 2,
 	SysEx = 1 << 3,
-	ChannelVoice2 = 1 << 3,
-	Data128 = 1 << 4,
+	ChannelVoice2 = 1 << 4,
+	Data128 = 1 << 5,
 	All = 0xff
 };
 
 //------------------------------------------------------------------------
 /** stateless parsing universal MIDI packets
+ *
+ *	the handler is called via its static type, so a handler which does not derive from
+ *	IUniversalMidiPacketHandler (see UniversalMidiPacketStaticHandlerAdapter) is called without
+ *	virtual dispatch and can be inlined completely. Messages of sections not enabled are skipped
+ *	without decoding.
  *
  *	@tparam sections	which sections to parse
+ *	@tparam Handler		handler type
  *	@param numWords		number of 32-bit words
  *	@param words		pointer to a words array
  *	@param handler		callback handler
  *	@return				number of successfully processed words
  */
-template <ParseSections sections = ParseSections::All>
-size_t parsePackets (const size_t numWords, const uint32_t* words,
-                     const IUniversalMidiPacketHandler& handler);
+template <ParseSections sections = ParseSections::All,
+          typename Handler = IUniversalMidiPacketHandler>
+size_t parsePackets (const size_t numWords, const uint32_t* words, const Handler& handler);
 
 //------------------------------------------------------------------------
 struct IUniversalMidiPacketHandler
@@ -485,8 +492,9 @@ struct UMPMessageData128 : UMPMessage4
 };
 
 //------------------------------------------------------------------------
+template <typename Handler>
 SMTG_ALWAYS_INLINE bool onUtilityMessage (const UMPMessageUtility& msg,
-                                          const IUniversalMidiPacketHandler& handler)
+                                          const Handler& handler)
 {
 	auto status = msg.status ();
 	using Status = UMPMessageUtility::Status;
@@ -513,8 +521,9 @@ SMTG_ALWAYS_INLINE bool onUtilityMessage (const UMPMessageUtility& msg,
 }
 
 //------------------------------------------------------------------------
+template <typename Handler>
 SMTG_ALWAYS_INLINE bool onSystemMessage (const UMPMessageSystem& msg,
-                                         const IUniversalMidiPacketHandler& handler)
+                                         const Handler& handler)
 {
 	auto status = msg.status ();
 	using Status = UMPMessageSystem::Status;
@@ -577,8 +586,9 @@ SMTG_ALWAYS_INLINE bool onSystemMessage (const UMPMessageSystem& msg,
 }
 
 //------------------------------------------------------------------------
+template <typename Handler>
 SMTG_ALWAYS_INLINE bool onChannelVoice1Message (const UMPMessageChannelVoice1& msg,
-                                                const IUniversalMidiPacketHandler& handler)
+                                                const Handler& handler)
 {
 	using Status = UMPMessageChannelVoice1::Status;
 	switch (msg.status ())
@@ -629,8 +639,9 @@ SMTG_ALWAYS_INLINE bool onChannelVoice1Message (const UMPMessageChannelVoice1& m
 }
 
 //------------------------------------------------------------------------
+template <typename Handler>
 SMTG_ALWAYS_INLINE bool onSysExMessage (const UMPMessageSysEx& msg,
-                                        const IUniversalMidiPacketHandler& handler)
+                                        const Handler& handler)
 {
 	using Status = UMPMessageSysEx::Status;
 	switch (msg.status ())
@@ -669,8 +680,9 @@ SMTG_ALWAYS_INLINE bool onSysExMessage (const UMPMessageSysEx& msg,
 }
 
 //------------------------------------------------------------------------
+template <typename Handler>
 SMTG_ALWAYS_INLINE bool onChannelVoice2Message (const UMPMessageChannelVoice2& msg,
-                                                const IUniversalMidiPacketHandler& handler)
+                                                const Handler& handler)
 {
 	auto group = msg.group ();
 	auto status = msg.status ();
@@ -769,8 +781,9 @@ SMTG_ALWAYS_INLINE bool onChannelVoice2Message (const UMPMessageChannelVoice2& m
 }
 
 //------------------------------------------------------------------------
+template <typename Handler>
 SMTG_ALWAYS_INLINE bool onData128Message (const UMPMessageData128& msg,
-                                          const IUniversalMidiPacketHandler& handler)
+                                          const Handler& handler)
 {
 	using Status = UMPMessageData128::Status;
 	switch (msg.status ())
@@ -779,32 +792,36 @@ SMTG_ALWAYS_INLINE bool onData128Message (const UMPMessageData128& msg,
 		{
 			handler.onSysEx8Packet (msg.group (), msg.numBytes (), msg.byte3 (),
 			                        {msg.byte4 (), msg.byte5 (), msg.byte6 (), msg.byte7 (),
-			                         msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte12 (),
-			                         msg.byte13 (), msg.byte14 (), msg.byte15 (), msg.byte16 ()});
+			                         msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte11 (),
+			                         msg.byte12 (), msg.byte13 (), msg.byte14 (), msg.byte15 (),
+			                         msg.byte16 ()});
 			break;
 		}
 		case Status::Start:
 		{
 			handler.onSysEx8Start (msg.group (), msg.numBytes (), msg.byte3 (),
 			                       {msg.byte4 (), msg.byte5 (), msg.byte6 (), msg.byte7 (),
-			                        msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte12 (),
-			                        msg.byte13 (), msg.byte14 (), msg.byte15 (), msg.byte16 ()});
+			                        msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte11 (),
+			                        msg.byte12 (), msg.byte13 (), msg.byte14 (), msg.byte15 (),
+			                        msg.byte16 ()});
 			break;
 		}
 		case Status::Continue:
 		{
 			handler.onSysEx8Continue (msg.group (), msg.numBytes (), msg.byte3 (),
 			                          {msg.byte4 (), msg.byte5 (), msg.byte6 (), msg.byte7 (),
-			                           msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte12 (),
-			                           msg.byte13 (), msg.byte14 (), msg.byte15 (), msg.byte16 ()});
+			                           msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte11 (),
+			                           msg.byte12 (), msg.byte13 (), msg.byte14 (), msg.byte15 (),
+			                           msg.byte16 ()});
 			break;
 		}
 		case Status::End:
 		{
 			handler.onSysEx8End (msg.group (), msg.numBytes (), msg.byte3 (),
 			                     {msg.byte4 (), msg.byte5 (), msg.byte6 (), msg.byte7 (),
-			                      msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte12 (),
-			                      msg.byte13 (), msg.byte14 (), msg.byte15 (), msg.byte16 ()});
+			                      msg.byte8 (), msg.byte9 (), msg.byte10 (), msg.byte11 (),
+			                      msg.byte12 (), msg.byte13 (), msg.byte14 (), msg.byte15 (),
+			                      msg.byte16 ()});
 			break;
 		}
 		case Status::MixedHeader:
@@ -812,7 +829,7 @@ SMTG_ALWAYS_INLINE bool onData128Message (const UMPMessageData128& msg,
 			handler.onMixedDataSetHeader (msg.group (), msg.mdsId (),
 			                              {msg.byte3 (), msg.byte4 (), msg.byte5 (), msg.byte6 (),
 			                               msg.byte7 (), msg.byte8 (), msg.byte9 (), msg.byte10 (),
-			                               msg.byte12 (), msg.byte13 (), msg.byte14 (),
+			                               msg.byte11 (), msg.byte12 (), msg.byte13 (), msg.byte14 (),
 			                               msg.byte15 (), msg.byte16 ()});
 			break;
 		}
@@ -821,7 +838,7 @@ SMTG_ALWAYS_INLINE bool onData128Message (const UMPMessageData128& msg,
 			handler.onMixedDataSetPayload (msg.group (), msg.mdsId (),
 			                               {msg.byte3 (), msg.byte4 (), msg.byte5 (), msg.byte6 (),
 			                                msg.byte7 (), msg.byte8 (), msg.byte9 (), msg.byte10 (),
-			                                msg.byte12 (), msg.byte13 (), msg.byte14 (),
+			                                msg.byte11 (), msg.byte12 (), msg.byte13 (), msg.byte14 (),
 			                                msg.byte15 (), msg.byte16 ()});
 			break;
 		}
@@ -831,10 +848,32 @@ SMTG_ALWAYS_INLINE bool onData128Message (const UMPMessageData128& msg,
 }
 
 //------------------------------------------------------------------------
-template <uint32_t Sections>
+/** bit mask of the message types to decode for the parse sections */
+constexpr uint32_t messageTypeMask (uint32_t sections)
+{
+	uint32_t mask = 0;
+	if (sections & ParseSections::Utility)
+		mask |= 1u << static_cast<uint32_t> (MessageType::Utility);
+	if (sections & ParseSections::System)
+		mask |= 1u << static_cast<uint32_t> (MessageType::System);
+	if (sections & ParseSections::ChannelVoice1)
+		mask |= 1u << static_cast<uint32_t> (MessageType::ChannelVoice1);
+	if (sections & ParseSections::SysEx)
+		mask |= 1u << static_cast<uint32_t> (MessageType::SysEx);
+	if (sections & ParseSections::ChannelVoice2)
+		mask |= 1u << static_cast<uint32_t> (MessageType::ChannelVoice2);
+	if (sections & ParseSections::Data128)
+		mask |= 1u << static_cast<uint32_t> (MessageType::Data128);
+	return mask;
+}
+
+//------------------------------------------------------------------------
+template <uint32_t Sections, typename Handler>
 SMTG_ALWAYS_INLINE size_t parse (const size_t numWords, const uint32_t* words,
-                                 const IUniversalMidiPacketHandler& handler)
+                                 const Handler& handler)
 {
+	constexpr uint32_t typeMask = messageTypeMask (Sections);
+
 	auto msg = reinterpret_cast<const UMPMessage*> (words);
 	for (size_t index = 0; index < numWords;)
 	{
@@ -844,6 +883,13 @@ SMTG_ALWAYS_INLINE size_t parse (const size_t numWords, const uint32_t* words,
 			handler.onInsufficentInputData (index, (index + numMsgWords) - numWords);
 			return index;
 		}
+		// fast path for messages of sections not enabled
+		if ((typeMask & (1u << static_cast<uint32_t> (msg->type ()))) == 0)
+		{
+			index += numMsgWords;
+			msg += numMsgWords;
+			continue;
+		}
 		switch (msg->type ())
 		{
 			case MessageType::Utility:
@@ -933,6 +979,7 @@ SMTG_ALWAYS_INLINE size_t parse (const size_t numWords, const uint32_t* words,
 					}
 				break;
 			}
+			default: break;
 		}
 		index += numMsgWords;
 		msg += numMsgWords;
@@ -944,9 +991,9 @@ SMTG_ALWAYS_INLINE size_t parse (const size_t numWords, const uint32_t* words,
 } // Detail
 
 //------------------------------------------------------------------------
-template <ParseSections Sections>
+template <ParseSections Sections, typename Handler>
 SMTG_ALWAYS_INLINE size_t parsePackets (const size_t numWords, const uint32_t* words,
-                                        const IUniversalMidiPacketHandler& handler)
+                                        const Handler& handler)
 {
 	return Detail::parse<Sections> (numWords, words, handler);
 }
@@ -1066,5 +1113,149 @@ struct UniversalMidiPacketHandlerAdapter : IUniversalMidiPacketHandler
 	void onInsufficentInputData (size_t index, size_t numMissingWords) const override {}
 };
 
+//------------------------------------------------------------------------
+/** adapter with empty handler functions for parsePackets without virtual dispatch
+ *
+ *	derive from it and hide the functions you are interested in. The type of the derived handler
+ *	has to be passed to parsePackets.
+ */
+struct UniversalMidiPacketStaticHandlerAdapter
+{
+	using Group = IUniversalMidiPacketHandler::Group;
+	using Channel = IUniversalMidiPacketHandler::Channel;
+	using Index = IUniversalMidiPacketHandler::Index;
+	using NoteNumber = IUniversalMidiPacketHandler::NoteNumber;
+	using BankNumber = IUniversalMidiPacketHandler::BankNumber;
+	using ControllerNumber = IUniversalMidiPacketHandler::ControllerNumber;
+	using Velocity8 = IUniversalMidiPacketHandler::Velocity8;
+	using Velocity16 = IUniversalMidiPacketHandler::Velocity16;
+	using AttributeType = IUniversalMidiPacketHandler::AttributeType;
+	using AttributeValue = IUniversalMidiPacketHandler::AttributeValue;
+	using OptionFlags = IUniversalMidiPacketHandler::OptionFlags;
+	using Data8 = IUniversalMidiPacketHandler::Data8;
+	using Data32 = IUniversalMidiPacketHandler::Data32;
+	using Program = IUniversalMidiPacketHandler::Program;
+	using BankMSB = IUniversalMidiPacketHandler::BankMSB;
+	using BankLSB = IUniversalMidiPacketHandler::BankLSB;
+	using Timestamp = IUniversalMidiPacketHandler::Timestamp;
+	using Timecode = IUniversalMidiPacketHandler::Timecode;
+	using StreamID = IUniversalMidiPacketHandler::StreamID;
+	using SysEx6ByteData = IUniversalMidiPacketHandler::SysEx6ByteData;
+	using SysEx13ByteData = IUniversalMidiPacketHandler::SysEx13ByteData;
+	using MixedData = IUniversalMidiPacketHandler::MixedData;
+	using SystemRealtime = IUniversalMidiPacketHandler::SystemRealtime;
+
+	void onNoop (Group group) const {}
+	void onJitterClock (Group group, Timestamp time) const {}
+	void onJitterTimestamp (Group group, Timestamp time) const {}
+	void onMIDITimeCode (Group group, Timecode timecode) const {}
+	void onSongPositionPointer (Group group, uint8_t posLSB, uint8_t posMSB) const {}
+	void onSongSelect (Group group, uint8_t songIndex) const {}
+	void onTuneRequest (Group group) const {}
+	void onSystemRealtime (Group group, SystemRealtime which) const {}
+	void onMidi1NoteOff (Group group, Channel channel, NoteNumber note,
+	                     Velocity8 velocity) const
+	{
+	}
+	void onMidi1NoteOn (Group group, Channel channel, NoteNumber note,
+	                    Velocity8 velocity) const
+	{
+	}
+	void onMidi1PolyPressure (Group group, Channel channel, NoteNumber note,
+	                          Data8 data) const
+	{
+	}
+	void onMidi1ControlChange (Group group, Channel channel, ControllerNumber controller,
+	                           Data8 value) const
+	{
+	}
+	void onMidi1ProgramChange (Group group, Channel channel, Program program) const {}
+	void onMidi1ChannelPressure (Group group, Channel channel, Data8 pressure) const {}
+	void onMidi1PitchBend (Group group, Channel channel, Data8 valueLSB,
+	                       Data8 valueMSB) const
+	{
+	}
+	void onSysExPacket (Group group, SysEx6ByteData data) const {}
+	void onSysExStart (Group group, SysEx6ByteData data) const {}
+	void onSysExContinue (Group group, SysEx6ByteData data) const {}
+	void onSysExEnd (Group group, SysEx6ByteData data) const {}
+	void onRegisteredPerNoteController (Group group, Channel channel, NoteNumber note,
+	                                    ControllerNumber controller, Data32 data) const
+	{
+	}
+	void onAssignablePerNoteController (Group group, Channel channel, NoteNumber note,
+	                                    ControllerNumber controller, Data32 data) const
+	{
+	}
+	void onRegisteredController (Group group, Channel channel, BankNumber bank, Index index,
+	                             Data32 data) const
+	{
+	}
+	void onAssignableController (Group group, Channel channel, BankNumber bank, Index index,
+	                             Data32 data) const
+	{
+	}
+	void onRelativeRegisteredController (Group group, Channel channel, BankNumber bank, Index index,
+	                                     Data32 data) const
+	{
+	}
+	void onRelativeAssignableController (Group group, Channel channel, BankNumber bank, Index index,
+	                                     Data32 data) const
+	{
+	}
+	void onPerNotePitchBend (Group group, Channel channel, NoteNumber note,
+	                         Data32 data) const
+	{
+	}
+	void onNoteOff (Group group, Channel channel, NoteNumber note, Velocity16 velocity,
+	                AttributeType attr, AttributeValue attrValue) const
+	{
+	}
+	void onNoteOn (Group group, Channel channel, NoteNumber note, Velocity16 velocity,
+	               AttributeType attr, AttributeValue attrValue) const
+	{
+	}
+	void onPolyPressure (Group group, Channel channel, NoteNumber note, Data32 data) const
+	{
+	}
+	void onControlChange (Group group, Channel channel, ControllerNumber controller,
+	                      Data32 data) const
+	{
+	}
+	void onProgramChange (Group group, Channel channel, OptionFlags options, Program program,
+	                      BankMSB bankMSB, BankLSB bankLSB) const
+	{
+	}
+	void onChannelPressure (Group group, Channel channel, Data32 data) const {}
+	void onPitchBend (Group group, Channel channel, Data32 data) const {}
+	void onPerNoteManagement (Group group, Channel channel, NoteNumber note,
+	                          OptionFlags options) const
+	{
+	}
+	void onSysEx8Packet (Group group, Data8 numBytes, Index streamID,
+	                     SysEx13ByteData data) const
+	{
+	}
+	void onSysEx8Start (Group group, Data8 numBytes, Index streamID,
+	                    SysEx13ByteData data) const
+	{
+	}
+	void onSysEx8Continue (Group group, Data8 numBytes, Index streamID,
+	                       SysEx13ByteData data) const
+	{
+	}
+	void onSysEx8End (Group group, Data8 numBytes, Index streamID,
+	                  SysEx13ByteData data) const
+	{
+	}
+	void onMixedDataSetHeader (Group group, Index mdsID, MixedData data) const {}
+	void onMixedDataSetPayload (Group group, Index mdsID, MixedData data) const {}
+	ParsingAction onInvalidInputData (size_t index) const
+	{
+		return ParsingAction::Continue;
+	}
+	void onInsufficentInputData (size_t index, size_t numMissingWords) const {}
+};
+
 //------------------------------------------------------------------------
 } // Steinberg::Vst::EditorHost
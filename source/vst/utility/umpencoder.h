@@ -0,0 +1,833 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/umpencoder.h
+// Created by  : Steinberg, 10/2026
+// Description : a c++17 header only encoder of VST 3 events and controller changes to UMP
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// 
+//   * Redistributions of source code must retain the above copyright notice, 
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation 
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this 
+//     software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF 
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE  OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "public.sdk/source/vst/utility/ump.h"
+#include "pluginterfaces/vst/ivsteditcontroller.h"
+#include "pluginterfaces/vst/ivstevents.h"
+#include "pluginterfaces/vst/ivstmidicontrollers.h"
+#include "pluginterfaces/vst/ivstnoteexpression.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg::Vst::UMP {
+
+using Packet64 = std::array<uint32_t, 2>;
+using Packet128 = std::array<uint32_t, 4>;
+
+//------------------------------------------------------------------------
+/** per-note management option flags */
+enum PerNoteManagementOptions : uint8_t
+{
+	kResetControllers = 1 << 0,
+	kDetachControllers = 1 << 1,
+};
+
+/** attribute type of note on/off for the pitch 7.9 format */
+static constexpr uint8_t kPitch7_9Attribute = 3;
+
+namespace Detail {
+
+//------------------------------------------------------------------------
+constexpr uint32_t channelVoice2Word (UMPMessageChannelVoice2::Status status, uint8_t group,
+                                      uint8_t channel, uint8_t byte3, uint8_t byte4)
+{
+	return (static_cast<uint32_t> (MessageType::ChannelVoice2) << 28) |
+	       (static_cast<uint32_t> (group & 0xf) << 24) |
+	       (static_cast<uint32_t> (status) << 20) | (static_cast<uint32_t> (channel & 0xf) << 16) |
+	       (static_cast<uint32_t> (byte3) << 8) | byte4;
+}
+
+//------------------------------------------------------------------------
+constexpr uint32_t packWord (const uint8_t* bytes)
+{
+	return (static_cast<uint32_t> (bytes[0]) << 24) | (static_cast<uint32_t> (bytes[1]) << 16) |
+	       (static_cast<uint32_t> (bytes[2]) << 8) | bytes[3];
+}
+
+//------------------------------------------------------------------------
+template <size_t NumWords>
+constexpr size_t writePacket (const std::array<uint32_t, NumWords>& packet, uint32_t* words,
+                              size_t capacity)
+{
+	if (capacity < NumWords)
+		return 0;
+	for (size_t i = 0; i < NumWords; ++i)
+		words[i] = packet[i];
+	return NumWords;
+}
+
+//------------------------------------------------------------------------
+/** the status of the n-th packet of a chunked system exclusive message */
+constexpr uint8_t chunkStatus (size_t index, size_t numPackets)
+{
+	if (numPackets == 1)
+		return 0x0; // complete
+	if (index == 0)
+		return 0x1; // start
+	return index + 1 == numPackets ? 0x3 /* end */ : 0x2 /* continue */;
+}
+
+//------------------------------------------------------------------------
+template <size_t BytesPerPacket>
+constexpr size_t chunkCount (size_t numBytes)
+{
+	return numBytes == 0 ? 1 : (numBytes + BytesPerPacket - 1) / BytesPerPacket;
+}
+
+//------------------------------------------------------------------------
+} // Detail
+
+//------------------------------------------------------------------------
+// value scaling
+//------------------------------------------------------------------------
+/** scales an unsigned value from srcBits to dstBits resolution with the min-center-max algorithm
+ *	of the MIDI 2.0 specification: the minimum, the center and the maximum of the source map to
+ *	the minimum, the center and the maximum of the destination.
+ */
+constexpr uint32_t scaleUp (uint32_t value, uint8_t srcBits, uint8_t dstBits)
+{
+	if (srcBits >= dstBits)
+		return value >> (srcBits - dstBits);
+	const uint32_t scaleBits = dstBits - srcBits;
+	uint64_t shifted = static_cast<uint64_t> (value) << scaleBits;
+	const uint32_t center = 1u << (srcBits - 1);
+	if (value <= center)
+		return static_cast<uint32_t> (shifted);
+	const uint32_t repeatBits = srcBits - 1;
+	uint64_t repeat = value & ((1u << repeatBits) - 1);
+	if (scaleBits > repeatBits)
+		repeat <<= scaleBits - repeatBits;
+	else
+		repeat >>= repeatBits - scaleBits;
+	while (repeat != 0)
+	{
+		shifted |= repeat;
+		repeat >>= repeatBits;
+	}
+	return static_cast<uint32_t> (shifted);
+}
+
+/** normalized [0, 1] value to a MIDI 2.0 32-bit value */
+constexpr uint32_t toData32 (double normalized)
+{
+	if (normalized <= 0.)
+		return 0u;
+	if (normalized >= 1.)
+		return 0xffffffffu;
+	return static_cast<uint32_t> (normalized * 4294967295. + 0.5);
+}
+
+/** normalized [0, 1] velocity to a MIDI 2.0 16-bit velocity */
+constexpr uint16_t toVelocity16 (double normalized)
+{
+	if (normalized <= 0.)
+		return 0u;
+	if (normalized >= 1.)
+		return 0xffffu;
+	return static_cast<uint16_t> (normalized * 65535. + 0.5);
+}
+
+/** pitch of a note with a tuning in cents in the pitch 7.9 format of the note attribute */
+constexpr uint16_t toPitch7_9 (uint8_t note, double cents)
+{
+	auto pitch = (note + cents / 100.) * 512.;
+	if (pitch <= 0.)
+		return 0u;
+	if (pitch >= 65535.)
+		return 0xffffu;
+	return static_cast<uint16_t> (pitch + 0.5);
+}
+
+//------------------------------------------------------------------------
+// MIDI 2.0 channel voice messages
+//------------------------------------------------------------------------
+constexpr Packet64 makeNoteOff (uint8_t group, uint8_t channel, uint8_t note, uint16_t velocity,
+                                uint8_t attrType = 0, uint16_t attrValue = 0)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::NoteOff, group, channel, note & 0x7f, attrType),
+	        (static_cast<uint32_t> (velocity) << 16) | attrValue};
+}
+
+constexpr Packet64 makeNoteOn (uint8_t group, uint8_t channel, uint8_t note, uint16_t velocity,
+                               uint8_t attrType = 0, uint16_t attrValue = 0)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::NoteOn, group, channel, note & 0x7f, attrType),
+	        (static_cast<uint32_t> (velocity) << 16) | attrValue};
+}
+
+constexpr Packet64 makePolyPressure (uint8_t group, uint8_t channel, uint8_t note, uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::PolyPressure, group, channel, note & 0x7f, 0),
+	        data};
+}
+
+constexpr Packet64 makeRegisteredPerNoteController (uint8_t group, uint8_t channel, uint8_t note,
+                                                    uint8_t controller, uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::RegisteredPerNoteController, group, channel,
+	                                   note & 0x7f, controller),
+	        data};
+}
+
+constexpr Packet64 makeAssignablePerNoteController (uint8_t group, uint8_t channel, uint8_t note,
+                                                    uint8_t controller, uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::AssignablePerNoteController, group, channel,
+	                                   note & 0x7f, controller),
+	        data};
+}
+
+constexpr Packet64 makeRegisteredController (uint8_t group, uint8_t channel, uint8_t bank,
+                                             uint8_t index, uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::RegisteredController, group, channel, bank & 0x7f,
+	                                   index & 0x7f),
+	        data};
+}
+
+constexpr Packet64 makeAssignableController (uint8_t group, uint8_t channel, uint8_t bank,
+                                             uint8_t index, uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::AssignableController, group, channel, bank & 0x7f,
+	                                   index & 0x7f),
+	        data};
+}
+
+constexpr Packet64 makePerNotePitchBend (uint8_t group, uint8_t channel, uint8_t note,
+                                         uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::PerNotePitchBend, group, channel, note & 0x7f, 0),
+	        data};
+}
+
+constexpr Packet64 makeControlChange (uint8_t group, uint8_t channel, uint8_t controller,
+                                      uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::ControlChange, group, channel, controller & 0x7f,
+	                                   0),
+	        data};
+}
+
+/** program change, the bank is only valid if bankValid is true */
+constexpr Packet64 makeProgramChange (uint8_t group, uint8_t channel, uint8_t program,
+                                      bool bankValid = false, uint8_t bankMSB = 0,
+                                      uint8_t bankLSB = 0)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::ProgramChange, group, channel, 0,
+	                                   bankValid ? 1 : 0),
+	        (static_cast<uint32_t> (program & 0x7f) << 24) |
+	            (static_cast<uint32_t> (bankMSB & 0x7f) << 8) | (bankLSB & 0x7f)};
+}
+
+constexpr Packet64 makeChannelPressure (uint8_t group, uint8_t channel, uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::ChannelPressure, group, channel, 0, 0), data};
+}
+
+constexpr Packet64 makePitchBend (uint8_t group, uint8_t channel, uint32_t data)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::PitchBend, group, channel, 0, 0), data};
+}
+
+constexpr Packet64 makePerNoteManagement (uint8_t group, uint8_t channel, uint8_t note,
+                                          uint8_t options)
+{
+	using Status = Detail::UMPMessageChannelVoice2::Status;
+	return {Detail::channelVoice2Word (Status::PerNoteManagement, group, channel, note & 0x7f,
+	                                   options),
+	        0u};
+}
+
+//------------------------------------------------------------------------
+// system exclusive messages
+//------------------------------------------------------------------------
+static constexpr size_t kSysEx7BytesPerPacket = 6;
+static constexpr size_t kSysEx8BytesPerPacket = 13;
+
+/** number of words needed to encode numBytes of 7-bit system exclusive data */
+constexpr size_t sysEx7WordCount (size_t numBytes)
+{
+	return Detail::chunkCount<kSysEx7BytesPerPacket> (numBytes) * 2;
+}
+
+/** number of words needed to encode numBytes of 8-bit system exclusive data */
+constexpr size_t sysEx8WordCount (size_t numBytes)
+{
+	return Detail::chunkCount<kSysEx8BytesPerPacket> (numBytes) * 4;
+}
+
+//------------------------------------------------------------------------
+/** encodes 7-bit system exclusive data as 64-bit data messages (message type 0x3)
+ *
+ *	@param group		UMP group
+ *	@param data			the payload without the 0xF0 and 0xF7 framing bytes
+ *	@param numBytes		number of bytes of data
+ *	@param words		destination
+ *	@param capacity		number of words available at destination
+ *	@return				number of words written, 0 if the message does not fit
+ */
+constexpr size_t encodeSysEx7 (uint8_t group, const uint8_t* data, size_t numBytes,
+                               uint32_t* words, size_t capacity)
+{
+	const auto numPackets = Detail::chunkCount<kSysEx7BytesPerPacket> (numBytes);
+	if (capacity < numPackets * 2)
+		return 0;
+	for (size_t packet = 0; packet < numPackets; ++packet)
+	{
+		const auto offset = packet * kSysEx7BytesPerPacket;
+		const auto count = std::min (numBytes - offset, kSysEx7BytesPerPacket);
+		uint8_t bytes[8] = {};
+		bytes[0] = static_cast<uint8_t> ((static_cast<uint8_t> (Detail::MessageType::SysEx) << 4) |
+		                                 (group & 0xf));
+		bytes[1] = static_cast<uint8_t> ((Detail::chunkStatus (packet, numPackets) << 4) | count);
+		for (size_t i = 0; i < count; ++i)
+			bytes[2 + i] = data[offset + i] & 0x7f;
+		words[packet * 2] = Detail::packWord (bytes);
+		words[packet * 2 + 1] = Detail::packWord (bytes + 4);
+	}
+	return numPackets * 2;
+}
+
+//------------------------------------------------------------------------
+/** encodes 8-bit system exclusive data as 128-bit data messages (message type 0x5)
+ *
+ *	@param group		UMP group
+ *	@param streamID		the stream ID to interleave several messages
+ *	@param data			the payload
+ *	@param numBytes		number of bytes of data
+ *	@param words		destination
+ *	@param capacity		number of words available at destination
+ *	@return				number of words written, 0 if the message does not fit
+ */
+constexpr size_t encodeSysEx8 (uint8_t group, uint8_t streamID, const uint8_t* data,
+                               size_t numBytes, uint32_t* words, size_t capacity)
+{
+	const auto numPackets = Detail::chunkCount<kSysEx8BytesPerPacket> (numBytes);
+	if (capacity < numPackets * 4)
+		return 0;
+	for (size_t packet = 0; packet < numPackets; ++packet)
+	{
+		const auto offset = packet * kSysEx8BytesPerPacket;
+		const auto count = std::min (numBytes - offset, kSysEx8BytesPerPacket);
+		uint8_t bytes[16] = {};
+		bytes[0] = static_cast<uint8_t> (
+		    (static_cast<uint8_t> (Detail::MessageType::Data128) << 4) | (group & 0xf));
+		// the number of bytes includes the stream ID
+		bytes[1] =
+		    static_cast<uint8_t> ((Detail::chunkStatus (packet, numPackets) << 4) | (count + 1));
+		bytes[2] = streamID;
+		for (size_t i = 0; i < count; ++i)
+			bytes[3 + i] = data[offset + i];
+		for (size_t i = 0; i < 4; ++i)
+			words[packet * 4 + i] = Detail::packWord (bytes + i * 4);
+	}
+	return numPackets * 4;
+}
+
+//------------------------------------------------------------------------
+/** Encodes VST 3 events to MIDI 2.0 channel voice messages.
+ *
+ *	The encoder does not allocate or lock, so it can be used on the audio thread.
+ *
+ *	- note on/off and poly pressure become the MIDI 2.0 messages. A note on tuning is sent as
+ *	  pitch 7.9 attribute.
+ *	- note expression value events become per-note pitch bend (tuning), registered per-note
+ *	  controllers (volume 7, pan 10, expression 11, brightness 74) or assignable per-note
+ *	  controllers (kCustomStart + index). The encoder remembers the channel and pitch of the
+ *	  note IDs of the note on events it encoded until their note off.
+ *	- legacy MIDI CC out events become control change, channel pressure, pitch bend, program
+ *	  change or poly pressure messages.
+ *	- MIDI system exclusive data events become 7-bit or 8-bit system exclusive messages.
+ *
+ *	This is the reverse of UMPEventBridge.
+ */
+class EventEncoder
+{
+public:
+	enum class SysExFormat
+	{
+		SevenBit,
+		EightBit,
+	};
+
+	struct Result
+	{
+		/** number of words written */
+		size_t numWords {0};
+		/** number of events consumed */
+		int32 numEvents {0};
+	};
+
+	EventEncoder () { reset (); }
+
+	void setGroup (uint8_t g) { group = g & 0xf; }
+	/** range in semitones of per-note pitch bend (default 48 like MPE) */
+	void setPerNotePitchBendRange (double semitones) { perNotePitchBendRange = semitones; }
+	/** format of MIDI system exclusive data events */
+	void setSysExFormat (SysExFormat format, uint8_t streamID = 0)
+	{
+		sysExFormat = format;
+		sysExStreamID = streamID;
+	}
+
+	/** forgets all playing notes */
+	void reset ()
+	{
+		for (auto& note : notes)
+			note.noteId = -1;
+		numNotes = 0;
+	}
+
+	/** number of words needed to encode the event, 0 if it is not encodable */
+	size_t wordCount (const Event& e) const
+	{
+		switch (e.type)
+		{
+			case Event::kNoteOnEvent:
+			case Event::kNoteOffEvent:
+			case Event::kPolyPressureEvent:
+			case Event::kNoteExpressionValueEvent:
+			case Event::kLegacyMIDICCOutEvent: return 2;
+			case Event::kDataEvent:
+			{
+				if (e.data.type != DataEvent::kMidiSysEx)
+					return 0;
+				auto payload = sysExPayload (e.data);
+				return sysExFormat == SysExFormat::SevenBit ? sysEx7WordCount (payload.second) :
+				                                              sysEx8WordCount (payload.second);
+			}
+		}
+		return 0;
+	}
+
+	/** encodes one event
+	 *	@return number of words written, 0 if the event is not encodable or does not fit
+	 */
+	size_t encode (const Event& e, uint32_t* words, size_t capacity)
+	{
+		switch (e.type)
+		{
+			case Event::kNoteOnEvent:
+			{
+				const auto& noteOn = e.noteOn;
+				auto note = static_cast<uint8_t> (noteOn.pitch & 0x7f);
+				auto channel = static_cast<uint8_t> (noteOn.channel & 0xf);
+				auto packet = noteOn.tuning == 0.f ?
+				                  makeNoteOn (group, channel, note, toVelocity16 (noteOn.velocity)) :
+				                  makeNoteOn (group, channel, note, toVelocity16 (noteOn.velocity),
+				                              kPitch7_9Attribute, toPitch7_9 (note, noteOn.tuning));
+				auto numWords = Detail::writePacket (packet, words, capacity);
+				if (numWords)
+					addNote (noteOn.noteId, channel, note);
+				return numWords;
+			}
+			case Event::kNoteOffEvent:
+			{
+				const auto& noteOff = e.noteOff;
+				auto note = static_cast<uint8_t> (noteOff.pitch & 0x7f);
+				auto channel = static_cast<uint8_t> (noteOff.channel & 0xf);
+				auto velocity = toVelocity16 (noteOff.velocity);
+				auto packet = noteOff.tuning == 0.f ?
+				                  makeNoteOff (group, channel, note, velocity) :
+				                  makeNoteOff (group, channel, note, velocity, kPitch7_9Attribute,
+				                               toPitch7_9 (note, noteOff.tuning));
+				auto numWords = Detail::writePacket (packet, words, capacity);
+				if (numWords)
+					removeNote (noteOff.noteId);
+				return numWords;
+			}
+			case Event::kPolyPressureEvent:
+			{
+				const auto& pressure = e.polyPressure;
+				return Detail::writePacket (
+				    makePolyPressure (group, pressure.channel & 0xf, pressure.pitch & 0x7f,
+				                      toData32 (pressure.pressure)),
+				    words, capacity);
+			}
+			case Event::kNoteExpressionValueEvent:
+				return encodeNoteExpression (e.noteExpressionValue, words, capacity);
+			case Event::kLegacyMIDICCOutEvent:
+				return encodeLegacyMIDICCOut (e.midiCCOut, words, capacity);
+			case Event::kDataEvent:
+			{
+				if (e.data.type != DataEvent::kMidiSysEx)
+					return 0;
+				auto payload = sysExPayload (e.data);
+				if (sysExFormat == SysExFormat::SevenBit)
+					return encodeSysEx7 (group, payload.first, payload.second, words, capacity);
+				return encodeSysEx8 (group, sysExStreamID, payload.first, payload.second, words,
+				                     capacity);
+			}
+		}
+		return 0;
+	}
+
+	/** encodes the events of the list beginning at startIndex until the words are full
+	 *
+	 *	events which are not encodable are skipped. If result.numEvents is smaller than the number
+	 *	of remaining events, call again with a new buffer and startIndex + result.numEvents.
+	 */
+	template <typename EventListT>
+	Result encode (EventListT& events, int32 startIndex, uint32_t* words, size_t capacity)
+	{
+		Result result;
+		auto numEvents = events.getEventCount ();
+		for (auto index = startIndex; index < numEvents; ++index)
+		{
+			Event e;
+			if (events.getEvent (index, e) == kResultTrue)
+			{
+				if (wordCount (e) > capacity - result.numWords)
+					break;
+				result.numWords +=
+				    encode (e, words + result.numWords, capacity - result.numWords);
+			}
+			++result.numEvents;
+		}
+		return result;
+	}
+
+//------------------------------------------------------------------------
+private:
+	static constexpr double kTuningRange = 240.;
+	static constexpr size_t kNoteTableSize = 256;
+	static constexpr size_t kNoteTableMask = kNoteTableSize - 1;
+
+	struct Note
+	{
+		int32 noteId;
+		uint8_t channel;
+		uint8_t pitch;
+	};
+
+	static std::pair<const uint8_t*, size_t> sysExPayload (const DataEvent& data)
+	{
+		const uint8_t* bytes = data.bytes;
+		size_t size = data.size;
+		if (size > 0 && bytes[0] == 0xf0)
+		{
+			++bytes;
+			--size;
+		}
+		if (size > 0 && bytes[size - 1] == 0xf7)
+			--size;
+		return {bytes, size};
+	}
+
+	size_t encodeNoteExpression (const NoteExpressionValueEvent& e, uint32_t* words,
+	                             size_t capacity) const
+	{
+		auto note = findNote (e.noteId);
+		if (!note)
+			return 0;
+		uint8_t registered = 0;
+		switch (e.typeId)
+		{
+			case kTuningTypeID:
+			{
+				auto bend = (e.value - 0.5) * kTuningRange / perNotePitchBendRange;
+				bend = std::clamp (bend, -1., 1.);
+				auto data = std::min (2147483648. + bend * 2147483648., 4294967295.);
+				return Detail::writePacket (makePerNotePitchBend (group, note->channel, note->pitch,
+				                                                  static_cast<uint32_t> (data)),
+				                            words, capacity);
+			}
+			case kVolumeTypeID: registered = 7; break;
+			case kPanTypeID: registered = 10; break;
+			case kExpressionTypeID: registered = 11; break;
+			case kBrightnessTypeID: registered = 74; break;
+			default:
+			{
+				auto index = static_cast<uint32> (e.typeId) - static_cast<uint32> (kCustomStart);
+				if (index > 0xff)
+					return 0;
+				return Detail::writePacket (
+				    makeAssignablePerNoteController (group, note->channel, note->pitch,
+				                                     static_cast<uint8_t> (index),
+				                                     toData32 (e.value)),
+				    words, capacity);
+			}
+		}
+		return Detail::writePacket (makeRegisteredPerNoteController (group, note->channel,
+		                                                             note->pitch, registered,
+		                                                             toData32 (e.value)),
+		                            words, capacity);
+	}
+
+	size_t encodeLegacyMIDICCOut (const LegacyMIDICCOutEvent& e, uint32_t* words,
+	                              size_t capacity) const
+	{
+		auto channel = static_cast<uint8_t> (e.channel & 0xf);
+		auto value = static_cast<uint8_t> (e.value & 0x7f);
+		auto value2 = static_cast<uint8_t> (e.value2 & 0x7f);
+		switch (e.controlNumber)
+		{
+			case kAfterTouch:
+				return Detail::writePacket (
+				    makeChannelPressure (group, channel, scaleUp (value, 7, 32)), words, capacity);
+			case kPitchBend:
+				return Detail::writePacket (
+				    makePitchBend (group, channel, scaleUp ((value2 << 7) | value, 14, 32)), words,
+				    capacity);
+			case kCtrlProgramChange:
+				return Detail::writePacket (makeProgramChange (group, channel, value), words,
+				                            capacity);
+			case kCtrlPolyPressure:
+				return Detail::writePacket (
+				    makePolyPressure (group, channel, value, scaleUp (value2, 7, 32)), words,
+				    capacity);
+		}
+		if (e.controlNumber >= 128)
+			return 0;
+		return Detail::writePacket (
+		    makeControlChange (group, channel, e.controlNumber, scaleUp (value, 7, 32)), words,
+		    capacity);
+	}
+
+	static size_t hash (int32 noteId)
+	{
+		return (static_cast<uint32> (noteId) * 2654435761u) >> 24;
+	}
+
+	void addNote (int32 noteId, uint8_t channel, uint8_t pitch)
+	{
+		if (noteId == -1)
+			return;
+		auto index = hash (noteId);
+		while (notes[index].noteId != -1 && notes[index].noteId != noteId)
+			index = (index + 1) & kNoteTableMask;
+		if (notes[index].noteId == -1)
+		{
+			// keep one slot free so that the probing terminates
+			if (numNotes == kNoteTableSize - 1)
+				return;
+			++numNotes;
+		}
+		notes[index] = {noteId, channel, pitch};
+	}
+
+	const Note* findNote (int32 noteId) const
+	{
+		if (noteId == -1)
+			return nullptr;
+		auto index = hash (noteId);
+		while (notes[index].noteId != -1)
+		{
+			if (notes[index].noteId == noteId)
+				return &notes[index];
+			index = (index + 1) & kNoteTableMask;
+		}
+		return nullptr;
+	}
+
+	void removeNote (int32 noteId)
+	{
+		auto note = findNote (noteId);
+		if (!note)
+			return;
+		// backward shift deletion keeps the probe sequences intact without tombstones
+		auto hole = static_cast<size_t> (note - notes.data ());
+		auto index = hole;
+		while (true)
+		{
+			index = (index + 1) & kNoteTableMask;
+			if (notes[index].noteId == -1)
+				break;
+			auto home = hash (notes[index].noteId);
+			auto distanceHome = (index - home) & kNoteTableMask;
+			auto distanceHole = (index - hole) & kNoteTableMask;
+			if (distanceHome >= distanceHole)
+			{
+				notes[hole] = notes[index];
+				hole = index;
+			}
+		}
+		notes[hole].noteId = -1;
+		--numNotes;
+	}
+
+	std::array<Note, kNoteTableSize> notes;
+	size_t numNotes {0};
+	double perNotePitchBendRange {48.};
+	SysExFormat sysExFormat {SysExFormat::SevenBit};
+	uint8_t sysExStreamID {0};
+	uint8_t group {0};
+};
+
+//------------------------------------------------------------------------
+/** Encodes parameter changes to the MIDI controllers the plug-in assigned via IMidiMapping.
+ *
+ *	This is the reverse of the MIDI controller mapping of a host: a change of a parameter is sent
+ *	as control change, channel pressure, pitch bend or program change message on every channel the
+ *	parameter is assigned to. Only updateMapping allocates.
+ */
+class ControllerEncoder
+{
+public:
+	/** reads the MIDI controller assignments of the plug-in (not realtime safe) */
+	void updateMapping (IMidiMapping* midiMapping, int32 busIndex = 0)
+	{
+		assignments.clear ();
+		if (!midiMapping)
+			return;
+		for (int16 channel = 0; channel < 16; ++channel)
+		{
+			for (int32 ctrl = 0; ctrl <= kCtrlProgramChange; ++ctrl)
+			{
+				ParamID id;
+				if (midiMapping->getMidiControllerAssignment (
+				        busIndex, channel, static_cast<CtrlNumber> (ctrl), id) == kResultTrue)
+					assignments.push_back ({id, static_cast<uint8_t> (channel),
+					                        static_cast<CtrlNumber> (ctrl)});
+			}
+		}
+		std::stable_sort (assignments.begin (), assignments.end (),
+		                  [] (const auto& a, const auto& b) { return a.id < b.id; });
+	}
+
+	void setGroup (uint8_t g) { group = g & 0xf; }
+
+	/** number of words needed to encode a change of the parameter */
+	size_t wordCount (ParamID id) const
+	{
+		auto range = findAssignments (id);
+		return static_cast<size_t> (range.second - range.first) * 2;
+	}
+
+	/** encodes a change of the parameter for every assigned controller
+	 *	@return number of words written, 0 if the parameter is not assigned or does not fit
+	 */
+	size_t encode (ParamID id, ParamValue value, uint32_t* words, size_t capacity) const
+	{
+		auto range = findAssignments (id);
+		if (static_cast<size_t> (range.second - range.first) * 2 > capacity)
+			return 0;
+		size_t numWords = 0;
+		for (auto it = range.first; it != range.second; ++it)
+			numWords += Detail::writePacket (makePacket (*it, value), words + numWords, 2);
+		return numWords;
+	}
+
+	/** encodes all points of all queues, the messages of a queue are consecutive
+	 *	@return number of words written, stops at the first change which does not fit
+	 */
+	size_t encode (IParameterChanges& changes, uint32_t* words, size_t capacity) const
+	{
+		size_t numWords = 0;
+		auto numQueues = changes.getParameterCount ();
+		for (int32 queueIndex = 0; queueIndex < numQueues; ++queueIndex)
+		{
+			auto queue = changes.getParameterData (queueIndex);
+			if (!queue)
+				continue;
+			auto id = queue->getParameterId ();
+			auto needed = wordCount (id);
+			if (needed == 0)
+				continue;
+			auto numPoints = queue->getPointCount ();
+			for (int32 pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+			{
+				int32 sampleOffset;
+				ParamValue value;
+				if (queue->getPoint (pointIndex, sampleOffset, value) != kResultTrue)
+					continue;
+				if (needed > capacity - numWords)
+					return numWords;
+				numWords += encode (id, value, words + numWords, capacity - numWords);
+			}
+		}
+		return numWords;
+	}
+
+//------------------------------------------------------------------------
+private:
+	struct Assignment
+	{
+		ParamID id;
+		uint8_t channel;
+		CtrlNumber controller;
+	};
+	using Iterator = std::vector<Assignment>::const_iterator;
+
+	std::pair<Iterator, Iterator> findAssignments (ParamID id) const
+	{
+		return std::equal_range (
+		    assignments.begin (), assignments.end (), Assignment {id, 0, 0},
+		    [] (const Assignment& a, const Assignment& b) { return a.id < b.id; });
+	}
+
+	Packet64 makePacket (const Assignment& a, ParamValue value) const
+	{
+		switch (a.controller)
+		{
+			case kAfterTouch: return makeChannelPressure (group, a.channel, toData32 (value));
+			case kPitchBend: return makePitchBend (group, a.channel, toData32 (value));
+			case kCtrlProgramChange:
+			{
+				auto program = std::clamp (value, 0., 1.) * 127. + 0.5;
+				return makeProgramChange (group, a.channel, static_cast<uint8_t> (program));
+			}
+		}
+		return makeControlChange (group, a.channel, static_cast<uint8_t> (a.controller),
+		                          toData32 (value));
+	}
+
+	std::vector<Assignment> assignments;
+	uint8_t group {0};
+};
+
+//------------------------------------------------------------------------
+} // Steinberg::Vst::UMP
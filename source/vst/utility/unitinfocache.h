@@ -0,0 +1,145 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/utility/unitinfocache.h
+// Created by  : Steinberg, 10/2026
+// Description : Cache of the units of an IUnitInfo and their paths
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//   * Neither the name of the Steinberg Media Technologies nor the names of its
+//     contributors may be used to endorse or promote products derived from this
+//     software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+// OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "pluginterfaces/base/fstrdefs.h"
+#include "pluginterfaces/vst/ivstunits.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** Cache of the units of an IUnitInfo
+ *
+ *	Reads every UnitInfo once and resolves the path of each unit from the root unit (e.g.
+ *	"Modulators.LFO 1.", the separator is a "."). Call update again when the plug-in restarts
+ *	with a flag which may change its units.
+ */
+class UnitInfoCache
+{
+public:
+	using Path = std::basic_string<TChar>;
+
+	void update (IUnitInfo* unitInfo)
+	{
+		units.clear ();
+		paths.clear ();
+		indexMap.clear ();
+		if (!unitInfo)
+			return;
+
+		auto unitCount = unitInfo->getUnitCount ();
+		units.reserve (unitCount);
+		for (int32 unitIndex = 0; unitIndex < unitCount; ++unitIndex)
+		{
+			UnitInfo info = {};
+			if (unitInfo->getUnitInfo (unitIndex, info) == kResultTrue)
+			{
+				indexMap.emplace (info.id, static_cast<int32> (units.size ()));
+				units.push_back (info);
+			}
+		}
+		resolvePaths ();
+	}
+
+	/** Returns the info of the unit or nullptr. */
+	const UnitInfo* find (UnitID unitID) const
+	{
+		auto iter = indexMap.find (unitID);
+		return iter != indexMap.end () ? &units[iter->second] : nullptr;
+	}
+
+	/** Returns the path of the unit or nullptr. */
+	const Path* getPath (UnitID unitID) const
+	{
+		auto iter = indexMap.find (unitID);
+		return iter != indexMap.end () ? &paths[iter->second] : nullptr;
+	}
+
+	size_t size () const { return units.size (); }
+
+//------------------------------------------------------------------------
+private:
+	void resolvePaths ()
+	{
+		// every unit is resolved once, after the chain of its unresolved parents
+		auto numUnits = units.size ();
+		paths.resize (numUnits);
+		std::vector<bool> resolved (numUnits, false);
+		std::vector<int32> chain;
+		for (size_t i = 0; i < numUnits; ++i)
+		{
+			chain.clear ();
+			auto index = static_cast<int32> (i);
+			// a parent cycle ends the chain after visiting all units
+			while (index >= 0 && !resolved[index] && chain.size () <= numUnits)
+			{
+				chain.push_back (index);
+				const auto& info = units[index];
+				index = -1;
+				if (info.parentUnitId != kRootUnitId)
+				{
+					auto parent = indexMap.find (info.parentUnitId);
+					if (parent != indexMap.end ())
+						index = parent->second;
+				}
+			}
+			Path path;
+			if (index >= 0 && resolved[index])
+				path = paths[index];
+			for (auto it = chain.rbegin (); it != chain.rend (); ++it)
+			{
+				path += units[*it].name;
+				path += STR16 (".");
+				paths[*it] = path;
+				resolved[*it] = true;
+			}
+		}
+	}
+
+	std::vector<UnitInfo> units;
+	std::vector<Path> paths; // parallel to units
+	std::unordered_map<UnitID, int32> indexMap;
+};
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
@@ -36,6 +36,8 @@
 
 #include "vstaudioeffect.h"
 
+#include <cstring>
+
 namespace Steinberg {
 namespace Vst {
 
@@ -56,6 +58,7 @@ AudioBus* AudioEffect::addAudioInput (const TChar* name, SpeakerArrangement arr,
 {
 	auto* newBus = new AudioBus (name, busType, flags, arr);
 	audioInputs.push_back (IPtr<Vst::Bus> (newBus, false));
+	updateBusLayout ();
 	return newBus;
 }
 
@@ -65,6 +68,7 @@ AudioBus* AudioEffect::addAudioOutput (const TChar* name, SpeakerArrangement arr
 {
 	auto* newBus = new AudioBus (name, busType, flags, arr);
 	audioOutputs.push_back (IPtr<Vst::Bus> (newBus, false));
+	updateBusLayout ();
 	return newBus;
 }
 
@@ -92,6 +96,7 @@ EventBus* AudioEffect::addEventInput (const TChar* name, int32 channels, BusType
 {
 	auto* newBus = new EventBus (name, busType, flags, channels);
 	eventInputs.push_back (IPtr<Vst::Bus> (newBus, false));
+	updateBusLayout ();
 	return newBus;
 }
 
@@ -101,6 +106,7 @@ EventBus* AudioEffect::addEventOutput (const TChar* name, int32 channels, BusTyp
 {
 	auto* newBus = new EventBus (name, busType, flags, channels);
 	eventOutputs.push_back (IPtr<Vst::Bus> (newBus, false));
+	updateBusLayout ();
 	return newBus;
 }
 
@@ -146,6 +152,7 @@ tresult PLUGIN_API AudioEffect::setBusArrangements (SpeakerArrangement* inputs,
 			break;
 		FCast<Vst::AudioBus> (audioOutputs[index].get ())->setArrangement (outputs[index]);
 	}
+	updateBusLayout ();
 
 	return kResultTrue;
 }
@@ -176,13 +183,22 @@ tresult PLUGIN_API AudioEffect::setupProcessing (ProcessSetup& newSetup)
 		return kResultFalse;
 
 	processSetup.symbolicSampleSize = newSetup.symbolicSampleSize;
+	silentInputSamples = 0;
 
 	return kResultOk;
 }
 
+//------------------------------------------------------------------------
+tresult PLUGIN_API AudioEffect::setActive (TBool state)
+{
+	silentInputSamples = 0;
+	return Component::setActive (state);
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API AudioEffect::setProcessing (TBool /*state*/)
 {
+	silentInputSamples = 0;
 	return kNotImplemented;
 }
 
@@ -198,6 +214,133 @@ tresult PLUGIN_API AudioEffect::process (ProcessData& /*data*/)
 	return kNotImplemented;
 }
 
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+/** Compares the magnitudes as integers (for IEEE floats the order of the bits without sign is the
+ *  order of the magnitudes), which the compiler can vectorize without fast-math. */
+template <typename SampleT, typename BitsT>
+bool isBelow (const SampleT* buffer, int32 numSamples, BitsT threshold)
+{
+	constexpr BitsT kMagnitudeMask = ~(BitsT (1) << (sizeof (BitsT) * 8 - 1));
+	BitsT peak = 0;
+	for (int32 i = 0; i < numSamples; ++i)
+	{
+		BitsT bits;
+		memcpy (&bits, &buffer[i], sizeof (BitsT));
+		bits &= kMagnitudeMask;
+		peak = bits > peak ? bits : peak;
+	}
+	return peak <= threshold;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+bool AudioEffect::isSilent (const Sample32* buffer, int32 numSamples) const
+{
+	return !buffer || isBelow (buffer, numSamples, silenceThreshold32);
+}
+
+//------------------------------------------------------------------------
+bool AudioEffect::isSilent (const Sample64* buffer, int32 numSamples) const
+{
+	return !buffer || isBelow (buffer, numSamples, silenceThreshold64);
+}
+
+//------------------------------------------------------------------------
+void AudioEffect::setSilenceThreshold (Sample64 threshold)
+{
+	auto threshold32 = static_cast<Sample32> (threshold < 0. ? -threshold : threshold);
+	auto threshold64 = threshold < 0. ? -threshold : threshold;
+	memcpy (&silenceThreshold32, &threshold32, sizeof (silenceThreshold32));
+	memcpy (&silenceThreshold64, &threshold64, sizeof (silenceThreshold64));
+}
+
+//------------------------------------------------------------------------
+bool AudioEffect::skipSilentBlock (ProcessData& data)
+{
+	if (data.numSamples <= 0)
+		return false;
+
+	// without audio inputs (e.g. an instrument) a block without events says nothing about the
+	// output, a held note sounds on
+	bool hasAudioInput = false;
+	bool silent = !(data.inputEvents && data.inputEvents->getEventCount () > 0);
+	for (int32 bus = 0; silent && bus < data.numInputs; ++bus)
+	{
+		const AudioBusBuffers& input = data.inputs[bus];
+		if (!input.channelBuffers32)
+			continue;
+		for (int32 channel = 0; silent && channel < input.numChannels; ++channel)
+		{
+			hasAudioInput = true;
+			if (channel < 64 && (input.silenceFlags & (1ull << channel)) != 0)
+				continue;
+			if (data.symbolicSampleSize == kSample32)
+				silent = isSilent (input.channelBuffers32[channel], data.numSamples);
+			else
+				silent = isSilent (input.channelBuffers64[channel], data.numSamples);
+		}
+	}
+	if (!silent || !hasAudioInput)
+	{
+		silentInputSamples = 0;
+		return false;
+	}
+
+	// the output of the block is silent if the input was silent for the tail and the block
+	uint32 tailSamples = getTailSamples ();
+	if (tailSamples == kInfiniteTail)
+		return false;
+	int64 requiredSamples = static_cast<int64> (tailSamples) + data.numSamples;
+	if (silentInputSamples < requiredSamples)
+		silentInputSamples += data.numSamples;
+	if (silentInputSamples < requiredSamples)
+		return false;
+
+	for (int32 bus = 0; bus < data.numOutputs; ++bus)
+	{
+		AudioBusBuffers& output = data.outputs[bus];
+		for (int32 channel = 0; output.channelBuffers32 && channel < output.numChannels; ++channel)
+		{
+			if (data.symbolicSampleSize == kSample32)
+			{
+				if (output.channelBuffers32[channel])
+					memset (output.channelBuffers32[channel], 0,
+					        data.numSamples * sizeof (Sample32));
+			}
+			else if (output.channelBuffers64[channel])
+				memset (output.channelBuffers64[channel], 0, data.numSamples * sizeof (Sample64));
+		}
+		output.silenceFlags = output.numChannels < 64 ? (1ull << output.numChannels) - 1 : ~0ull;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+void AudioEffect::updateOutputSilenceFlags (ProcessData& data) const
+{
+	for (int32 bus = 0; bus < data.numOutputs; ++bus)
+	{
+		AudioBusBuffers& output = data.outputs[bus];
+		output.silenceFlags = 0;
+		if (!output.channelBuffers32)
+			continue;
+		int32 numChannels = output.numChannels < 64 ? output.numChannels : 64;
+		for (int32 channel = 0; channel < numChannels; ++channel)
+		{
+			bool silent = data.symbolicSampleSize == kSample32 ?
+			                  isSilent (output.channelBuffers32[channel], data.numSamples) :
+			                  isSilent (output.channelBuffers64[channel], data.numSamples);
+			if (silent)
+				output.silenceFlags |= 1ull << channel;
+		}
+	}
+}
+
 //------------------------------------------------------------------------
 uint32 PLUGIN_API AudioEffect::getProcessContextRequirements ()
 {
@@ -90,6 +90,9 @@ public:
 	/** Retrieves an Event Output Bus by index. */
 	EventBus* getEventOutput (int32 index);
 
+	//---from IComponent-----------
+	tresult PLUGIN_API setActive (TBool state) SMTG_OVERRIDE;
+
 	//---from IAudioProcessor-------
 	tresult PLUGIN_API setBusArrangements (SpeakerArrangement* inputs, int32 numIns,
 	                                       SpeakerArrangement* outputs,
@@ -115,8 +118,30 @@ public:
 	REFCOUNT_METHODS (Component)
 //------------------------------------------------------------------------
 protected:
+	/** Opt-in silence handling, call it in process () after the parameter changes and before the
+	 *  audio processing. Returns true if all audio inputs are silent, there are no input events and
+	 *  the tail reported by getTailSamples () has elapsed. In this case all outputs are cleared and
+	 *  flagged silent, and the audio processing of the block can be skipped. Blocks without audio
+	 *  inputs (e.g. of an instrument) are never skipped. Overrides of setActive () and
+	 *  setProcessing () have to call the base class to reset the silence counter. */
+	bool skipSilentBlock (ProcessData& data);
+
+	/** Sets the silence flags of all audio outputs from the content of their buffers. */
+	void updateOutputSilenceFlags (ProcessData& data) const;
+
+	/** Sets the level up to which samples count as silent (default 0: only exact zeros). */
+	void setSilenceThreshold (Sample64 threshold);
+
+	/** Returns true if no sample of buffer exceeds the threshold of setSilenceThreshold (). */
+	bool isSilent (const Sample32* buffer, int32 numSamples) const;
+	bool isSilent (const Sample64* buffer, int32 numSamples) const;
+
 	ProcessSetup processSetup;
 	ProcessContextRequirements processContextRequirements;
+
+	int64 silentInputSamples {0}; ///< samples since the last non-silent input
+	uint32 silenceThreshold32 {0}; ///< threshold as float bits without sign
+	uint64 silenceThreshold64 {0}; ///< threshold as double bits without sign
 };
 
 //------------------------------------------------------------------------
@@ -94,6 +94,101 @@ BusList::BusList (MediaType type, BusDirection dir) : type (type), direction (di
 {
 }
 
+//------------------------------------------------------------------------
+// BusLayout Implementation
+//------------------------------------------------------------------------
+void BusLayout::BusStates::assign (BusList& busList)
+{
+	active.clear ();
+	channelCount.clear ();
+	arrangement.clear ();
+	for (auto& bus : busList)
+	{
+		BusInfo info {};
+		bus->getInfo (info);
+		active.push_back (bus->isActive () ? 1 : 0);
+		channelCount.push_back (info.channelCount);
+		if (auto* audioBus = FCast<AudioBus> (bus.get ()))
+			arrangement.push_back (audioBus->getArrangement ());
+	}
+}
+
+//------------------------------------------------------------------------
+const BusLayout::BusStates* BusLayout::getBusStates (MediaType type, BusDirection dir) const
+{
+	if (type == kAudio)
+		return dir == kInput ? &audioInputs : &audioOutputs;
+	if (type == kEvent)
+		return dir == kInput ? &eventInputs : &eventOutputs;
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+// BusLayoutTransfer Implementation
+//------------------------------------------------------------------------
+BusLayoutTransfer::BusLayoutTransfer ()
+{
+	current.store (new BusLayout);
+}
+
+//------------------------------------------------------------------------
+BusLayoutTransfer::~BusLayoutTransfer ()
+{
+	for (auto* layout : retired)
+		delete layout;
+	delete current.load ();
+}
+
+//------------------------------------------------------------------------
+void BusLayoutTransfer::publish_ui (std::unique_ptr<BusLayout>&& layout)
+{
+	if (!layout)
+		return;
+	std::lock_guard<std::mutex> guard (publishMutex);
+	retired.push_back (current.exchange (layout.release ()));
+	deleteRetired ();
+}
+
+//------------------------------------------------------------------------
+const BusLayout* BusLayoutTransfer::access_rt () noexcept
+{
+	// announce the layout before using it, publish_ui does not delete an announced layout. If the
+	// layout was replaced in between, announce the new one.
+	BusLayout* layout = current.load ();
+	while (true)
+	{
+		inUse.store (layout);
+		BusLayout* latest = current.load ();
+		if (latest == layout)
+			return layout;
+		layout = latest;
+	}
+}
+
+//------------------------------------------------------------------------
+void BusLayoutTransfer::clearRetired_ui ()
+{
+	std::lock_guard<std::mutex> guard (publishMutex);
+	deleteRetired ();
+}
+
+//------------------------------------------------------------------------
+void BusLayoutTransfer::deleteRetired ()
+{
+	BusLayout* used = inUse.load ();
+	auto it = retired.begin ();
+	while (it != retired.end ())
+	{
+		if (*it == used)
+		{
+			++it;
+			continue;
+		}
+		delete *it;
+		it = retired.erase (it);
+	}
+}
+
 //------------------------------------------------------------------------
 } // namespace Vst
 } // namespace Steinberg
@@ -40,6 +40,9 @@
 #include "pluginterfaces/vst/ivstcomponent.h"
 #include "pluginterfaces/vst/ivstaudioprocessor.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #if defined(SMTG_CPP_17) && SMTG_CPP_17
 #include <string_view>
@@ -167,6 +170,76 @@ protected:
 	BusDirection direction;
 };
 
+//------------------------------------------------------------------------
+/** Immutable snapshot of the state of all busses of a component.
+\ingroup vstClasses
+The state is stored in flat arrays, one entry per bus, so that the realtime thread can read it
+without virtual calls. See BusLayoutTransfer for passing it to the realtime thread.
+*/
+struct BusLayout
+{
+	/** States of the busses of one media type and direction. */
+	struct BusStates
+	{
+		std::vector<uint8> active;
+		std::vector<int32> channelCount;
+		/** speaker arrangements, only filled for audio busses */
+		std::vector<SpeakerArrangement> arrangement;
+
+		/** Returns the number of busses. */
+		int32 getCount () const { return static_cast<int32> (active.size ()); }
+		/** Returns true if the bus at index exists and is active. */
+		bool isActive (int32 index) const
+		{
+			return index >= 0 && index < getCount () && active[index] != 0;
+		}
+		/** Copies the states of all busses of the list. */
+		void assign (BusList& busList);
+	};
+
+	BusStates audioInputs;
+	BusStates audioOutputs;
+	BusStates eventInputs;
+	BusStates eventOutputs;
+
+	/** Returns the states for the media type and direction, nullptr for unknown types. */
+	const BusStates* getBusStates (MediaType type, BusDirection dir) const;
+};
+
+//------------------------------------------------------------------------
+/** Publishes BusLayout snapshots from non realtime threads to the realtime thread.
+\ingroup vstClasses
+publish_ui replaces the current layout with one atomic pointer exchange. access_rt is lock free
+and allocation free and is meant to be called by one realtime thread, the returned layout stays
+valid until its next call. Replaced layouts are deleted by publish_ui and clearRetired_ui once the
+realtime thread does not use them anymore. So the layout the realtime thread used before the last
+publish_ui stays alive until the next of these calls after the realtime thread moved on.
+*/
+class BusLayoutTransfer
+{
+public:
+//------------------------------------------------------------------------
+	BusLayoutTransfer ();
+	~BusLayoutTransfer ();
+
+	/** Publishes a new layout. To be called from a non realtime thread. */
+	void publish_ui (std::unique_ptr<BusLayout>&& layout);
+	/** Returns the current layout, never nullptr. To be called from the realtime thread. */
+	const BusLayout* access_rt () noexcept;
+	/** Deletes the replaced layouts which the realtime thread does not use anymore. To be called
+	 *  from a non realtime thread. */
+	void clearRetired_ui ();
+
+//------------------------------------------------------------------------
+protected:
+	void deleteRetired ();
+
+	std::atomic<BusLayout*> current {nullptr};
+	std::atomic<BusLayout*> inUse {nullptr};
+	std::vector<BusLayout*> retired;
+	std::mutex publishMutex;
+};
+
 //------------------------------------------------------------------------
 } // namespace Vst
 } // namespace Steinberg
@@ -37,11 +37,15 @@
 #pragma once
 
 #include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/vstspeaker.h"
 #include "vstspeakerarray.h"
 
+#include <vector>
+
 namespace Steinberg {
 namespace Vst {
 
+// BypassProcessor supports any number of channels, kept for existing code
 #define kMaxChannelsSupported 64
 
 //------------------------------------------------------------------------
@@ -106,89 +110,31 @@ protected:
 	int32 mMaxSamples;
 };
 
-//------------------------------------------------------------------------
-template <typename T>
-static bool delay (int32 sampleFrames, T* inStream, T* outStream, T* delayBuffer, int32 bufferSize,
-                   int32 bufferInPos, int32 bufferOutPos)
-{
-	// delay inStream
-	int32 remain, inFrames, outFrames;
-	T* bufIn;
-	T* bufOut;
-
-	remain = sampleFrames;
-	while (remain > 0)
-	{
-		bufIn = delayBuffer + bufferInPos;
-		bufOut = delayBuffer + bufferOutPos;
-
-		if (bufferInPos > bufferOutPos)
-			inFrames = bufferSize - bufferInPos;
-		else
-			inFrames = bufferOutPos - bufferInPos;
-
-		outFrames = bufferSize - bufferOutPos;
-
-		if (inFrames > remain)
-			inFrames = remain;
-
-		if (outFrames > inFrames)
-			outFrames = inFrames;
-
-		// order important for in-place processing!
-		memcpy (bufIn, inStream, inFrames * sizeof (T)); // copy to buffer
-		memcpy (outStream, bufOut, outFrames * sizeof (T)); // copy from buffer
-
-		inStream += inFrames;
-		outStream += outFrames;
-
-		bufferInPos += inFrames;
-		if (bufferInPos >= bufferSize)
-			bufferInPos -= bufferSize;
-		bufferOutPos += outFrames;
-		if (bufferOutPos >= bufferSize)
-			bufferOutPos -= bufferSize;
-
-		if (inFrames > outFrames)
-		{
-			// still some output to copy
-			bufOut = delayBuffer + bufferOutPos;
-			outFrames = inFrames - outFrames;
-
-			memcpy (outStream, bufOut, outFrames * sizeof (T)); // copy from buffer
-
-			outStream += outFrames;
-
-			bufferOutPos += outFrames;
-			if (bufferOutPos >= bufferSize)
-				bufferOutPos -= bufferSize;
-		}
-
-		remain -= inFrames;
-	}
-
-	return true;
-}
-
 //------------------------------------------------------------------------
 // BypassProcessor
+/** Latency compensated bypass of the main input bus to the main output bus.
+ *
+ *	All channels share one contiguous delay line, the number of channels is not limited.
+ *
+ *	Without crossfade (crossfadeSamples == 0 in setup) call process () instead of the audio
+ *	processing while isActive () returns true.
+ *
+ *	With crossfade, call processDry () at the start of every block (before the audio is processed
+ *	in place) to keep the delay line in sync with the processed signal. While fully bypassed,
+ *	process () then copies the delayed signal to the outputs. While isCrossfading () returns true,
+ *	process the audio and call crossfade () afterwards.
+ */
 //------------------------------------------------------------------------
 template <typename T>
 class BypassProcessor
 {
 public:
 //------------------------------------------------------------------------
-	BypassProcessor ()
-	{
-		for (int32 i = 0; i < kMaxChannelsSupported; i++)
-		{
-			mInputPinLookup[i] = -1;
-			mDelays[i] = nullptr;
-		}
-	}
+	BypassProcessor () = default;
 	~BypassProcessor () { reset (); }
 
-	void setup (IAudioProcessor& audioProcessor, ProcessSetup& processSetup, int32 delaySamples)
+	void setup (IAudioProcessor& audioProcessor, ProcessSetup& processSetup, int32 delaySamples,
+	            int32 crossfadeSamples = 0)
 	{
 		reset ();
 
@@ -202,45 +148,45 @@ public:
 		if (!mMainIOBypass)
 			return;
 
-		// create lookup table (in <- out) and delays...
-		SpeakerArray inArray (inputArr);
-		SpeakerArray outArray (outputArr);
-
-		// security check (todo)
-		if (outArray.total () >= kMaxChannelsSupported)
-			return;
-
-		for (int32 i = 0; i < outArray.total (); i++)
+		// create lookup table (in <- out)
+		mNumChannels = SpeakerArr::getChannelCount (outputArr);
+		mInputPinLookup.assign (mNumChannels, -1);
+		for (int32 i = 0; i < mNumChannels; i++)
 		{
-			if (outArray.at (i) == Vst::kSpeakerL)
-			{
-				if (inArray.total () == 1 && inArray.at (0) == Vst::kSpeakerM)
-				{
-					mInputPinLookup[i] = 0;
-				}
-				else
-					mInputPinLookup[i] = inArray.getSpeakerIndex (outArray.at (i));
-			}
+			Speaker speaker = SpeakerArr::getSpeaker (outputArr, i);
+			if (speaker == Vst::kSpeakerL && inputArr == SpeakerArr::kMono)
+				mInputPinLookup[i] = 0;
 			else
-				mInputPinLookup[i] = inArray.getSpeakerIndex (outArray.at (i));
-
-			mDelays[i] = new Delay (processSetup.maxSamplesPerBlock, delaySamples);
-			mDelays[i]->flush ();
+				mInputPinLookup[i] = SpeakerArr::getSpeakerIndex (speaker, inputArr);
 		}
+
+		// each channel keeps the delay plus one block, so that a block can be written before the
+		// delayed signal is read
+		mMaxSamplesPerBlock = processSetup.maxSamplesPerBlock > 0 ? processSetup.maxSamplesPerBlock : 1;
+		mDelaySamples = delaySamples > 0 ? delaySamples : 0;
+		mBufferSamples = mDelaySamples > 0 ? mDelaySamples + mMaxSamplesPerBlock : 0;
+		mDelayLine.resize (mNumChannels * mBufferSamples);
+		mSilentSamples.assign (mNumChannels, 0);
+
+		mCrossfadeSamples = crossfadeSamples > 0 ? crossfadeSamples : 0;
+		if (mCrossfadeSamples > 0)
+			mDryBuffer.resize (mNumChannels * mMaxSamplesPerBlock);
+		mFadePosition = mActive ? mCrossfadeSamples : 0;
+
+		flush ();
 	}
+
 	void reset ()
 	{
 		mMainIOBypass = false;
-
-		for (int32 i = 0; i < kMaxChannelsSupported; i++)
-		{
-			mInputPinLookup[i] = -1;
-			if (mDelays[i])
-			{
-				delete mDelays[i];
-				mDelays[i] = nullptr;
-			}
-		}
+		mNumChannels = 0;
+		mDelaySamples = 0;
+		mBufferSamples = 0;
+		mCrossfadeSamples = 0;
+		mInputPinLookup.clear ();
+		mSilentSamples.clear ();
+		mDelayLine.release ();
+		mDryBuffer.release ();
 	}
 
 	bool isActive () const { return mActive; }
@@ -251,161 +197,264 @@ public:
 
 		mActive = state;
 
-		// flush delays when turning on
-		if (state && mMainIOBypass)
-			for (auto &delay : mDelays)
-			{
-				if (!delay)
-					break;
-				delay->flush ();
-			}
+		// flush delays when turning on, with crossfade the delay line is fed all the time
+		if (state && mMainIOBypass && mCrossfadeSamples == 0)
+			flush ();
 	}
 
-	void process (ProcessData& data)
+	/** true while the output is faded between the processed and the bypassed signal */
+	bool isCrossfading () const
 	{
-		// flush
-		if (data.numInputs == 0 || data.numOutputs == 0)
-			return;
-
-		AudioBusBuffers& inBus = data.inputs[0];
-		AudioBusBuffers& outBus = data.outputs[0];
+		return mCrossfadeSamples > 0 && mFadePosition != (mActive ? mCrossfadeSamples : 0);
+	}
 
-		if (data.symbolicSampleSize == kSample32)
-		{
-			if (!outBus.channelBuffers32)
-				return;
-		}
-		else if (!outBus.channelBuffers64)
+	/** Writes the delayed main input to the main output and clears all other outputs. */
+	void process (ProcessData& data)
+	{
+		if (!checkBuffers (data))
 			return;
 
 		if (mMainIOBypass)
 		{
-			for (int32 channel = 0; channel < outBus.numChannels; channel++)
+			AudioBusBuffers& outBus = data.outputs[0];
+			int32 numChannels = outBus.numChannels < mNumChannels ? outBus.numChannels :
+			                                                        mNumChannels;
+			if (mCrossfadeSamples > 0)
 			{
-				T* src = nullptr;
-				bool silent = true;
-				T* dst;
-				if (data.symbolicSampleSize == kSample32)
-					dst = (T*)outBus.channelBuffers32[channel];
-				else
-					dst = (T*)outBus.channelBuffers64[channel];
-				if (!dst)
-					continue;
-
-				int inputChannel = mInputPinLookup[channel];
-				if (inputChannel != -1)
-				{
-					silent = (inBus.silenceFlags & (1ll << inputChannel)) != 0;
-					if (data.symbolicSampleSize == kSample32)
-						src = (T*)inBus.channelBuffers32[inputChannel];
-					else
-						src = (T*)inBus.channelBuffers64[inputChannel];
-				}
-
-				if (mDelays[channel]->process (src, dst, data.numSamples, silent))
+				// the delay line was already fed by processDry ()
+				if (data.numSamples > mMaxSamplesPerBlock)
+					return;
+				for (int32 channel = 0; channel < numChannels; channel++)
 				{
-					outBus.silenceFlags |= (1ll << channel);
+					if (T* dst = getChannel (outBus, channel, data.symbolicSampleSize))
+					{
+						memcpy (dst, getDryChannel (channel), data.numSamples * sizeof (T));
+						setSilent (outBus, channel, isSilent (channel, data.numSamples));
+					}
 				}
-				else
+				mFadePosition = mActive ? mCrossfadeSamples : 0;
+			}
+			else
+			{
+				for (int32 channel = 0; channel < numChannels; channel++)
 				{
-					outBus.silenceFlags = 0;
+					if (T* dst = getChannel (outBus, channel, data.symbolicSampleSize))
+						setSilent (outBus, channel, delayChannel (data, channel, dst));
 				}
+				advance (data.numSamples);
 			}
 		}
 
-		// clear all other outputs
-		for (int32 outBusIndex = mMainIOBypass ? 1 : 0; outBusIndex < data.numOutputs;
-		     outBusIndex++)
-		{
-			outBus = data.outputs[outBusIndex];
+		clearOutputs (data, mMainIOBypass ? 1 : 0);
+	}
 
-			for (int32 channel = 0; channel < outBus.numChannels; channel++)
+	/** Feeds the main input into the delay line and keeps the delayed signal for crossfade (). */
+	void processDry (ProcessData& data)
+	{
+		if (!mMainIOBypass || mCrossfadeSamples == 0 || !checkBuffers (data) ||
+		    data.numSamples > mMaxSamplesPerBlock)
+			return;
+
+		for (int32 channel = 0; channel < mNumChannels; channel++)
+			delayChannel (data, channel, getDryChannel (channel));
+		advance (data.numSamples);
+	}
+
+	/** Fades the processed main output towards or away from the signal of processDry (). */
+	void crossfade (ProcessData& data)
+	{
+		if (!isCrossfading () || !mMainIOBypass || !checkBuffers (data) ||
+		    data.numSamples > mMaxSamplesPerBlock)
+			return;
+
+		int32 target = mActive ? mCrossfadeSamples : 0;
+		int32 direction = mActive ? 1 : -1;
+		int32 distance = mActive ? target - mFadePosition : mFadePosition - target;
+		int32 rampSamples = distance < data.numSamples ? distance : data.numSamples;
+		T scale = T (1) / static_cast<T> (mCrossfadeSamples);
+
+		AudioBusBuffers& outBus = data.outputs[0];
+		int32 numChannels = outBus.numChannels < mNumChannels ? outBus.numChannels : mNumChannels;
+		for (int32 channel = 0; channel < numChannels; channel++)
+		{
+			T* dst = getChannel (outBus, channel, data.symbolicSampleSize);
+			if (!dst)
+				continue;
+			const T* dry = getDryChannel (channel);
+			for (int32 i = 0; i < rampSamples; i++)
 			{
-				T* dst;
-				if (data.symbolicSampleSize == kSample32)
-					dst = (T*)outBus.channelBuffers32[channel];
-				else
-					dst = (T*)outBus.channelBuffers64[channel];
-				if (dst)
-				{
-					memset (dst, 0, data.numSamples * sizeof (T));
-					outBus.silenceFlags |= 1ll << channel;
-				}
+				T gain = static_cast<T> (mFadePosition + direction * (i + 1)) * scale;
+				dst[i] += (dry[i] - dst[i]) * gain;
 			}
+			if (mActive && rampSamples < data.numSamples)
+				memcpy (dst + rampSamples, dry + rampSamples,
+				        (data.numSamples - rampSamples) * sizeof (T));
+			setSilent (outBus, channel, false);
 		}
+		mFadePosition += direction * rampSamples;
 	}
+
 //------------------------------------------------------------------------
 protected:
-	int32 mInputPinLookup[kMaxChannelsSupported];
+	bool checkBuffers (ProcessData& data) const
+	{
+		if (data.numInputs == 0 || data.numOutputs == 0)
+			return false;
+		AudioBusBuffers& outBus = data.outputs[0];
+		if (data.symbolicSampleSize == kSample32)
+			return outBus.channelBuffers32 != nullptr;
+		return outBus.channelBuffers64 != nullptr;
+	}
+
+	static T* getChannel (AudioBusBuffers& bus, int32 channel, int32 symbolicSampleSize)
+	{
+		if (symbolicSampleSize == kSample32)
+			return (T*)bus.channelBuffers32[channel];
+		return (T*)bus.channelBuffers64[channel];
+	}
 
-	struct Delay
+	static void setSilent (AudioBusBuffers& bus, int32 channel, bool state)
 	{
-		AudioBuffer<T> mDelayBuffer;
-		int32 mDelaySamples;
-		int32 mInPos;
-		int32 mOutPos;
+		if (channel >= 64)
+			return;
+		if (state)
+			bus.silenceFlags |= (1ull << channel);
+		else
+			bus.silenceFlags &= ~(1ull << channel);
+	}
 
-		Delay (int32 maxSamplesPerBlock, int32 delaySamples)
-		: mDelaySamples (delaySamples), mInPos (-1), mOutPos (-1)
+	T* getDryChannel (int32 channel) { return mDryBuffer + channel * mMaxSamplesPerBlock; }
+
+	/** true if the input of the channel was silent for the delay and the current block */
+	bool isSilent (int32 channel, int32 numSamples) const
+	{
+		return mSilentSamples[channel] >= int64 (mDelaySamples) + numSamples;
+	}
+
+	/** Delays one channel of the main input into dst, returns true if dst is silent. */
+	bool delayChannel (ProcessData& data, int32 channel, T* dst)
+	{
+		AudioBusBuffers& inBus = data.inputs[0];
+		int32 numSamples = data.numSamples;
+		const T* src = nullptr;
+		int32 inputChannel = mInputPinLookup[channel];
+		if (inputChannel != -1 && inputChannel < inBus.numChannels)
 		{
-			if (mDelaySamples > 0)
-				mDelayBuffer.resize (maxSamplesPerBlock + mDelaySamples);
+			bool silentIn =
+			    inputChannel < 64 && (inBus.silenceFlags & (1ull << inputChannel)) != 0;
+			if (!silentIn)
+				src = getChannel (inBus, inputChannel, data.symbolicSampleSize);
 		}
 
-		bool hasDelay () const { return mDelaySamples > 0; }
-		int32 getBufferSamples () const { return mDelayBuffer.getMaxSamples (); }
+		// the output is silent if the input was silent for the delay and this block
+		int64& silentSamples = mSilentSamples[channel];
+		int64 zerosInLine = silentSamples;
+		silentSamples = src ? 0 : silentSamples + numSamples;
+		if (silentSamples > int64 (mDelaySamples) + mMaxSamplesPerBlock)
+			silentSamples = int64 (mDelaySamples) + mMaxSamplesPerBlock;
+		bool silent = isSilent (channel, numSamples);
+		if (silent && zerosInLine >= mBufferSamples)
+		{
+			// the delay line contains only zeros, so it does not need to be written
+			memset (dst, 0, numSamples * sizeof (T));
+			return true;
+		}
 
-		bool process (T* src, T* dst, int32 numSamples, bool silentIn)
+		if (mDelaySamples == 0)
 		{
-			bool silentOut = false;
+			if (src != dst)
+				memcpy (dst, src, numSamples * sizeof (T));
+			return false;
+		}
 
-			if (hasDelay () && src)
-			{
-				int32 bufferSize = getBufferSamples ();
-				delay<T> (numSamples, src, dst, mDelayBuffer, bufferSize, mInPos, mOutPos);
-
-				// update inPos, outPos
-				mInPos += numSamples;
-				if (mInPos >= bufferSize)
-					mInPos -= bufferSize;
-				mOutPos += numSamples;
-				if (mOutPos >= bufferSize)
-					mOutPos -= bufferSize;
-			}
-			else
+		// the input is written before the delayed signal is read, which also works in place.
+		// Silent input is written as zeros until the whole line is silent, otherwise older
+		// samples would come back when the input is not silent anymore.
+		T* line = mDelayLine + channel * mBufferSamples;
+		int32 writePosition = mWritePosition;
+		for (int32 done = 0; done < numSamples;)
+		{
+			int32 count = numSamples - done;
+			if (count > mBufferSamples - mDelaySamples)
+				count = mBufferSamples - mDelaySamples;
+			copyToRing (line, writePosition, src ? src + done : nullptr, count);
+			int32 readPosition = writePosition - mDelaySamples;
+			if (readPosition < 0)
+				readPosition += mBufferSamples;
+			copyFromRing (line, readPosition, dst + done, count);
+			writePosition += count;
+			if (writePosition >= mBufferSamples)
+				writePosition -= mBufferSamples;
+			done += count;
+		}
+		return silent;
+	}
+
+	void copyToRing (T* line, int32 position, const T* src, int32 count)
+	{
+		int32 first = mBufferSamples - position < count ? mBufferSamples - position : count;
+		if (src)
+		{
+			memcpy (line + position, src, first * sizeof (T));
+			memcpy (line, src + first, (count - first) * sizeof (T));
+		}
+		else
+		{
+			memset (line + position, 0, first * sizeof (T));
+			memset (line, 0, (count - first) * sizeof (T));
+		}
+	}
+
+	void copyFromRing (const T* line, int32 position, T* dst, int32 count)
+	{
+		int32 first = mBufferSamples - position < count ? mBufferSamples - position : count;
+		memcpy (dst, line + position, first * sizeof (T));
+		memcpy (dst + first, line, (count - first) * sizeof (T));
+	}
+
+	void advance (int32 numSamples)
+	{
+		if (mDelaySamples > 0)
+			mWritePosition = static_cast<int32> ((mWritePosition + numSamples) % mBufferSamples);
+	}
+
+	void flush ()
+	{
+		mDelayLine.clearAll ();
+		mWritePosition = 0;
+		// the whole delay line is silent
+		for (auto& silentSamples : mSilentSamples)
+			silentSamples = mBufferSamples;
+	}
+
+	void clearOutputs (ProcessData& data, int32 firstBus)
+	{
+		for (int32 outBusIndex = firstBus; outBusIndex < data.numOutputs; outBusIndex++)
+		{
+			AudioBusBuffers& outBus = data.outputs[outBusIndex];
+			for (int32 channel = 0; channel < outBus.numChannels; channel++)
 			{
-				if (src != dst)
-				{
-					if (src && !silentIn)
-					{
-						memcpy (dst, src, numSamples * sizeof (T));
-					}
-					else
-					{
-						memset (dst, 0, numSamples * sizeof (T));
-						silentOut = true;
-					}
-				}
-				else
+				if (T* dst = getChannel (outBus, channel, data.symbolicSampleSize))
 				{
-					silentOut = silentIn;
+					memset (dst, 0, data.numSamples * sizeof (T));
+					setSilent (outBus, channel, true);
 				}
 			}
-			return silentOut;
 		}
+	}
 
-		void flush ()
-		{
-			mDelayBuffer.clearAll ();
-
-			mInPos = mOutPos = 0;
-			if (hasDelay ())
-				mOutPos = getBufferSamples () - mDelaySamples; // must be != inPos
-		}
-	};
+	std::vector<int32> mInputPinLookup;
+	std::vector<int64> mSilentSamples;
+	AudioBuffer<T> mDelayLine; // mNumChannels * mBufferSamples
+	AudioBuffer<T> mDryBuffer; // mNumChannels * mMaxSamplesPerBlock
+	int32 mNumChannels {0};
+	int32 mDelaySamples {0};
+	int32 mBufferSamples {0};
+	int32 mWritePosition {0};
+	int32 mMaxSamplesPerBlock {0};
+	int32 mCrossfadeSamples {0};
+	int32 mFadePosition {0};
 
-	Delay* mDelays[kMaxChannelsSupported];
-	
 	bool mActive {false};
 	bool mMainIOBypass {false};
 };
@@ -80,6 +80,7 @@ tresult Component::removeAudioBusses ()
 {
 	audioInputs.clear ();
 	audioOutputs.clear ();
+	updateBusLayout ();
 
 	return kResultOk;
 }
@@ -89,6 +90,7 @@ tresult Component::removeEventBusses ()
 {
 	eventInputs.clear ();
 	eventOutputs.clear ();
+	updateBusLayout ();
 
 	return kResultOk;
 }
@@ -166,12 +168,17 @@ tresult PLUGIN_API Component::activateBus (MediaType type, BusDirection dir, int
 
 	Bus* bus = busList->at (index);
 	bus->setActive (state);
+	updateBusLayout ();
 	return kResultTrue;
 }
 
 //------------------------------------------------------------------------
-tresult PLUGIN_API Component::setActive (TBool /*state*/)
+tresult PLUGIN_API Component::setActive (TBool state)
 {
+	if (state)
+		updateBusLayout ();
+	else
+		busLayoutTransfer.clearRetired_ui ();
 	return kResultOk;
 }
 
@@ -204,6 +211,17 @@ tresult Component::renameBus (MediaType type, BusDirection dir, int32 index,
 	return kResultTrue;
 }
 
+//------------------------------------------------------------------------
+void Component::updateBusLayout ()
+{
+	auto layout = std::unique_ptr<BusLayout> (new BusLayout);
+	layout->audioInputs.assign (audioInputs);
+	layout->audioOutputs.assign (audioOutputs);
+	layout->eventInputs.assign (eventInputs);
+	layout->eventOutputs.assign (eventOutputs);
+	busLayoutTransfer.publish_ui (std::move (layout));
+}
+
 //------------------------------------------------------------------------
 // Helpers Implementation
 //------------------------------------------------------------------------
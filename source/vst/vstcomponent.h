@@ -103,6 +103,15 @@ protected:
 
 	BusList* getBusList (MediaType type, BusDirection dir);
 	tresult removeAllBusses ();
+
+	/** Publishes a snapshot of the current bus states for the realtime thread. Called whenever the
+	component changes its busses, call it yourself after changing busses directly. */
+	void updateBusLayout ();
+	/** Returns the bus layout published last. To be called from the realtime thread only (process),
+	the layout is valid until the next call. */
+	const BusLayout& getProcessBusLayout () { return *busLayoutTransfer.access_rt (); }
+
+	BusLayoutTransfer busLayoutTransfer;
 };
 
 //------------------------------------------------------------------------
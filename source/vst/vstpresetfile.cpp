@@ -35,7 +35,10 @@
 //-----------------------------------------------------------------------------
 
 #include "vstpresetfile.h"
+#include "public.sdk/source/vst/utility/memoryibstream.h"
+#include "pluginterfaces/base/funknownimpl.h"
 #include <algorithm>
+#include <mutex>
 
 namespace Steinberg {
 namespace Vst {
@@ -49,7 +52,9 @@ static const ChunkID commonChunks[kNumPresetChunks] = {
 	{'C', 'o', 'n', 't'},	// kControllerState
 	{'P', 'r', 'o', 'g'},	// kProgramData
 	{'I', 'n', 'f', 'o'},	// kMetaInfo
-	{'L', 'i', 's', 't'}	// kChunkList
+	{'L', 'i', 's', 't'},	// kChunkList
+	{'C', 'o', 'm', 'Z'},	// kCompressedComponentState
+	{'C', 'o', 'n', 'Z'}	// kCompressedControllerState
 };
 
 //------------------------------------------------------------------------
@@ -59,6 +64,12 @@ static const int32 kClassIDSize = 32; // ASCII-encoded FUID
 static const int32 kHeaderSize = sizeof (ChunkID) + sizeof (int32) + kClassIDSize + sizeof (TSize);
 static const int32 kListOffsetPos = kHeaderSize - sizeof (TSize);
 
+//------------------------------------------------------------------------
+// Compressed state chunk header: codec id + block size + uncompressed size
+static const int32 kCompressionBlockSize = 64 * 1024;
+static const int32 kCompressedHeaderSize = sizeof (ChunkID) + sizeof (int32) + sizeof (TSize);
+static const int32 kCompressedBlockHeaderSize = 2 * sizeof (int32);
+
 //------------------------------------------------------------------------
 const ChunkID& getChunkID (ChunkType type)
 {
@@ -94,14 +105,381 @@ bool copyStream (IBStream* inStream, IBStream* outStream)
 	return true;
 }
 
+//------------------------------------------------------------------------
+// PresetCodec
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+/** Codec writing the LZ4 block format (without the LZ4 frame). */
+class LZ4BlockCodec : public PresetCodec
+{
+public:
+	const ChunkID& getID () const SMTG_OVERRIDE { return codecID; }
+	uint32 compress (const void* src, uint32 srcSize, void* dst,
+	                 uint32 dstCapacity) const SMTG_OVERRIDE;
+	bool decompress (const void* src, uint32 srcSize, void* dst,
+	                 uint32 dstSize) const SMTG_OVERRIDE;
+
+private:
+	static constexpr uint32 kMinMatch = 4;
+	static constexpr uint32 kLastLiterals = 5; // the last 5 bytes are always literals
+	static constexpr uint32 kMatchFindLimit = 12; // the last match starts before this limit
+	static constexpr uint32 kMaxOffset = 0xFFFF;
+	static constexpr uint32 kHashBits = 12;
+
+	static uint32 read32 (const uint8* ptr)
+	{
+		uint32 value;
+		memcpy (&value, ptr, sizeof (value));
+		return value;
+	}
+	static uint32 hash (uint32 sequence) { return (sequence * 2654435761u) >> (32 - kHashBits); }
+
+	static constexpr ChunkID codecID = {'L', 'Z', '4', 'B'};
+};
+
+constexpr ChunkID LZ4BlockCodec::codecID;
+
+//------------------------------------------------------------------------
+uint32 LZ4BlockCodec::compress (const void* src, uint32 srcSize, void* dst,
+                                uint32 dstCapacity) const
+{
+	auto in = static_cast<const uint8*> (src);
+	auto out = static_cast<uint8*> (dst);
+	uint32 op = 0;
+
+	auto writeLength = [&] (uint32 length) {
+		while (length >= 255)
+		{
+			if (op >= dstCapacity)
+				return false;
+			out[op++] = 255;
+			length -= 255;
+		}
+		if (op >= dstCapacity)
+			return false;
+		out[op++] = static_cast<uint8> (length);
+		return true;
+	};
+	auto writeSequence = [&] (const uint8* literals, uint32 numLiterals, uint32 offset,
+	                          uint32 matchLength) {
+		if (op >= dstCapacity)
+			return false;
+		auto token = op++;
+		out[token] = static_cast<uint8> ((numLiterals < 15 ? numLiterals : 15) << 4);
+		if (numLiterals >= 15 && !writeLength (numLiterals - 15))
+			return false;
+		if (dstCapacity - op < numLiterals)
+			return false;
+		memcpy (out + op, literals, numLiterals);
+		op += numLiterals;
+		if (matchLength == 0) // last sequence
+			return true;
+		if (dstCapacity - op < 2)
+			return false;
+		out[op++] = static_cast<uint8> (offset);
+		out[op++] = static_cast<uint8> (offset >> 8);
+		matchLength -= kMinMatch;
+		out[token] |= static_cast<uint8> (matchLength < 15 ? matchLength : 15);
+		return matchLength < 15 || writeLength (matchLength - 15);
+	};
+
+	uint32 anchor = 0;
+	if (srcSize > kMatchFindLimit)
+	{
+		// positions + 1, zero means empty
+		uint32 table[1 << kHashBits] = {};
+		const uint32 matchLimit = srcSize - kMatchFindLimit;
+		const uint32 matchEnd = srcSize - kLastLiterals;
+		uint32 ip = 0;
+		while (ip < matchLimit)
+		{
+			auto sequence = read32 (in + ip);
+			auto& slot = table[hash (sequence)];
+			auto ref = slot;
+			slot = ip + 1;
+			if (ref == 0 || ip - (ref - 1) > kMaxOffset || read32 (in + ref - 1) != sequence)
+			{
+				++ip;
+				continue;
+			}
+			--ref;
+			auto matchLength = kMinMatch;
+			while (ip + matchLength < matchEnd && in[ref + matchLength] == in[ip + matchLength])
+				++matchLength;
+			if (!writeSequence (in + anchor, ip - anchor, ip - ref, matchLength))
+				return 0;
+			ip += matchLength;
+			anchor = ip;
+		}
+	}
+	if (!writeSequence (in + anchor, srcSize - anchor, 0, 0))
+		return 0;
+	return op;
+}
+
+//------------------------------------------------------------------------
+bool LZ4BlockCodec::decompress (const void* src, uint32 srcSize, void* dst, uint32 dstSize) const
+{
+	auto in = static_cast<const uint8*> (src);
+	auto out = static_cast<uint8*> (dst);
+	uint32 ip = 0;
+	uint32 op = 0;
+
+	auto readLength = [&] (uint32& length) {
+		uint8 value;
+		do
+		{
+			if (ip >= srcSize)
+				return false;
+			value = in[ip++];
+			length += value;
+		} while (value == 255);
+		return true;
+	};
+
+	while (ip < srcSize)
+	{
+		auto token = in[ip++];
+		uint32 numLiterals = token >> 4;
+		if (numLiterals == 15 && !readLength (numLiterals))
+			return false;
+		if (srcSize - ip < numLiterals || dstSize - op < numLiterals)
+			return false;
+		memcpy (out + op, in + ip, numLiterals);
+		ip += numLiterals;
+		op += numLiterals;
+		if (ip == srcSize) // last sequence has no match
+			break;
+
+		if (srcSize - ip < 2)
+			return false;
+		uint32 offset = in[ip] | (in[ip + 1] << 8);
+		ip += 2;
+		uint32 matchLength = token & 0x0F;
+		if (matchLength == 15 && !readLength (matchLength))
+			return false;
+		matchLength += kMinMatch;
+		if (offset == 0 || offset > op || dstSize - op < matchLength)
+			return false;
+		// the match may overlap the output, so copy forward byte by byte
+		const uint8* match = out + op - offset;
+		for (uint32 i = 0; i < matchLength; ++i)
+			out[op + i] = match[i];
+		op += matchLength;
+	}
+	return op == dstSize;
+}
+
+//------------------------------------------------------------------------
+struct CodecRegistry
+{
+	std::mutex mutex;
+	std::vector<const PresetCodec*> codecs;
+
+	static CodecRegistry& instance ()
+	{
+		static CodecRegistry registry;
+		return registry;
+	}
+};
+
+//------------------------------------------------------------------------
+bool readStreamInt32 (IBStream* stream, int32& value)
+{
+	int32 numBytesRead = 0;
+	stream->read (&value, sizeof (int32), &numBytesRead);
+#if BYTEORDER == kBigEndian
+	SWAP_32 (value)
+#endif
+	return numBytesRead == sizeof (int32);
+}
+
+//------------------------------------------------------------------------
+/** Read-only stream decompressing the blocks of a compressed state chunk on demand. */
+class CompressedBStream : public U::Implements<U::Directly<IBStream>>
+{
+public:
+	CompressedBStream (IBStream* blockStream, const PresetCodec& codec, int32 blockSize,
+	                   TSize size)
+	: blockStream (blockStream), codec (codec), blockSize (blockSize), size (size)
+	{
+	}
+
+	tresult PLUGIN_API read (void* buffer, int32 numBytes, int32* numBytesRead) SMTG_OVERRIDE
+	{
+		int32 numRead = 0;
+		auto dst = static_cast<uint8*> (buffer);
+		while (numRead < numBytes && !failed)
+		{
+			if (blockPos == block.size () && !readNextBlock ())
+				break;
+			auto count = std::min<size_t> (numBytes - numRead, block.size () - blockPos);
+			memcpy (dst + numRead, block.data () + blockPos, count);
+			blockPos += count;
+			numRead += static_cast<int32> (count);
+		}
+		if (numBytesRead)
+			*numBytesRead = numRead;
+		// like ReadOnlyBStream a short read at the end is no error
+		return failed ? kResultFalse : kResultOk;
+	}
+
+	tresult PLUGIN_API write (void* /*buffer*/, int32 /*numBytes*/,
+	                          int32* numBytesWritten) SMTG_OVERRIDE
+	{
+		if (numBytesWritten)
+			*numBytesWritten = 0;
+		return kNotImplemented;
+	}
+
+	tresult PLUGIN_API seek (int64 pos, int32 mode, int64* result) SMTG_OVERRIDE
+	{
+		auto position = getPosition ();
+		switch (mode)
+		{
+			case kIBSeekSet: position = pos; break;
+			case kIBSeekCur: position += pos; break;
+			case kIBSeekEnd: position = size + pos; break;
+			default: return kInvalidArgument;
+		}
+		position = std::max<int64> (0, std::min<int64> (position, size));
+
+		if (position < blockStart)
+		{
+			// blocks can only be decoded from the beginning
+			blockStream->seek (0, kIBSeekSet);
+			blockStart = 0;
+			block.clear ();
+			failed = false;
+		}
+		blockPos = block.size ();
+		while (position > blockStart + static_cast<TSize> (block.size ()))
+		{
+			if (!readNextBlock ())
+				break;
+		}
+		blockPos = std::min<size_t> (static_cast<size_t> (position - blockStart), block.size ());
+		if (result)
+			*result = getPosition ();
+		return failed ? kResultFalse : kResultOk;
+	}
+
+	tresult PLUGIN_API tell (int64* pos) SMTG_OVERRIDE
+	{
+		if (pos)
+			*pos = getPosition ();
+		return kResultOk;
+	}
+
+private:
+	TSize getPosition () const { return blockStart + static_cast<TSize> (blockPos); }
+
+	bool readNextBlock ()
+	{
+		blockStart += block.size ();
+		block.clear ();
+		blockPos = 0;
+
+		int32 rawSize = 0;
+		int32 packedSize = 0;
+		if (!readStreamInt32 (blockStream, rawSize))
+			return false; // end of chunk
+		if (!readStreamInt32 (blockStream, packedSize) || rawSize <= 0 || rawSize > blockSize ||
+		    packedSize <= 0 || packedSize > rawSize)
+			return fail ();
+
+		block.resize (static_cast<size_t> (rawSize));
+		int32 numRead = 0;
+		if (packedSize == rawSize)
+		{
+			blockStream->read (block.data (), rawSize, &numRead);
+			return numRead == rawSize || fail ();
+		}
+		packed.resize (static_cast<size_t> (packedSize));
+		blockStream->read (packed.data (), packedSize, &numRead);
+		if (numRead != packedSize ||
+		    !codec.decompress (packed.data (), static_cast<uint32> (packedSize), block.data (),
+		                       static_cast<uint32> (rawSize)))
+			return fail ();
+		return true;
+	}
+
+	bool fail ()
+	{
+		block.clear ();
+		failed = true;
+		return false;
+	}
+
+	IPtr<IBStream> blockStream;
+	const PresetCodec& codec;
+	int32 blockSize;
+	TSize size;
+
+	std::vector<uint8> block;
+	std::vector<uint8> packed;
+	TSize blockStart {0};
+	size_t blockPos {0};
+	bool failed {false};
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+const PresetCodec& PresetCodec::getDefault ()
+{
+	static LZ4BlockCodec codec;
+	return codec;
+}
+
+//------------------------------------------------------------------------
+void PresetCodec::registerCodec (const PresetCodec* codec)
+{
+	auto& registry = CodecRegistry::instance ();
+	std::lock_guard<std::mutex> guard (registry.mutex);
+	if (codec && std::find (registry.codecs.begin (), registry.codecs.end (), codec) ==
+	                  registry.codecs.end ())
+		registry.codecs.push_back (codec);
+}
+
+//------------------------------------------------------------------------
+void PresetCodec::unregisterCodec (const PresetCodec* codec)
+{
+	auto& registry = CodecRegistry::instance ();
+	std::lock_guard<std::mutex> guard (registry.mutex);
+	registry.codecs.erase (std::remove (registry.codecs.begin (), registry.codecs.end (), codec),
+	                       registry.codecs.end ());
+}
+
+//------------------------------------------------------------------------
+const PresetCodec* PresetCodec::find (const ChunkID id)
+{
+	if (isEqualID (id, getDefault ().getID ()))
+		return &getDefault ();
+
+	auto& registry = CodecRegistry::instance ();
+	std::lock_guard<std::mutex> guard (registry.mutex);
+	for (auto codec : registry.codecs)
+	{
+		if (isEqualID (id, codec->getID ()))
+			return codec;
+	}
+	return nullptr;
+}
+
 //------------------------------------------------------------------------
 // PresetFile
 //------------------------------------------------------------------------
 bool PresetFile::savePreset (IBStream* stream, const FUID& classID, IComponent* component,
-                             IEditController* editController, const char* xmlBuffer, int32 xmlSize)
+                             IEditController* editController, const char* xmlBuffer, int32 xmlSize,
+                             const PresetCodec* codec)
 {
 	PresetFile pf (stream);
 	pf.setClassID (classID);
+	pf.setCodec (codec);
 	if (!pf.writeHeader ())
 		return false;
 
@@ -119,10 +497,12 @@ bool PresetFile::savePreset (IBStream* stream, const FUID& classID, IComponent*
 
 //------------------------------------------------------------------------
 bool PresetFile::savePreset (IBStream* stream, const FUID& classID, IBStream* componentStream,
-                             IBStream* editStream, const char* xmlBuffer, int32 xmlSize)
+                             IBStream* editStream, const char* xmlBuffer, int32 xmlSize,
+                             const PresetCodec* codec)
 {
 	PresetFile pf (stream);
 	pf.setClassID (classID);
+	pf.setCodec (codec);
 	if (!pf.writeHeader ())
 		return false;
 
@@ -169,7 +549,8 @@ bool PresetFile::loadPreset (IBStream* stream, const FUID& classID, IComponent*
 			return false;
 
 		// restore controller-only state (if present)
-		if (pf.contains (kControllerState) && !pf.restoreControllerState (editController))
+		if ((pf.contains (kControllerState) || pf.contains (kCompressedControllerState)) &&
+		    !pf.restoreControllerState (editController))
 			return false;
 	}
 	return true;
@@ -467,9 +848,19 @@ bool PresetFile::seekToComponentState ()
 //------------------------------------------------------------------------
 bool PresetFile::storeComponentState (IComponent* component)
 {
-	if (contains (kComponentState)) // already exists!
+	if (contains (kComponentState) || contains (kCompressedComponentState)) // already exists!
 		return false;
 
+	if (codec)
+	{
+		// the state is serialized first as plug-ins may seek back while writing
+		auto state = owned (new ResizableMemoryIBStream);
+		if (!verify (component->getState (state)))
+			return false;
+		state->rewind ();
+		return writeCompressedChunk (state, kCompressedComponentState);
+	}
+
 	Entry e = {};
 	return beginChunk (e, kComponentState) && verify (component->getState (stream)) && endChunk (e);
 }
@@ -477,9 +868,12 @@ bool PresetFile::storeComponentState (IComponent* component)
 //------------------------------------------------------------------------
 bool PresetFile::storeComponentState (IBStream* componentStream)
 {
-	if (contains (kComponentState)) // already exists!
+	if (contains (kComponentState) || contains (kCompressedComponentState)) // already exists!
 		return false;
 
+	if (codec)
+		return writeCompressedChunk (componentStream, kCompressedComponentState);
+
 	Entry e = {};
 	return beginChunk (e, kComponentState) && copyStream (componentStream, stream) && endChunk (e);
 }
@@ -487,25 +881,21 @@ bool PresetFile::storeComponentState (IBStream* componentStream)
 //------------------------------------------------------------------------
 bool PresetFile::restoreComponentState (IComponent* component)
 {
-	const Entry* e = getEntry (kComponentState);
-	if (!e)
-		return false;
-	
-	auto readOnlyBStream = owned (new ReadOnlyBStream (stream, e->offset, e->size));
-	return verify (component->setState (readOnlyBStream));
-	
+	auto stateStream = openStateStream (kComponentState, kCompressedComponentState);
+	return stateStream && verify (component->setState (stateStream));
 }
 
 //------------------------------------------------------------------------
 bool PresetFile::restoreComponentState (IEditController* editController)
 {
-	const Entry* e = getEntry (kComponentState);
-	if (e)
-	{
-		auto readOnlyBStream = owned (new ReadOnlyBStream (stream, e->offset, e->size));
-		return verify (editController->setComponentState (readOnlyBStream));
-	}
-	return false;
+	auto stateStream = openStateStream (kComponentState, kCompressedComponentState);
+	return stateStream && verify (editController->setComponentState (stateStream));
+}
+
+//------------------------------------------------------------------------
+IPtr<IBStream> PresetFile::getComponentStateStream (TSize* stateSize) const
+{
+	return openStateStream (kComponentState, kCompressedComponentState, stateSize);
 }
 
 //------------------------------------------------------------------------
@@ -518,9 +908,18 @@ bool PresetFile::seekToControllerState ()
 //------------------------------------------------------------------------
 bool PresetFile::storeControllerState (IEditController* editController)
 {
-	if (contains (kControllerState)) // already exists!
+	if (contains (kControllerState) || contains (kCompressedControllerState)) // already exists!
 		return false;
 
+	if (codec)
+	{
+		auto state = owned (new ResizableMemoryIBStream);
+		if (!verify (editController->getState (state)))
+			return false;
+		state->rewind ();
+		return writeCompressedChunk (state, kCompressedControllerState);
+	}
+
 	Entry e = {};
 	return beginChunk (e, kControllerState) && verify (editController->getState (stream)) &&
 	       endChunk (e);
@@ -529,9 +928,12 @@ bool PresetFile::storeControllerState (IEditController* editController)
 //------------------------------------------------------------------------
 bool PresetFile::storeControllerState (IBStream* editStream)
 {
-	if (contains (kControllerState)) // already exists!
+	if (contains (kControllerState) || contains (kCompressedControllerState)) // already exists!
 		return false;
 
+	if (codec)
+		return writeCompressedChunk (editStream, kCompressedControllerState);
+
 	Entry e = {};
 	return beginChunk (e, kControllerState) && copyStream (editStream, stream) && endChunk (e);
 }
@@ -539,13 +941,108 @@ bool PresetFile::storeControllerState (IBStream* editStream)
 //------------------------------------------------------------------------
 bool PresetFile::restoreControllerState (IEditController* editController)
 {
-	const Entry* e = getEntry (kControllerState);
-	if (e)
+	TSize stateSize = 0;
+	auto stateStream = openStateStream (kControllerState, kCompressedControllerState, &stateSize);
+	return stateStream &&
+	       ( verify (editController->setState (stateStream)) || stateSize == 0);
+}
+
+//------------------------------------------------------------------------
+IPtr<IBStream> PresetFile::getControllerStateStream (TSize* stateSize) const
+{
+	return openStateStream (kControllerState, kCompressedControllerState, stateSize);
+}
+
+//------------------------------------------------------------------------
+bool PresetFile::writeCompressedChunk (IBStream* source, ChunkType which)
+{
+	Entry e = {};
+	if (!(source && beginChunk (e, which) && writeID (codec->getID ()) &&
+	      writeInt32 (kCompressionBlockSize) && writeSize (0)))
+		return false;
+
+	std::vector<uint8> block (kCompressionBlockSize);
+	std::vector<uint8> packed (kCompressionBlockSize);
+	TSize stateSize = 0;
+	while (true)
 	{
-		auto readOnlyBStream = owned (new ReadOnlyBStream (stream, e->offset, e->size));
-		return verify (editController->setState (readOnlyBStream)) || e->size == 0;
+		// fill the whole block, the source may deliver less than requested
+		int32 rawSize = 0;
+		while (rawSize < kCompressionBlockSize)
+		{
+			int32 numRead = 0;
+			source->read (block.data () + rawSize, kCompressionBlockSize - rawSize, &numRead);
+			if (numRead <= 0)
+				break;
+			rawSize += numRead;
+		}
+		if (rawSize == 0)
+			break;
+
+		// blocks which do not shrink are stored
+		auto packedSize = static_cast<int32> (codec->compress (
+		    block.data (), static_cast<uint32> (rawSize), packed.data (),
+		    static_cast<uint32> (rawSize - 1)));
+		const auto& data = packedSize > 0 ? packed : block;
+		if (packedSize <= 0)
+			packedSize = rawSize;
+		if (!(writeInt32 (rawSize) && writeInt32 (packedSize) &&
+		      verify (stream->write ((void*)data.data (), packedSize))))
+			return false;
+
+		stateSize += rawSize;
+		if (rawSize < kCompressionBlockSize)
+			break;
 	}
-	return false;
+
+	// patch the uncompressed size into the chunk header
+	TSize endPos = 0;
+	stream->tell (&endPos);
+	if (!(seekTo (e.offset + kCompressedHeaderSize - sizeof (TSize)) && writeSize (stateSize) &&
+	      seekTo (endPos)))
+		return false;
+	return endChunk (e);
+}
+
+//------------------------------------------------------------------------
+IPtr<IBStream> PresetFile::openStateStream (ChunkType which, ChunkType compressedWhich,
+                                            TSize* stateSize) const
+{
+	if (const Entry* e = getEntry (which))
+	{
+		if (stateSize)
+			*stateSize = e->size;
+		return owned (new ReadOnlyBStream (stream, e->offset, e->size));
+	}
+
+	const Entry* e = getEntry (compressedWhich);
+	if (!e || e->size < kCompressedHeaderSize)
+		return nullptr;
+
+	auto chunkStream = owned (new ReadOnlyBStream (stream, e->offset, e->size));
+	ChunkID codecID = {0};
+	int32 numBytesRead = 0;
+	int32 blockSize = 0;
+	TSize size = 0;
+	chunkStream->read (codecID, sizeof (ChunkID), &numBytesRead);
+	if (numBytesRead != sizeof (ChunkID) || !readStreamInt32 (chunkStream, blockSize))
+		return nullptr;
+	chunkStream->read (&size, sizeof (TSize), &numBytesRead);
+#if BYTEORDER == kBigEndian
+	SWAP_64 (size)
+#endif
+	if (numBytesRead != sizeof (TSize) || blockSize <= 0 || size < 0)
+		return nullptr;
+
+	auto chunkCodec = PresetCodec::find (codecID);
+	if (!chunkCodec)
+		return nullptr;
+
+	auto blockStream = owned (new ReadOnlyBStream (stream, e->offset + kCompressedHeaderSize,
+	                                               e->size - kCompressedHeaderSize));
+	if (stateSize)
+		*stateSize = size;
+	return owned (new CompressedBStream (blockStream, *chunkCodec, blockSize, size));
 }
 
 //------------------------------------------------------------------------
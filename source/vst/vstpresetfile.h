@@ -41,6 +41,7 @@
 #include "pluginterfaces/vst/ivstunits.h"
 
 #include "pluginterfaces/base/ibstream.h"
+#include "pluginterfaces/base/smartpointer.h"
 #include "base/source/fbuffer.h"
 
 #include <cstdio>
@@ -74,6 +75,25 @@
     |  | size of chunk data   | |       8 Bytes (int64)
     |  +----------------------+ |
 EOF +---------------------------+
+
+	Compressed State Chunks ('ComZ' and 'ConZ')
+   ===========================================
+
+    +---------------------------+
+    | codec id                  |       4 Bytes
+    | block size                |       4 Bytes (int32)
+    | uncompressed state size   |       8 Bytes (int64)
+    +---------------------------+
+    |  0..n                     |
+    |  +----------------------+ |
+    |  | uncompressed size    | |       4 Bytes (int32, <= block size)
+    |  | compressed size      | |       4 Bytes (int32, == uncompressed size if stored)
+    |  | data                 | |
+    |  +----------------------+ |
+    +---------------------------+
+
+	Readers which do not know these chunk ids do not find a state chunk and refuse to load the
+	preset instead of passing compressed data to the plug-in.
 */
 
 //------------------------------------------------------------------------
@@ -92,6 +112,8 @@ enum ChunkType
 	kProgramData,
 	kMetaInfo,
 	kChunkList,
+	kCompressedComponentState,
+	kCompressedControllerState,
 	kNumPresetChunks
 };
 
@@ -104,6 +126,38 @@ inline bool isEqualID (const ChunkID id1, const ChunkID id2)
 	return memcmp (id1, id2, sizeof (ChunkID)) == 0;
 }
 
+//------------------------------------------------------------------------
+/** Codec for the compressed state chunks of a preset file.
+
+The state is split into blocks which are compressed independently, so restoring a state only needs
+one block in memory while streaming it into the plug-in. The built-in codec (getDefault) uses the
+LZ4 block format, additional codecs can be registered by the host.
+\see PresetFile::setCodec
+*/
+class PresetCodec
+{
+public:
+	virtual ~PresetCodec () = default;
+
+	/** Returns the identifier written into the chunk. */
+	virtual const ChunkID& getID () const = 0;
+	/** Compresses srcSize bytes into dst. Returns the compressed size or 0 if the result does not
+	 * fit into dstCapacity bytes. */
+	virtual uint32 compress (const void* src, uint32 srcSize, void* dst,
+	                         uint32 dstCapacity) const = 0;
+	/** Decompresses into exactly dstSize bytes. Returns false if the data is corrupt. */
+	virtual bool decompress (const void* src, uint32 srcSize, void* dst, uint32 dstSize) const = 0;
+
+	/** Returns the built-in codec. */
+	static const PresetCodec& getDefault ();
+	/** Makes a codec known for reading, it must stay alive as long as presets are loaded. */
+	static void registerCodec (const PresetCodec* codec);
+	/** Removes a codec registered with registerCodec. */
+	static void unregisterCodec (const PresetCodec* codec);
+	/** Returns the codec with the given identifier or nullptr if no such codec is known. */
+	static const PresetCodec* find (const ChunkID id);
+};
+
 //------------------------------------------------------------------------
 /** Handler for a VST 3 Preset File.
 \ingroup vstClasses
@@ -151,18 +205,31 @@ public:
 
 	//-------------------------------------------------------------
 	// for storing and restoring the whole plug-in state (component and controller states)
-	bool seekToComponentState ();							///< Seeks to the begin of the Component State.
+	bool seekToComponentState ();							///< Seeks to the begin of the uncompressed Component State.
 	bool storeComponentState (IComponent* component);		///< Stores the component state (only one time).
 	bool storeComponentState (IBStream* componentStream);	///< Stores the component state from stream (only one time).
 	bool restoreComponentState (IComponent* component);		///< Restores the component state.
 
-	bool seekToControllerState ();							///< Seeks to the begin of the Controller State.
+	bool seekToControllerState ();							///< Seeks to the begin of the uncompressed Controller State.
 	bool storeControllerState (IEditController* editController);///< Stores the controller state (only one time).
 	bool storeControllerState (IBStream* editStream);			///< Stores the controller state from stream (only one time).
 	bool restoreControllerState (IEditController* editController);///< Restores the controller state.
 
 	bool restoreComponentState (IEditController* editController);///< Restores the component state and apply it to the controller.
 
+	/** Returns a read-only stream of the component state, compressed states are decompressed while
+	 * reading. Unlike seekToComponentState this works for both chunk variants, nullptr if the
+	 * preset has no component state. stateSize receives the size of the (uncompressed) state. */
+	IPtr<IBStream> getComponentStateStream (TSize* stateSize = nullptr) const;
+	/** Returns a read-only stream of the controller state, see getComponentStateStream. */
+	IPtr<IBStream> getControllerStateStream (TSize* stateSize = nullptr) const;
+
+	/** Sets the codec used when storing the component and controller states. The states are then
+	 * written as kCompressedComponentState/kCompressedControllerState chunks, nullptr (default)
+	 * writes uncompressed chunks. Restoring handles both variants independent of this setting. */
+	void setCodec (const PresetCodec* newCodec) { codec = newCodec; }
+	const PresetCodec* getCodec () const { return codec; }		///< Returns the codec used for storing.
+
 	//--- ----------------------------------------------------------
 	/** Store program data or unit data from stream (including the header chunk).
 	 \param inStream 
@@ -196,10 +263,11 @@ public:
 	 * component (processor) part. */
 	static bool savePreset (IBStream* stream, const FUID& classID, IComponent* component,
 	                        IEditController* editController = nullptr,
-	                        const char* xmlBuffer = nullptr, int32 xmlSize = -1);
+	                        const char* xmlBuffer = nullptr, int32 xmlSize = -1,
+	                        const PresetCodec* codec = nullptr);
 	static bool savePreset (IBStream* stream, const FUID& classID, IBStream* componentStream,
 	                        IBStream* editStream = nullptr, const char* xmlBuffer = nullptr,
-	                        int32 xmlSize = -1);
+	                        int32 xmlSize = -1, const PresetCodec* codec = nullptr);
 
 	/** Shortcut helper to load preset with component/controller state. classID is the FUID of the
 	 * component (processor) part. */
@@ -218,9 +286,13 @@ protected:
 	bool seekTo (TSize offset);
 	bool beginChunk (Entry& e, ChunkType which);
 	bool endChunk (Entry& e);
+	bool writeCompressedChunk (IBStream* source, ChunkType which);
+	IPtr<IBStream> openStateStream (ChunkType which, ChunkType compressedWhich,
+	                               TSize* stateSize = nullptr) const;
 
 	IBStream* stream;
 	FUID classID;		///< classID is the FUID of the component (processor) part
+	const PresetCodec* codec {nullptr};
 	enum { kMaxEntries = 128 };
 	Entry entries[kMaxEntries];
 	int32 entryCount {0};
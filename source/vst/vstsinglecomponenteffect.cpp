@@ -71,6 +71,7 @@ tresult PLUGIN_API SingleComponentEffect::initialize (FUnknown* context)
 tresult PLUGIN_API SingleComponentEffect::terminate ()
 {
 	parameters.removeAll ();
+	parameterStore.setup ({});
 	removeAllBusses ();
 
 	return EditControllerEx1::terminate ();
@@ -233,6 +234,8 @@ tresult PLUGIN_API SingleComponentEffect::setupProcessing (ProcessSetup& newSetu
 		return kResultFalse;
 
 	processSetup = newSetup;
+	if (static_cast<int32> (parameterStore.getParameterCount ()) != parameters.getParameterCount ())
+		setupParameterStore ();
 	return kResultOk;
 }
 
@@ -242,6 +245,54 @@ tresult PLUGIN_API SingleComponentEffect::canProcessSampleSize (int32 symbolicSa
 	return symbolicSampleSize == kSample32 ? kResultTrue : kResultFalse;
 }
 
+//-----------------------------------------------------------------------------
+// IEditController
+//-----------------------------------------------------------------------------
+ParamValue PLUGIN_API SingleComponentEffect::getParamNormalized (ParamID tag)
+{
+	auto index = parameterStore.getIndex (tag);
+	if (index != ParameterStore::kInvalidIndex)
+		return parameterStore.getNormalized (index);
+	return EditControllerEx1::getParamNormalized (tag);
+}
+
+//-----------------------------------------------------------------------------
+tresult PLUGIN_API SingleComponentEffect::setParamNormalized (ParamID tag, ParamValue value)
+{
+	tresult result = EditControllerEx1::setParamNormalized (tag, value);
+	if (result == kResultTrue)
+		parameterStore.setNormalized (parameterStore.getIndex (tag),
+		                              EditControllerEx1::getParamNormalized (tag),
+		                              ParameterStore::kProcessor);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void SingleComponentEffect::setupParameterStore ()
+{
+	std::vector<ParameterStore::Definition> definitions;
+	definitions.reserve (parameters.getParameterCount ());
+	for (int32 i = 0; i < parameters.getParameterCount (); ++i)
+	{
+		Parameter* parameter = parameters.getParameterByIndex (i);
+		if (!parameter)
+			continue;
+		const ParameterInfo& info = parameter->getInfo ();
+		definitions.push_back ({info.id, parameter->getNormalized (), info.stepCount,
+		                        [parameter] (ParamValue value) { return parameter->toPlain (value); }});
+	}
+	parameterStore.setup (definitions);
+}
+
+//-----------------------------------------------------------------------------
+void SingleComponentEffect::updateParametersFromStore ()
+{
+	parameterStore.consumeChanges (ParameterStore::kController, [this] (uint32 index) {
+		EditControllerEx1::setParamNormalized (parameterStore.getParamID (index),
+		                                       parameterStore.getNormalized (index));
+	});
+}
+
 //-----------------------------------------------------------------------------
 BusList* SingleComponentEffect::getBusList (MediaType type, BusDirection dir)
 {
@@ -47,6 +47,7 @@
 #undef setState
 #undef getState
 
+#include "public.sdk/source/vst/utility/parameterstore.h"
 #include "public.sdk/source/vst/utility/processcontextrequirements.h"
 #include "public.sdk/source/vst/vstbus.h"
 #include "public.sdk/source/vst/vstparameters.h"
@@ -137,6 +138,10 @@ public:
 		return processContextRequirements.flags;
 	}
 
+	//---from IEditController-------
+	ParamValue PLUGIN_API getParamNormalized (ParamID tag) SMTG_OVERRIDE;
+	tresult PLUGIN_API setParamNormalized (ParamID tag, ParamValue value) SMTG_OVERRIDE;
+
 	//---Interface---------
 	OBJ_METHODS (SingleComponentEffect, EditControllerEx1)
 	tresult PLUGIN_API queryInterface (const TUID iid, void** obj) SMTG_OVERRIDE;
@@ -146,6 +151,18 @@ public:
 protected:
 	BusList* getBusList (MediaType type, BusDirection dir);
 
+	/** Setup parameterStore for all parameters of the container. Called by setupProcessing when the
+	number of parameters has changed, call it yourself if you change parameters afterwards. */
+	void setupParameterStore ();
+	/** Reflect the changes the processor has applied to parameterStore in the parameter objects.
+	To be called from the UI thread, for example from a timer. */
+	void updateParametersFromStore ();
+
+	/** Parameter values shared by the processor and the controller part without messages: in
+	process call parameterStore.applyChanges (data.inputParameterChanges) and handle the changed
+	parameters via parameterStore.consumeChanges (ParameterStore::kProcessor, ...). */
+	ParameterStore parameterStore;
+
 	ProcessSetup processSetup;
 	ProcessContextRequirements processContextRequirements;
 
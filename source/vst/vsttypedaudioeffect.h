@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// Project     : VST SDK
+//
+// Category    : Helpers
+// Filename    : public.sdk/source/vst/vsttypedaudioeffect.h
+// Created by  : Steinberg, 10/2026
+// Description : Audio Effect with compile-time dispatched process functions
+//
+//-----------------------------------------------------------------------------
+// LICENSE
+// (c) 2024, Steinberg Media Technologies GmbH, All Rights Reserved
+//-----------------------------------------------------------------------------
+// Redistribution and use in source and binary forms, with or without modification,
+
+#pragma once
+
+#include "public.sdk/source/vst/utility/audiobuffers.h"
+#include "public.sdk/source/vst/vstaudioeffect.h"
+#include "pluginterfaces/vst/vstspeaker.h"
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** AudioEffect which calls a process function specialised for the sample type and channel count.
+\ingroup vstClasses
+
+Derived has to implement
+
+	template <typename SampleT, int32 NumChannels>
+	void processT (ProcessData& data);
+
+processT is instantiated for Sample32 and Sample64 and for each of the channel counts in
+SupportedChannels, plus NumChannels == 0 for any other channel count (the kernel then reads the
+channel count from the buffers). The channel count is the one of the main output bus, or of the
+main input bus if there is no output. setupProcessing and setBusArrangements select the function
+from a table, so process () has no branches on the configuration.
+
+Override process () to handle parameter changes and events and call processAudio () from there,
+or keep the default process () which only calls processAudio () for blocks with samples.
+
+\code
+class MyEffect : public TypedAudioEffect<MyEffect, 1, 2>
+{
+public:
+	template <typename SampleT, int32 NumChannels>
+	void processT (ProcessData& data)
+	{
+		auto in = getChannelBuffers<SampleT> (data.inputs[0]);
+		auto out = getChannelBuffers<SampleT> (data.outputs[0]);
+		...
+	}
+};
+\endcode
+*/
+template <typename Derived, int32... SupportedChannels>
+class TypedAudioEffect : public AudioEffect
+{
+public:
+//------------------------------------------------------------------------
+	tresult PLUGIN_API setBusArrangements (SpeakerArrangement* inputs, int32 numIns,
+	                                       SpeakerArrangement* outputs,
+	                                       int32 numOuts) SMTG_OVERRIDE
+	{
+		auto result = AudioEffect::setBusArrangements (inputs, numIns, outputs, numOuts);
+		if (result == kResultTrue)
+			selectProcessFunction ();
+		return result;
+	}
+
+	tresult PLUGIN_API canProcessSampleSize (int32 symbolicSampleSize) SMTG_OVERRIDE
+	{
+		return (symbolicSampleSize == kSample32 || symbolicSampleSize == kSample64) ?
+		           kResultTrue :
+		           kResultFalse;
+	}
+
+	tresult PLUGIN_API setupProcessing (ProcessSetup& setup) SMTG_OVERRIDE
+	{
+		auto result = AudioEffect::setupProcessing (setup);
+		selectProcessFunction ();
+		return result;
+	}
+
+	tresult PLUGIN_API process (ProcessData& data) SMTG_OVERRIDE
+	{
+		if (data.numSamples > 0)
+			processAudio (data);
+		return kResultOk;
+	}
+
+//------------------------------------------------------------------------
+protected:
+	using ProcessFunction = void (*) (Derived&, ProcessData&);
+
+	/** Calls the processT of the current configuration. */
+	void processAudio (ProcessData& data) { processFunction (static_cast<Derived&> (*this), data); }
+
+	/** Channel count processT is selected for, 0 if it is not one of SupportedChannels. */
+	int32 getProcessChannelCount () const { return processChannelCount; }
+
+	void selectProcessFunction ()
+	{
+		SpeakerArrangement arrangement = 0;
+		if (getBusArrangement (kOutput, 0, arrangement) != kResultTrue)
+			getBusArrangement (kInput, 0, arrangement);
+		auto numChannels = SpeakerArr::getChannelCount (arrangement);
+
+		size_t index = 0;
+		while (index < kNumChannelConfigs - 1 && kChannelConfigs[index] != numChannels)
+			++index;
+		processChannelCount = kChannelConfigs[index];
+		auto sampleIndex = processSetup.symbolicSampleSize == kSample64 ? 1 : 0;
+		processFunction = kProcessFunctions[sampleIndex][index];
+	}
+
+//------------------------------------------------------------------------
+private:
+	template <typename SampleT, int32 NumChannels>
+	static void callProcess (Derived& effect, ProcessData& data)
+	{
+		effect.template processT<SampleT, NumChannels> (data);
+	}
+
+	static constexpr size_t kNumChannelConfigs = sizeof...(SupportedChannels) + 1;
+	static constexpr int32 kChannelConfigs[kNumChannelConfigs] = {SupportedChannels..., 0};
+	static constexpr ProcessFunction kProcessFunctions[2][kNumChannelConfigs] = {
+	    {&callProcess<Sample32, SupportedChannels>..., &callProcess<Sample32, 0>},
+	    {&callProcess<Sample64, SupportedChannels>..., &callProcess<Sample64, 0>}};
+
+	ProcessFunction processFunction {&callProcess<Sample32, 0>};
+	int32 processChannelCount {0};
+};
+
+//------------------------------------------------------------------------
+} // namespace Vst
+} // namespace Steinberg